@@ -0,0 +1,120 @@
+/**
+ * Host-Ersatz für den Arduino-Kern (Umgebung native: Tests und Benchmarks)
+ * Virtuelle Uhr statt Hardware-Timer: micros()/millis() laufen nur weiter,
+ * wenn der Test sie vorstellt - Abläufe über Minuten dauern so Millisekunden.
+ * Nur was die Module in src/ tatsächlich benutzen.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+// Wie in der sdkconfig des Boards: BT-Pfade des MouseHandlers mitbauen
+// (gegen die Ersatz-Header esp_gap_bt_api.h / esp_hidh.h)
+#ifndef CONFIG_BT_ENABLED
+  #define CONFIG_BT_ENABLED 1
+#endif
+
+// ========== Virtuelle Uhr ==========
+
+inline uint64_t hostClockUs = 0;
+
+inline void hostSetMicros(uint64_t us) { hostClockUs = us; }
+inline void hostAdvanceMicros(uint64_t us) { hostClockUs += us; }
+
+// Läuft wie auf dem ESP32 nach ~71 Minuten über
+inline uint32_t micros() { return (uint32_t)hostClockUs; }
+inline uint32_t millis() { return (uint32_t)(hostClockUs / 1000); }
+inline void delay(uint32_t ms) { hostClockUs += (uint64_t)ms * 1000; }
+inline void delayMicroseconds(uint32_t us) { hostClockUs += us; }
+inline void yield() {}
+
+// ========== Hilfsfunktionen ==========
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+using std::min;
+using std::max;
+
+class String : public std::string {
+public:
+  String() {}
+  String(const char* text) : std::string(text ? text : "") {}
+  String(const std::string& text) : std::string(text) {}
+};
+
+// ========== Serial ==========
+
+class HostSerial {
+public:
+  void begin(unsigned long) {}
+  size_t print(const char* text) { return fputs(text, stdout) < 0 ? 0 : strlen(text); }
+  size_t println(const char* text = "") { return print(text) + print("\n"); }
+
+  size_t printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written < 0 ? 0 : written;
+  }
+};
+
+inline HostSerial Serial;
+
+// ========== PSRAM ==========
+
+inline bool hostPsramAvailable = true;  // false: Display läuft im direkten Modus
+
+inline bool psramFound() { return hostPsramAvailable; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+
+// ========== FreeRTOS / ESP-IDF ==========
+
+// Echter Spinlock, damit Tests mit mehreren Threads die Sperren prüfen
+struct portMUX_TYPE {
+  int locked;
+};
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+inline void hostEnterCritical(portMUX_TYPE* mux) {
+  while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE)) {
+  }
+}
+
+inline void hostExitCritical(portMUX_TYPE* mux) {
+  __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+#define portENTER_CRITICAL(mux) hostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) hostExitCritical(mux)
+
+typedef void* TaskHandle_t;
+
+inline uint32_t hostTaskNotifications = 0;
+inline void xTaskNotifyGive(TaskHandle_t) { hostTaskNotifications++; }
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERROR_CHECK(x) ((void)(x))
+
+inline const char* esp_err_to_name(esp_err_t error) { return error == ESP_OK ? "ESP_OK" : "ESP_FAIL"; }
+
+typedef const char* esp_event_base_t;
+typedef void (*esp_event_handler_t)(void* handlerArgs, esp_event_base_t base, int32_t id, void* eventData);
+
+#endif
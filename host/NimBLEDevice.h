@@ -0,0 +1,16 @@
+/**
+ * Host-Ersatz für NimBLE: nur die Typen, die der MouseHandler hält
+ */
+
+#ifndef HOST_NIMBLE_DEVICE_H
+#define HOST_NIMBLE_DEVICE_H
+
+class NimBLEClient {
+public:
+  bool disconnect() { return true; }
+};
+
+class NimBLERemoteCharacteristic {
+};
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * Host-Ersatz für TFT_eSPI: das Panel ist ein RGB565-Bild im Speicher
+ * (Bus-Reihenfolge wie MemoryBackend), DMA-Transfers sind sofort fertig.
+ * Text wird als deterministisches Blockmuster (6x8 je Zeichen wie Font 1)
+ * gerastert - genug für Golden-Frames, ohne echte Glyphen.
+ */
+
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// Panel des T-Display (Hochformat, Rotation 0)
+#define TFT_WIDTH 135
+#define TFT_HEIGHT 240
+
+#define TFT_BLACK 0x0000
+#define TFT_WHITE 0xFFFF
+#define TFT_RED 0xF800
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_MAGENTA 0xF81F
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+inline bool hostDmaAvailable = true;  // false: initDMA() schlägt fehl
+
+class TFT_eSPI {
+protected:
+  int16_t panelWidth;
+  int16_t panelHeight;
+  int16_t _width;
+  int16_t _height;
+  std::vector<uint16_t> pixels;
+
+  uint8_t textSize;
+  uint16_t textColor;
+  uint16_t textBgColor;
+  uint8_t textDatum;
+
+  int32_t windowX, windowY, windowW, windowH;
+  int32_t windowPos;
+
+  static uint16_t busOrder(uint16_t color) { return (uint16_t)((color >> 8) | (color << 8)); }
+
+  void writePixel(int32_t x, int32_t y, uint16_t busColor) {
+    if (x >= 0 && y >= 0 && x < _width && y < _height) {
+      pixels[y * _width + x] = busColor;
+    }
+  }
+
+public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT) {
+    panelWidth = w;
+    panelHeight = h;
+    _width = w;
+    _height = h;
+    pixels.assign((size_t)w * h, 0);
+    textSize = 1;
+    textColor = TFT_WHITE;
+    textBgColor = TFT_BLACK;
+    textDatum = TL_DATUM;
+    windowX = windowY = windowW = windowH = 0;
+    windowPos = 0;
+  }
+
+  void init() {}
+
+  void setRotation(uint8_t rotation) {
+    bool landscape = rotation & 1;
+    _width = landscape ? panelHeight : panelWidth;
+    _height = landscape ? panelWidth : panelHeight;
+  }
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+  // ========== Zeichnen ==========
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    uint16_t value = busOrder(color);
+    for (int32_t row = y; row < y + h; row++) {
+      for (int32_t col = x; col < x + w; col++) {
+        writePixel(col, row, value);
+      }
+    }
+  }
+
+  void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+  }
+
+  // ========== Text (Blockmuster statt Glyphen) ==========
+
+  void setTextSize(uint8_t size) { textSize = size ? size : 1; }
+  void setTextColor(uint16_t color) { textColor = color; }
+  void setTextColor(uint16_t fg, uint16_t bg) { textColor = fg; textBgColor = bg; }
+  void setTextDatum(uint8_t datum) { textDatum = datum; }
+
+  int16_t textWidth(const char* text) { return (int16_t)(strlen(text) * 6 * textSize); }
+  int16_t fontHeight() { return 8 * textSize; }
+
+  int16_t drawString(const char* text, int32_t x, int32_t y) {
+    int32_t w = textWidth(text);
+    int32_t h = fontHeight();
+    x -= (textDatum % 3) * w / 2;
+    y -= (textDatum / 3) * h / 2;
+
+    uint16_t fg = busOrder(textColor);
+    uint16_t bg = busOrder(textBgColor);
+    for (size_t i = 0; text[i] != '\0'; i++) {
+      uint8_t c = (uint8_t)text[i];
+      for (int32_t gy = 0; gy < 8; gy++) {
+        for (int32_t gx = 0; gx < 6; gx++) {
+          // 5x7-Zelle, Muster aus dem Zeichencode
+          bool on = gx < 5 && gy < 7 && c != ' ' && ((c >> ((gx + gy) % 7)) & 1);
+          for (int32_t sy = 0; sy < textSize; sy++) {
+            for (int32_t sx = 0; sx < textSize; sx++) {
+              writePixel(x + (int32_t)i * 6 * textSize + gx * textSize + sx,
+                         y + gy * textSize + sy, on ? fg : bg);
+            }
+          }
+        }
+      }
+    }
+    return (int16_t)w;
+  }
+
+  // ========== Adressfenster ==========
+
+  void startWrite() {}
+  void endWrite() {}
+
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+    windowX = x;
+    windowY = y;
+    windowW = w;
+    windowH = h;
+    windowPos = 0;
+  }
+
+  // Daten bereits in Bus-Reihenfolge
+  void pushPixels(const void* data, uint32_t length) {
+    const uint16_t* values = (const uint16_t*)data;
+    for (uint32_t i = 0; i < length && windowPos < windowW * windowH; i++, windowPos++) {
+      writePixel(windowX + windowPos % windowW, windowY + windowPos / windowW, values[i]);
+    }
+  }
+
+  // ========== DMA (sofort abgeschlossen) ==========
+
+  bool initDMA() { return hostDmaAvailable; }
+
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+    setAddrWindow(x, y, w, h);
+    pushPixels(data, (uint32_t)(w * h));
+  }
+
+  void dmaWait() {}
+  bool dmaBusy() { return false; }
+
+  // ========== Nur Host ==========
+
+  // Panel-Inhalt in Bus-Reihenfolge (Zeilen zu width())
+  const uint16_t* hostGetPixels() const { return pixels.data(); }
+  uint16_t hostGetPixel(int32_t x, int32_t y) const { return busOrder(pixels[y * _width + x]); }
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI*) : TFT_eSPI(0, 0) {}
+
+  void setColorDepth(int8_t) {}
+
+  void* createSprite(int16_t w, int16_t h, uint8_t = 1) {
+    panelWidth = _width = w;
+    panelHeight = _height = h;
+    pixels.assign((size_t)w * h, 0);
+    return pixels.data();
+  }
+
+  void deleteSprite() {
+    pixels.clear();
+    _width = _height = 0;
+  }
+
+  void fillSprite(uint32_t color) { fillScreen(color); }
+  void* getPointer() { return pixels.data(); }
+};
+
+#endif
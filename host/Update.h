@@ -0,0 +1,66 @@
+/**
+ * Host-Ersatz für die Arduino-Update-Klasse (OTA-Partition)
+ * Das "geflashte" Image landet in hostUpdateImage; Tests können einen
+ * Schreibfehler ab einer Byte-Zahl auslösen und Ende/Abbruch prüfen.
+ */
+
+#ifndef HOST_UPDATE_H
+#define HOST_UPDATE_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+inline std::vector<uint8_t> hostUpdateImage;
+inline size_t hostUpdateFailAt = SIZE_MAX;  // Schreibfehler ab diesem Image-Byte
+
+class UpdateClass {
+public:
+  bool running = false;
+  bool ended = false;
+  uint32_t begins = 0;
+  uint32_t aborts = 0;
+
+  bool begin(size_t size) {
+    hostUpdateImage.clear();
+    running = true;
+    ended = false;
+    begins++;
+    return true;
+  }
+
+  size_t write(uint8_t* data, size_t length) {
+    if (!running || hostUpdateImage.size() + length > hostUpdateFailAt) {
+      return 0;
+    }
+    hostUpdateImage.insert(hostUpdateImage.end(), data, data + length);
+    return length;
+  }
+
+  bool end(bool evenIfRemaining = false) {
+    if (!running) {
+      return false;
+    }
+    running = false;
+    ended = true;
+    return true;
+  }
+
+  void abort() {
+    running = false;
+    aborts++;
+  }
+
+  void printError(HostSerial& out) { out.print("Update-Fehler\n"); }
+};
+
+inline UpdateClass Update;
+
+inline void hostUpdateReset() {
+  Update = UpdateClass();
+  hostUpdateImage.clear();
+  hostUpdateFailAt = SIZE_MAX;
+}
+
+#endif
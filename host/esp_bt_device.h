@@ -0,0 +1,12 @@
+/**
+ * Host-Ersatz für esp_bt_device.h
+ */
+
+#ifndef HOST_ESP_BT_DEVICE_H
+#define HOST_ESP_BT_DEVICE_H
+
+#include <stdint.h>
+
+typedef uint8_t esp_bd_addr_t[6];
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * Host-Ersatz für Controller und Bluedroid (esp_bt.h / esp_bt_main.h):
+ * jede Initialisierung gelingt, ohne Funk
+ */
+
+#ifndef HOST_ESP_BT_MAIN_H
+#define HOST_ESP_BT_MAIN_H
+
+#include <Arduino.h>
+
+typedef enum {
+  ESP_BT_MODE_IDLE,
+  ESP_BT_MODE_BLE,
+  ESP_BT_MODE_CLASSIC_BT,
+  ESP_BT_MODE_BTDM
+} esp_bt_mode_t;
+
+typedef struct {
+  int unused;
+} esp_bt_controller_config_t;
+
+#define BT_CONTROLLER_INIT_CONFIG_DEFAULT() esp_bt_controller_config_t{0}
+
+inline esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t) { return ESP_OK; }
+inline esp_err_t esp_bt_controller_init(esp_bt_controller_config_t*) { return ESP_OK; }
+inline esp_err_t esp_bt_controller_enable(esp_bt_mode_t) { return ESP_OK; }
+inline esp_err_t esp_bluedroid_init() { return ESP_OK; }
+inline esp_err_t esp_bluedroid_enable() { return ESP_OK; }
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Host-Ersatz für die BT-Classic-GAP-API
+ * Der registrierte Callback bleibt in hostGapCallback, damit Tests
+ * Suchergebnisse (DISC_RES) und das Suchende selbst auslösen können.
+ */
+
+#ifndef HOST_ESP_GAP_BT_API_H
+#define HOST_ESP_GAP_BT_API_H
+
+#include <Arduino.h>
+#include "esp_bt_device.h"
+
+typedef enum {
+  ESP_BT_GAP_DISC_RES_EVT = 0,
+  ESP_BT_GAP_DISC_STATE_CHANGED_EVT
+} esp_bt_gap_cb_event_t;
+
+typedef enum {
+  ESP_BT_GAP_DEV_PROP_BDNAME = 1,
+  ESP_BT_GAP_DEV_PROP_COD,
+  ESP_BT_GAP_DEV_PROP_RSSI,
+  ESP_BT_GAP_DEV_PROP_EIR
+} esp_bt_gap_dev_prop_type_t;
+
+typedef struct {
+  esp_bt_gap_dev_prop_type_t type;
+  int len;
+  void* val;
+} esp_bt_gap_dev_prop_t;
+
+typedef enum {
+  ESP_BT_GAP_DISCOVERY_STOPPED,
+  ESP_BT_GAP_DISCOVERY_STARTED
+} esp_bt_gap_discovery_state_t;
+
+typedef union {
+  struct {
+    esp_bd_addr_t bda;
+    int num_prop;
+    esp_bt_gap_dev_prop_t* prop;
+  } disc_res;
+  struct {
+    esp_bt_gap_discovery_state_t state;
+  } disc_st_chg;
+} esp_bt_gap_cb_param_t;
+
+typedef void (*esp_bt_gap_cb_t)(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param);
+
+typedef enum { ESP_BT_NON_CONNECTABLE, ESP_BT_CONNECTABLE } esp_bt_connection_mode_t;
+typedef enum { ESP_BT_NON_DISCOVERABLE, ESP_BT_LIMITED_DISCOVERABLE, ESP_BT_GENERAL_DISCOVERABLE } esp_bt_discovery_mode_t;
+typedef enum { ESP_BT_INQ_MODE_GENERAL_INQUIRY, ESP_BT_INQ_MODE_LIMITED_INQUIRY } esp_bt_inq_mode_t;
+
+inline esp_bt_gap_cb_t hostGapCallback = nullptr;
+inline uint32_t hostDiscoveryStarts = 0;
+
+inline esp_err_t esp_bt_gap_register_callback(esp_bt_gap_cb_t callback) {
+  hostGapCallback = callback;
+  return ESP_OK;
+}
+
+inline esp_err_t esp_bt_gap_set_scan_mode(esp_bt_connection_mode_t, esp_bt_discovery_mode_t) {
+  return ESP_OK;
+}
+
+inline esp_err_t esp_bt_gap_start_discovery(esp_bt_inq_mode_t, uint8_t, uint8_t) {
+  hostDiscoveryStarts++;
+  return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * Host-Ersatz für den HID-Host (esp_hidh)
+ * Ein simuliertes Gerät mit einstellbarem Report-Deskriptor: Tests öffnen
+ * die Verbindung und speisen Input-Reports wie der HID-Task ein.
+ */
+
+#ifndef HOST_ESP_HIDH_H
+#define HOST_ESP_HIDH_H
+
+#include <Arduino.h>
+#include "esp_bt_device.h"
+
+typedef enum {
+  ESP_HID_TRANSPORT_BT,
+  ESP_HID_TRANSPORT_BLE,
+  ESP_HID_TRANSPORT_USB
+} esp_hid_transport_t;
+
+typedef enum {
+  ESP_HIDH_ANY_EVENT = -1,
+  ESP_HIDH_START_EVENT = 0,
+  ESP_HIDH_OPEN_EVENT,
+  ESP_HIDH_BATTERY_EVENT,
+  ESP_HIDH_INPUT_EVENT,
+  ESP_HIDH_FEATURE_EVENT,
+  ESP_HIDH_CLOSE_EVENT,
+  ESP_HIDH_STOP_EVENT
+} esp_hidh_event_t;
+
+typedef struct {
+  const uint8_t* data;
+  uint16_t len;
+} esp_hid_raw_report_map_t;
+
+typedef struct {
+  esp_hid_raw_report_map_t map;
+  bool open;
+} esp_hidh_dev_t;
+
+typedef union {
+  struct {
+    esp_err_t status;
+    esp_hidh_dev_t* dev;
+  } open;
+  struct {
+    esp_hidh_dev_t* dev;
+    uint16_t report_id;
+    uint16_t length;
+    uint8_t* data;
+  } input;
+  struct {
+    esp_hidh_dev_t* dev;
+    int reason;
+  } close;
+} esp_hidh_event_data_t;
+
+typedef struct {
+  esp_event_handler_t callback;
+  uint16_t event_stack_size;
+  void* callback_arg;
+} esp_hidh_config_t;
+
+inline esp_hidh_config_t hostHidhConfig = {nullptr, 0, nullptr};
+inline esp_hidh_dev_t hostHidhDevice = {{nullptr, 0}, false};
+
+inline esp_err_t esp_hidh_init(const esp_hidh_config_t* config) {
+  hostHidhConfig = *config;
+  return ESP_OK;
+}
+
+inline esp_hidh_dev_t* esp_hidh_dev_open(esp_bd_addr_t, esp_hid_transport_t, uint8_t) {
+  hostHidhDevice.open = true;
+  return &hostHidhDevice;
+}
+
+inline esp_err_t esp_hidh_dev_report_maps_get(esp_hidh_dev_t* dev, size_t* numMaps,
+                                              esp_hid_raw_report_map_t** maps) {
+  *numMaps = dev->map.data != nullptr ? 1 : 0;
+  *maps = &dev->map;
+  return ESP_OK;
+}
+
+// ========== Steuerung aus den Tests ==========
+
+// Report-Deskriptor des simulierten Geräts (nullptr = Boot-Protokoll)
+inline void hostHidhSetReportMap(const uint8_t* descriptor, uint16_t length) {
+  hostHidhDevice.map.data = descriptor;
+  hostHidhDevice.map.len = length;
+}
+
+inline void hostHidhDispatch(esp_hidh_event_t event, esp_hidh_event_data_t* data) {
+  if (hostHidhConfig.callback != nullptr) {
+    hostHidhConfig.callback(hostHidhConfig.callback_arg, "ESP_HIDH_EVENTS", event, data);
+  }
+}
+
+inline void hostHidhOpen() {
+  esp_hidh_event_data_t data;
+  data.open.status = ESP_OK;
+  data.open.dev = &hostHidhDevice;
+  hostHidhDispatch(ESP_HIDH_OPEN_EVENT, &data);
+}
+
+inline void hostHidhInput(uint8_t reportId, const uint8_t* report, uint16_t length) {
+  esp_hidh_event_data_t data;
+  data.input.dev = &hostHidhDevice;
+  data.input.report_id = reportId;
+  data.input.length = length;
+  data.input.data = (uint8_t*)report;
+  hostHidhDispatch(ESP_HIDH_INPUT_EVENT, &data);
+}
+
+inline void hostHidhClose() {
+  esp_hidh_event_data_t data;
+  data.close.dev = &hostHidhDevice;
+  data.close.reason = 0;
+  hostHidhDevice.open = false;
+  hostHidhDispatch(ESP_HIDH_CLOSE_EVENT, &data);
+}
+
+#endif
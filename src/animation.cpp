@@ -0,0 +1,109 @@
+/**
+ * Animations-Engine Implementierung
+ */
+
+#include "animation.h"
+#include <string.h>
+
+AnimationEngine::AnimationEngine() {
+  memset(&stats, 0, sizeof(stats));
+  clear();
+}
+
+void AnimationEngine::clear() {
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    effects[i].active = false;
+    effects[i].footprint = Rect::make(0, 0, 0, 0);
+  }
+}
+
+AnimationEffect& AnimationEngine::trigger(int x, int y, uint8_t kind, uint32_t nowUs,
+                                          AnimationEasing easing, uint32_t durationUs) {
+  stats.triggered++;
+
+  AnimationEffect* slot = nullptr;
+  AnimationEffect* oldest = nullptr;
+
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    AnimationEffect& e = effects[i];
+    if (!e.active) {
+      if (slot == nullptr) slot = &e;
+      continue;
+    }
+
+    // Gleicher Effekt an (fast) derselben Stelle: neu starten statt stapeln
+    int dx = e.x - x;
+    int dy = e.y - y;
+    if (e.kind == kind &&
+        dx * dx + dy * dy <= ANIMATION_COALESCE_RADIUS * ANIMATION_COALESCE_RADIUS) {
+      e.startUs = nowUs;
+      e.progress = 0;
+      stats.coalesced++;
+      return e;
+    }
+
+    if (oldest == nullptr || (int32_t)(e.startUs - oldest->startUs) < 0) {
+      oldest = &e;
+    }
+  }
+
+  if (slot == nullptr) {
+    // Footprint bleibt erhalten - der Aufrufer löscht ihn beim nächsten Update
+    slot = oldest;
+    stats.recycled++;
+  } else {
+    slot->footprint = Rect::make(0, 0, 0, 0);
+  }
+
+  slot->x = x;
+  slot->y = y;
+  slot->kind = kind;
+  slot->easing = easing;
+  slot->active = true;
+  slot->startUs = nowUs;
+  slot->durationUs = durationUs;
+  slot->progress = 0;
+  return *slot;
+}
+
+bool AnimationEngine::advance(AnimationEffect& effect, uint32_t nowUs) {
+  if (!effect.active) {
+    return false;
+  }
+
+  uint32_t elapsed = nowUs - effect.startUs;
+  if (elapsed >= effect.durationUs) {
+    effect.active = false;
+    return false;
+  }
+
+  uint32_t t = (uint32_t)((uint64_t)elapsed * ANIMATION_PROGRESS_MAX / effect.durationUs);
+  effect.progress = ease((AnimationEasing)effect.easing, t);
+  return true;
+}
+
+AnimationStats AnimationEngine::getStats() const {
+  AnimationStats s = stats;
+  s.active = 0;
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    if (effects[i].active) s.active++;
+  }
+  return s;
+}
+
+uint16_t AnimationEngine::ease(AnimationEasing easing, uint32_t t) {
+  if (t > ANIMATION_PROGRESS_MAX) t = ANIMATION_PROGRESS_MAX;
+  uint32_t u = ANIMATION_PROGRESS_MAX - t;
+
+  switch (easing) {
+    case EASE_OUT_QUAD:
+      // 1 - (1 - t)^2
+      return ANIMATION_PROGRESS_MAX - u * u / ANIMATION_PROGRESS_MAX;
+    case EASE_OUT_CUBIC:
+      // 1 - (1 - t)^3
+      return ANIMATION_PROGRESS_MAX - u * u / ANIMATION_PROGRESS_MAX * u / ANIMATION_PROGRESS_MAX;
+    case EASE_LINEAR:
+    default:
+      return t;
+  }
+}
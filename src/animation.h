@@ -0,0 +1,70 @@
+/**
+ * Zeitbasierte Animations-Engine für die Klick-Effekte
+ * Fortschritt aus vergangenen Mikrosekunden (mit Easing), feste Effekt-Pool-
+ * Größe, Wiederverwendung des ältesten Effekts und Zusammenfassen wiederholter
+ * Auslöser an derselben Stelle. Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <stdint.h>
+#include "dirty_rect.h"
+
+#define ANIMATION_POOL_SIZE 8
+#define ANIMATION_DURATION_US 250000   // Laufzeit eines Effekts (bisher 15 Frames à 16 ms)
+#define ANIMATION_PROGRESS_MAX 1024    // Fortschritt in Festkomma (1024 = Ende)
+#define ANIMATION_COALESCE_RADIUS 8    // Auslöser näher als das: Effekt neu starten
+
+// Verlauf des Fortschritts über die Zeit
+enum AnimationEasing {
+  EASE_LINEAR,
+  EASE_OUT_QUAD,
+  EASE_OUT_CUBIC
+};
+
+struct AnimationEffect {
+  int16_t x;
+  int16_t y;
+  uint8_t kind;            // Art des Effekts (vom Aufrufer vergeben)
+  uint8_t easing;          // AnimationEasing
+  bool active;
+  uint32_t startUs;
+  uint32_t durationUs;
+  uint16_t progress;       // Geglätteter Fortschritt 0..ANIMATION_PROGRESS_MAX
+  Rect footprint;          // Zuletzt gezeichneter Bereich (zum Löschen)
+};
+
+struct AnimationStats {
+  uint32_t triggered;
+  uint32_t coalesced;      // Auf einen laufenden Effekt zusammengefasst
+  uint32_t recycled;       // Pool voll - ältester Effekt ersetzt
+  uint8_t active;
+};
+
+class AnimationEngine {
+private:
+  AnimationEffect effects[ANIMATION_POOL_SIZE];
+  AnimationStats stats;
+
+public:
+  AnimationEngine();
+
+  // Effekt starten, zusammenfassen oder ältesten ersetzen
+  AnimationEffect& trigger(int x, int y, uint8_t kind, uint32_t nowUs,
+                           AnimationEasing easing = EASE_OUT_QUAD,
+                           uint32_t durationUs = ANIMATION_DURATION_US);
+
+  // Fortschritt aus der Zeit berechnen; false, wenn der Effekt abgelaufen ist
+  bool advance(AnimationEffect& effect, uint32_t nowUs);
+
+  void clear();
+
+  AnimationEffect& get(int index) { return effects[index]; }
+  const AnimationEffect& get(int index) const { return effects[index]; }
+  AnimationStats getStats() const;
+
+  static uint16_t ease(AnimationEasing easing, uint32_t t);
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * BT-Geräte-Tabelle Implementierung
+ */
+
+#include "bt_discovery.h"
+#include <string.h>
+#include <stdio.h>
+
+BtDeviceTable::BtDeviceTable() {
+  clear();
+  seq = 0;
+}
+
+void BtDeviceTable::clear() {
+  memset(devices, 0, sizeof(devices));
+  memset(smoothed, 0, sizeof(smoothed));
+  count = 0;
+}
+
+int BtDeviceTable::find(const uint8_t* address) const {
+  for (int i = 0; i < count; i++) {
+    if (memcmp(devices[i].address, address, 6) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const BtDevice& BtDeviceTable::update(const uint8_t* address, const char* name, int8_t rssi,
+                                      uint32_t classOfDevice, uint32_t nowMs) {
+  int slot = find(address);
+
+  if (slot < 0) {
+    if (count < BT_DISCOVERY_MAX_DEVICES) {
+      slot = count++;
+    } else {
+      // Am längsten nicht gesehenen Eintrag ersetzen
+      slot = 0;
+      for (int i = 1; i < count; i++) {
+        if ((int32_t)(devices[i].lastSeenMs - devices[slot].lastSeenMs) < 0) {
+          slot = i;
+        }
+      }
+    }
+    BtDevice& fresh = devices[slot];
+    memset(&fresh, 0, sizeof(fresh));
+    memcpy(fresh.address, address, 6);
+    fresh.rssi = BT_RSSI_NONE;
+    fresh.lastRssi = BT_RSSI_NONE;
+    fresh.firstSeenMs = nowMs;
+  }
+
+  BtDevice& device = devices[slot];
+  if (rssi != BT_RSSI_NONE) {
+    // Erste Messung übernehmen, danach glätten
+    if (device.lastRssi == BT_RSSI_NONE) {
+      smoothed[slot] = rssi * 16;
+    } else {
+      smoothed[slot] += (rssi * 16 - smoothed[slot]) / BT_RSSI_SMOOTHING;
+    }
+    device.lastRssi = rssi;
+    device.rssi = (int8_t)((smoothed[slot] + (smoothed[slot] < 0 ? -8 : 8)) / 16);
+  }
+  if (name != nullptr && name[0] != '\0') {
+    strncpy(device.name, name, BT_DISCOVERY_NAME_MAX - 1);
+    device.name[BT_DISCOVERY_NAME_MAX - 1] = '\0';
+  }
+  if (classOfDevice != 0) {
+    device.classOfDevice = classOfDevice;
+  }
+  device.lastSeenMs = nowMs;
+  device.sightings++;
+  device.seq = ++seq;
+  return device;
+}
+
+void BtDeviceTable::formatAddress(const uint8_t* address, char* out) {
+  snprintf(out, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
+           address[0], address[1], address[2], address[3], address[4], address[5]);
+}
@@ -0,0 +1,58 @@
+/**
+ * Tabelle der bei der BT-Classic-Suche gefundenen Geräte
+ * Fester Speicher, Schlüssel ist die BD-Adresse; RSSI wird geglättet,
+ * jede Änderung bekommt eine fortlaufende Nummer, damit Streams nur
+ * Neues senden. Ohne Arduino-Abhängigkeiten (Sperren beim Aufrufer).
+ */
+
+#ifndef BT_DISCOVERY_H
+#define BT_DISCOVERY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BT_DISCOVERY_MAX_DEVICES 16
+#define BT_DISCOVERY_NAME_MAX 32
+#define BT_DISCOVERY_DURATION 10   // Inquiry-Dauer in Einheiten von 1,28 s (~13 s)
+#define BT_RSSI_SMOOTHING 4        // Glättung: neuer Wert zählt 1/4
+#define BT_RSSI_NONE INT8_MIN      // Fund ohne RSSI-Angabe / noch nie gemessen
+
+struct BtDevice {
+  uint8_t address[6];
+  char name[BT_DISCOVERY_NAME_MAX];
+  int8_t rssi;          // Geglättet (BT_RSSI_NONE ohne Messung)
+  int8_t lastRssi;      // Letzte Messung (BT_RSSI_NONE ohne Messung)
+  uint32_t classOfDevice;
+  uint32_t firstSeenMs;
+  uint32_t lastSeenMs;
+  uint16_t sightings;
+  uint32_t seq;         // Nummer der letzten Änderung
+};
+
+class BtDeviceTable {
+private:
+  BtDevice devices[BT_DISCOVERY_MAX_DEVICES];
+  int count;
+  uint32_t seq;
+  int16_t smoothed[BT_DISCOVERY_MAX_DEVICES];  // RSSI * 16 (Nachkommastellen)
+
+public:
+  BtDeviceTable();
+
+  void clear();
+
+  // Fund eintragen; name darf nullptr sein (Name kommt oft erst später),
+  // rssi BT_RSSI_NONE (lässt die bisherigen Werte unverändert).
+  // Bei voller Tabelle wird der am längsten nicht gesehene Eintrag ersetzt.
+  const BtDevice& update(const uint8_t* address, const char* name, int8_t rssi,
+                         uint32_t classOfDevice, uint32_t nowMs);
+
+  int find(const uint8_t* address) const;
+  int getCount() const { return count; }
+  const BtDevice& get(int index) const { return devices[index]; }
+  uint32_t getSeq() const { return seq; }
+
+  static void formatAddress(const uint8_t* address, char* out);  // 18 Bytes
+};
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * Dirty-Rechtecke Implementierung
+ */
+
+#include "dirty_rect.h"
+
+// ========== Rect ==========
+
+Rect Rect::make(int x, int y, int w, int h) {
+  Rect r;
+  r.x = x;
+  r.y = y;
+  r.w = w;
+  r.h = h;
+  return r;
+}
+
+Rect Rect::around(int cx, int cy, int radius) {
+  return make(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
+}
+
+bool Rect::intersects(const Rect& other) const {
+  return !isEmpty() && !other.isEmpty() &&
+         x < other.x + other.w && other.x < x + w &&
+         y < other.y + other.h && other.y < y + h;
+}
+
+Rect Rect::unite(const Rect& other) const {
+  if (isEmpty()) return other;
+  if (other.isEmpty()) return *this;
+
+  int x1 = x < other.x ? x : other.x;
+  int y1 = y < other.y ? y : other.y;
+  int x2 = (x + w > other.x + other.w) ? x + w : other.x + other.w;
+  int y2 = (y + h > other.y + other.h) ? y + h : other.y + other.h;
+  return make(x1, y1, x2 - x1, y2 - y1);
+}
+
+Rect Rect::intersect(const Rect& other) const {
+  int x1 = x > other.x ? x : other.x;
+  int y1 = y > other.y ? y : other.y;
+  int x2 = (x + w < other.x + other.w) ? x + w : other.x + other.w;
+  int y2 = (y + h < other.y + other.h) ? y + h : other.y + other.h;
+  if (x2 <= x1 || y2 <= y1) return make(0, 0, 0, 0);
+  return make(x1, y1, x2 - x1, y2 - y1);
+}
+
+// ========== DirtyRegion ==========
+
+DirtyRegion::DirtyRegion(int16_t width, int16_t height) {
+  bounds = Rect::make(0, 0, width, height);
+  count = 0;
+}
+
+void DirtyRegion::removeAt(int index) {
+  rects[index] = rects[count - 1];
+  count--;
+}
+
+void DirtyRegion::add(Rect rect) {
+  rect = rect.intersect(bounds);
+  if (rect.isEmpty()) return;
+
+  // Mit überlappenden oder nahen Rechtecken verschmelzen, bis nichts mehr passt
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (int i = 0; i < count; i++) {
+      Rect u = rect.unite(rects[i]);
+      if (rect.intersects(rects[i]) ||
+          u.area() <= rect.area() + rects[i].area() + DIRTY_MERGE_SLACK) {
+        rect = u;
+        removeAt(i);
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  if (count < MAX_DIRTY_RECTS) {
+    rects[count++] = rect;
+    return;
+  }
+
+  // Liste voll: mit dem Rechteck vereinen, das am wenigsten Fläche hinzufügt
+  int best = 0;
+  int32_t bestGrowth = INT32_MAX;
+  for (int i = 0; i < count; i++) {
+    int32_t growth = rect.unite(rects[i]).area() - rects[i].area();
+    if (growth < bestGrowth) {
+      bestGrowth = growth;
+      best = i;
+    }
+  }
+  Rect u = rect.unite(rects[best]);
+  removeAt(best);
+  add(u);
+}
+
+int32_t DirtyRegion::getArea() const {
+  int32_t area = 0;
+  for (int i = 0; i < count; i++) {
+    area += rects[i].area();
+  }
+  return area;
+}
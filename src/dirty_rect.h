@@ -0,0 +1,49 @@
+/**
+ * Dirty-Rechtecke für den Display-Compositor
+ * Sammelt pro Frame die geänderten Bereiche und fasst überlappende zusammen
+ */
+
+#ifndef DIRTY_RECT_H
+#define DIRTY_RECT_H
+
+#include <stdint.h>
+
+#define MAX_DIRTY_RECTS 8
+#define DIRTY_MERGE_SLACK 64  // Zusammenfassen, wenn max. so viele Pixel zusätzlich
+
+struct Rect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+
+  bool isEmpty() const { return w <= 0 || h <= 0; }
+  int32_t area() const { return isEmpty() ? 0 : (int32_t)w * h; }
+  bool intersects(const Rect& other) const;
+  Rect unite(const Rect& other) const;
+  Rect intersect(const Rect& other) const;
+
+  static Rect make(int x, int y, int w, int h);
+  static Rect around(int cx, int cy, int radius);  // Quadrat um einen Mittelpunkt
+};
+
+class DirtyRegion {
+private:
+  Rect bounds;  // Bildschirmgrenzen (Clipping)
+  Rect rects[MAX_DIRTY_RECTS];
+  int count;
+
+  void removeAt(int index);
+
+public:
+  DirtyRegion(int16_t width, int16_t height);
+
+  void add(Rect rect);
+  void clear() { count = 0; }
+
+  int getCount() const { return count; }
+  const Rect& get(int index) const { return rects[index]; }
+  int32_t getArea() const;
+};
+
+#endif
@@ -3,11 +3,30 @@
  */
 
 #include "display.h"
+#include "effect_raster.h"
+#include <esp_heap_caps.h>
 
-DisplayManager::DisplayManager() : tft(TFT_eSPI()) {
-  for (int i = 0; i < MAX_ANIMATIONS; i++) {
-    animations[i].active = false;
-  }
+static_assert(CURSOR_SIZE <= EFFECT_MAX_RING_RADIUS, "Cursor nutzt die Kreis-Tabelle");
+
+DisplayManager::DisplayManager()
+  : tft(TFT_eSPI()), textCache(&tft), dirty(SCREEN_WIDTH, SCREEN_HEIGHT),
+    directBackend(&tft, SCREEN_WIDTH, SCREEN_HEIGHT) {
+  memset(&stats, 0, sizeof(stats));
+  memset(&flushBus, 0, sizeof(flushBus));
+  
+  quality = QUALITY_FULL;
+  
+  canvas = &directBackend;
+  framebufferActive = false;
+  frameBuffers[0] = frameBuffers[1] = nullptr;
+  backBuffer = 0;
+  dmaBuffers[0] = dmaBuffers[1] = nullptr;
+  dmaBufferIndex = 0;
+  dmaTransactionOpen = false;
+  previousDirtyCount = 0;
+  screenMirror = nullptr;
+  
+  resetScene();
 }
 
 bool DisplayManager::begin() {
@@ -16,62 +35,153 @@ bool DisplayManager::begin() {
   tft.fillScreen(TFT_BLACK);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
+  
+#if DISPLAY_FRAMEBUFFER_ENABLED
+  if (enableFramebuffer()) {
+    Serial.println("[DISPLAY] Framebuffer-Modus aktiv (PSRAM + DMA)");
+  } else {
+    Serial.println("[DISPLAY] Direkter Modus (kein PSRAM/DMA)");
+  }
+#endif
+  
+  return true;
+}
+
+bool DisplayManager::enableFramebuffer() {
+  // Ohne PSRAM würden die zwei Puffer (je ~64 KB) den internen RAM belegen
+  if (!psramFound() || !tft.initDMA()) {
+    return false;
+  }
+  
+  for (int i = 0; i < 2; i++) {
+    dmaBuffers[i] = (uint16_t*)heap_caps_malloc(DMA_BOUNCE_PIXELS * 2, MALLOC_CAP_DMA);
+    frameBuffers[i] = new MemoryBackend(SCREEN_WIDTH, SCREEN_HEIGHT);
+    
+    if (dmaBuffers[i] == nullptr || !frameBuffers[i]->begin(true)) {
+      Serial.println("[DISPLAY] Framebuffer-Speicher nicht verfügbar");
+      for (int j = 0; j <= i; j++) {
+        heap_caps_free(dmaBuffers[j]);
+        dmaBuffers[j] = nullptr;
+        delete frameBuffers[j];
+        frameBuffers[j] = nullptr;
+      }
+      return false;
+    }
+  }
+  
+  framebufferActive = true;
+  backBuffer = 0;
+  canvas = frameBuffers[backBuffer];
   return true;
 }
 
 void DisplayManager::clearScreen() {
+  finishFlush();
   tft.fillScreen(TFT_BLACK);
+  resetScene();
+}
+
+void DisplayManager::resetScene() {
+  // Bildschirm wurde komplett überschrieben - Szene neu aufbauen
+  animationEngine.clear();
+  cursorVisible = false;
+  cursorX = 0;
+  cursorY = 0;
+  cursorColor = 0;
+  statusVisible = false;
+  statusText[0] = '\0';
+  dirty.clear();
+  
+  // Beide Puffer entsprechen wieder dem (schwarzen) Display
+  previousDirtyCount = 0;
+  if (framebufferActive) {
+    frameBuffers[0]->fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, TFT_BLACK);
+    frameBuffers[1]->fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, TFT_BLACK);
+    if (screenMirror != nullptr) {
+      screenMirror->markAll();
+    }
+  }
+}
+
+void DisplayManager::drawText(DisplayBackend* target, const char* text, int x, int y, uint8_t size,
+                              uint16_t color, uint8_t datum) {
+  TFT_eSprite* sprite = textCache.get(text, size, color, TFT_BLACK);
+  
+  if (sprite == nullptr) {
+    // Nicht cachebar (zu lang oder kein Speicher) - nur direkt aufs Display rastern
+    if (target == &directBackend) {
+      tft.setTextSize(size);
+      tft.setTextColor(color, TFT_BLACK);
+      tft.setTextDatum(datum);
+      tft.drawString(text, x, y);
+      textCache.countDirect(text);
+    }
+    return;
+  }
+  
+  // Bezugspunkt wie bei drawString (Spalte = datum % 3, Zeile = datum / 3)
+  int w = sprite->width();
+  int h = sprite->height();
+  if (datum <= BR_DATUM) {
+    x -= (datum % 3) * w / 2;
+    y -= (datum / 3) * h / 2;
+  }
+  
+  target->pushImage(x, y, w, h, (const uint16_t*)sprite->getPointer());
+}
+
+void DisplayManager::drawScreenText(const char* text, int x, int y, uint8_t size,
+                                    uint16_t color, uint8_t datum) {
+  // Info-Bildschirme gehen direkt aufs Display; im Framebuffer-Modus auch in
+  // beide Puffer, damit Screenshot und Spiegelung sie zeigen
+  drawText(&directBackend, text, x, y, size, color, datum);
+  if (framebufferActive) {
+    drawText(frameBuffers[0], text, x, y, size, color, datum);
+    drawText(frameBuffers[1], text, x, y, size, color, datum);
+  }
 }
 
 void DisplayManager::showBootScreen(const char* message) {
   clearScreen();
-  tft.setTextSize(2);
-  tft.drawString("LILYGOMAUS", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
-  tft.setTextSize(1);
-  tft.drawString(message, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 10);
+  drawScreenText("LILYGOMAUS", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20, 2, TFT_WHITE, MC_DATUM);
+  drawScreenText(message, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 10, 1, TFT_WHITE, MC_DATUM);
 }
 
 void DisplayManager::showConnectionInfo(const char* ssid, const char* password, const char* ip) {
   clearScreen();
-  tft.setTextSize(1);
-  tft.setTextDatum(TL_DATUM);
   
   int y = 10;
-  tft.drawString("WiFi Access Point:", 10, y); y += 20;
-  tft.setTextSize(2);
-  tft.drawString(ssid, 10, y); y += 25;
+  drawScreenText("WiFi Access Point:", 10, y, 1, TFT_WHITE, TL_DATUM); y += 20;
+  drawScreenText(ssid, 10, y, 2, TFT_WHITE, TL_DATUM); y += 25;
   
-  tft.setTextSize(1);
-  tft.drawString("Password:", 10, y); y += 20;
-  tft.setTextSize(2);
-  tft.drawString(password, 10, y); y += 25;
+  drawScreenText("Password:", 10, y, 1, TFT_WHITE, TL_DATUM); y += 20;
+  drawScreenText(password, 10, y, 2, TFT_WHITE, TL_DATUM); y += 25;
   
-  tft.setTextSize(1);
-  tft.drawString("Web Interface:", 10, y); y += 20;
-  tft.drawString(ip, 10, y);
+  drawScreenText("Web Interface:", 10, y, 1, TFT_WHITE, TL_DATUM); y += 20;
+  drawScreenText(ip, 10, y, 1, TFT_WHITE, TL_DATUM);
 }
 
 void DisplayManager::showMouseStatus(const char* status) {
-  tft.setTextDatum(BC_DATUM);
-  tft.setTextSize(1);
-  tft.fillRect(0, SCREEN_HEIGHT - 15, SCREEN_WIDTH, 15, TFT_BLACK);
-  tft.drawString(status, SCREEN_WIDTH / 2, SCREEN_HEIGHT - 5);
+  // Nur bei geändertem Text neu zeichnen
+  if (statusVisible && strncmp(statusText, status, STATUS_TEXT_MAX - 1) == 0) {
+    return;
+  }
+  
+  strncpy(statusText, status, STATUS_TEXT_MAX - 1);
+  statusText[STATUS_TEXT_MAX - 1] = '\0';
+  statusVisible = true;
+  dirty.add(statusBounds());
 }
 
 void DisplayManager::showError(const char* error) {
   clearScreen();
-  tft.setTextSize(1);
-  tft.setTextColor(TFT_RED, TFT_BLACK);
-  tft.setTextDatum(MC_DATUM);
-  tft.drawString("ERROR", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 10);
-  tft.drawString(error, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 10);
+  drawScreenText("ERROR", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 10, 1, TFT_RED, MC_DATUM);
+  drawScreenText(error, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 10, 1, TFT_RED, MC_DATUM);
 }
 
 void DisplayManager::showOTAProgress(int percentage) {
   clearScreen();
-  tft.setTextSize(2);
-  tft.setTextDatum(MC_DATUM);
-  tft.drawString("OTA Update", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20);
+  drawScreenText("OTA Update", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 20, 2, TFT_WHITE, MC_DATUM);
   
   // Progress bar
   int barWidth = 200;
@@ -83,7 +193,10 @@ void DisplayManager::showOTAProgress(int percentage) {
   int fillWidth = (barWidth - 4) * percentage / 100;
   tft.fillRect(barX + 2, barY + 2, fillWidth, barHeight - 4, TFT_GREEN);
   
+  // Prozentwert ändert sich ständig - nicht cachen
   tft.setTextSize(1);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextDatum(MC_DATUM);
   char percentStr[10];
   sprintf(percentStr, "%d%%", percentage);
   tft.drawString(percentStr, SCREEN_WIDTH / 2, barY + barHeight + 15);
@@ -91,11 +204,21 @@ void DisplayManager::showOTAProgress(int percentage) {
 
 void DisplayManager::drawCursor(int x, int y, float speed) {
   // Map speed to brightness
-  int brightness = map(constrain(speed, 0, 50), 0, 50, CURSOR_MIN_BRIGHTNESS, CURSOR_MAX_BRIGHTNESS);
-  uint16_t color = tft.color565(brightness, brightness, brightness);
+  uint16_t color = speedToColor(speed);
+  
+  if (cursorVisible && x == cursorX && y == cursorY && color == cursorColor) {
+    return;
+  }
   
-  // Draw cursor
-  tft.fillCircle(x, y, CURSOR_SIZE, color);
+  // Alte Position löschen, neue zeichnen (beim nächsten renderFrame)
+  if (cursorVisible) {
+    dirty.add(cursorBounds(cursorX, cursorY));
+  }
+  cursorX = x;
+  cursorY = y;
+  cursorColor = color;
+  cursorVisible = true;
+  dirty.add(cursorBounds(x, y));
 }
 
 uint16_t DisplayManager::speedToColor(float speed) {
@@ -104,67 +227,300 @@ uint16_t DisplayManager::speedToColor(float speed) {
 }
 
 void DisplayManager::drawClickAnimation(int x, int y, ClickType type) {
-  // Find free animation slot
-  for (int i = 0; i < MAX_ANIMATIONS; i++) {
-    if (!animations[i].active) {
-      animations[i].x = x;
-      animations[i].y = y;
-      animations[i].type = type;
-      animations[i].frame = 0;
-      animations[i].active = true;
-      break;
+  // Wiederholte Klicks an derselben Stelle starten den Effekt neu,
+  // bei vollem Pool wird der älteste ersetzt (alter Bereich wird gelöscht)
+  AnimationEffect& effect = animationEngine.trigger(x, y, type, micros());
+  dirty.add(effect.footprint);
+  effect.footprint = animationBounds(effect);
+  dirty.add(effect.footprint);
+}
+
+void DisplayManager::drawConcentricCircles(int x, int y, int growth) {
+  // Draw 3 expanding circles (bei reduzierter Qualität nur die inneren)
+  int rings = quality == QUALITY_FULL ? 3 : quality == QUALITY_REDUCED ? 2 : 1;
+  for (int i = 0; i < rings; i++) {
+    int radius = growth + i * 10;
+    if (radius <= EFFECT_MAX_RING_RADIUS) {
+      rasterRing(*canvas, x, y, radius, TFT_CYAN);
     }
   }
 }
 
-void DisplayManager::drawConcentricCircles(int x, int y, int frame) {
-  // Draw 3 expanding circles
-  for (int i = 0; i < 3; i++) {
-    int radius = (frame + i * 5) * 2;
-    if (radius < 50) {
-      tft.drawCircle(x, y, radius, TFT_CYAN);
+void DisplayManager::drawRays(int x, int y, int growth) {
+  // Draw 8 rays in 45° steps - bei reduzierter Qualität ohne Diagonalen
+  int length = 10 + growth;
+  if (length > EFFECT_MAX_RAY_LENGTH) length = EFFECT_MAX_RAY_LENGTH;
+  rasterRays(*canvas, x, y, length, quality == QUALITY_FULL, TFT_MAGENTA);
+}
+
+void DisplayManager::updateAnimations() {
+  // Fortschritt aus der vergangenen Zeit - gleiche Geschwindigkeit bei jeder Framerate
+  uint32_t now = micros();
+  
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    AnimationEffect& effect = animationEngine.get(i);
+    if (!effect.active) {
+      continue;
+    }
+    
+    uint16_t previousProgress = effect.progress;
+    bool running = animationEngine.advance(effect, now);
+    if (running && effect.progress == previousProgress) {
+      continue;  // Keine sichtbare Änderung seit dem letzten Frame
     }
+    
+    // Vorherigen Footprint löschen, neuen zeichnen
+    dirty.add(effect.footprint);
+    effect.footprint = running ? animationBounds(effect) : Rect::make(0, 0, 0, 0);
+    dirty.add(effect.footprint);
   }
 }
 
-void DisplayManager::drawRays(int x, int y, int frame) {
-  // Draw 8 rays in 45° steps
-  int length = 10 + frame * 2;
-  if (length > 30) length = 30;
+AnimationStats DisplayManager::getAnimationStats() {
+  return animationEngine.getStats();
+}
+
+TextCacheStats DisplayManager::getTextCacheStats() {
+  return textCache.getStats();
+}
+
+// ========== Compositor ==========
+
+Rect DisplayManager::cursorBounds(int x, int y) {
+  return Rect::around(x, y, CURSOR_SIZE);
+}
+
+static int animationGrowth(const AnimationEffect& effect) {
+  return (int)effect.progress * ANIMATION_GROWTH / ANIMATION_PROGRESS_MAX;
+}
+
+Rect DisplayManager::animationBounds(const AnimationEffect& effect) {
+  int growth = animationGrowth(effect);
+  int radius = 0;
   
-  for (int angle = 0; angle < 360; angle += 45) {
-    float rad = angle * PI / 180.0;
-    int x2 = x + cos(rad) * length;
-    int y2 = y + sin(rad) * length;
-    tft.drawLine(x, y, x2, y2, TFT_MAGENTA);
+  if (effect.kind == CLICK_LEFT || effect.kind == CLICK_BOTH) {
+    // Größter noch sichtbarer Ring (siehe drawConcentricCircles)
+    for (int i = 0; i < 3; i++) {
+      int r = growth + i * 10;
+      if (r <= EFFECT_MAX_RING_RADIUS && r > radius) radius = r;
+    }
   }
+  if (effect.kind == CLICK_RIGHT || effect.kind == CLICK_BOTH) {
+    int length = 10 + growth;
+    if (length > EFFECT_MAX_RAY_LENGTH) length = EFFECT_MAX_RAY_LENGTH;
+    if (length > radius) radius = length;
+  }
+  
+  return Rect::around(effect.x, effect.y, radius);
 }
 
-void DisplayManager::updateAnimations() {
-  for (int i = 0; i < MAX_ANIMATIONS; i++) {
-    if (animations[i].active) {
-      animations[i].frame++;
-      
-      // Draw animation based on type
-      switch (animations[i].type) {
-        case CLICK_LEFT:
-          drawConcentricCircles(animations[i].x, animations[i].y, animations[i].frame);
-          break;
-        case CLICK_RIGHT:
-          drawRays(animations[i].x, animations[i].y, animations[i].frame);
-          break;
-        case CLICK_BOTH:
-          drawConcentricCircles(animations[i].x, animations[i].y, animations[i].frame);
-          drawRays(animations[i].x, animations[i].y, animations[i].frame);
-          break;
-        default:
-          break;
-      }
-      
-      // Deactivate after 15 frames
-      if (animations[i].frame > 15) {
-        animations[i].active = false;
+Rect DisplayManager::statusBounds() {
+  return Rect::make(0, SCREEN_HEIGHT - STATUS_BAR_HEIGHT, SCREEN_WIDTH, STATUS_BAR_HEIGHT);
+}
+
+void DisplayManager::drawAnimation(const AnimationEffect& effect) {
+  int growth = animationGrowth(effect);
+  
+  switch (effect.kind) {
+    case CLICK_LEFT:
+      drawConcentricCircles(effect.x, effect.y, growth);
+      break;
+    case CLICK_RIGHT:
+      drawRays(effect.x, effect.y, growth);
+      break;
+    case CLICK_BOTH:
+      drawConcentricCircles(effect.x, effect.y, growth);
+      drawRays(effect.x, effect.y, growth);
+      break;
+    default:
+      break;
+  }
+}
+
+void DisplayManager::composeRect(const Rect& rect) {
+  // Alles außerhalb des Rechtecks wird vom Backend abgeschnitten
+  canvas->setClip(rect);
+  
+  // Hintergrund wiederherstellen
+  canvas->fillRect(rect.x, rect.y, rect.w, rect.h, TFT_BLACK);
+  
+  // Szene von hinten nach vorne: Animationen, Cursor, Statusleiste
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    const AnimationEffect& effect = animationEngine.get(i);
+    if (effect.active && effect.footprint.intersects(rect)) {
+      drawAnimation(effect);
+    }
+  }
+  
+  if (cursorVisible && cursorBounds(cursorX, cursorY).intersects(rect)) {
+    rasterFilledCircle(*canvas, cursorX, cursorY, CURSOR_SIZE, cursorColor);
+  }
+  
+  if (statusVisible && quality < QUALITY_MINIMAL && statusBounds().intersects(rect)) {
+    drawText(canvas, statusText, SCREEN_WIDTH / 2, SCREEN_HEIGHT - 5, 1, TFT_WHITE, BC_DATUM);
+  }
+  
+  canvas->resetClip();
+}
+
+bool DisplayManager::hasPendingChanges() {
+  return dirty.getCount() > 0;
+}
+
+void DisplayManager::setQuality(QualityLevel level) {
+  if (level == quality) {
+    return;
+  }
+  
+  // Statusleiste ein-/ausblenden; laufende Effekte mit neuer Stufe zeichnen
+  if ((level == QUALITY_MINIMAL) != (quality == QUALITY_MINIMAL) && statusVisible) {
+    dirty.add(statusBounds());
+  }
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    const AnimationEffect& effect = animationEngine.get(i);
+    if (effect.active) {
+      dirty.add(effect.footprint);
+    }
+  }
+  
+  Serial.printf("[DISPLAY] Qualität: %s -> %s\n",
+                FrameGovernor::levelName(quality), FrameGovernor::levelName(level));
+  quality = level;
+}
+
+void DisplayManager::renderFrame() {
+  int rectCount = dirty.getCount();
+  DisplayBusStats frameBus;
+  
+  uint32_t renderStart = micros();
+  
+  if (!framebufferActive) {
+    // Direkt auf das Display (blockierend) - jedes Primitive geht über den Bus
+    DisplayBusStats before = directBackend.getBusStats();
+    for (int i = 0; i < rectCount; i++) {
+      composeRect(dirty.get(i));
+    }
+    DisplayBusStats after = directBackend.getBusStats();
+    frameBus.transactions = after.transactions - before.transactions;
+    frameBus.bytes = after.bytes - before.bytes;
+    
+    stats.lastRenderUs = micros() - renderStart;
+    stats.lastFlushUs = 0;
+  } else {
+    // Der hintere Puffer hat den vorletzten Frame - dessen Änderungen nachziehen
+    DirtyRegion composeRegion = dirty;
+    for (int i = 0; i < previousDirtyCount; i++) {
+      composeRegion.add(previousDirty[i]);
+    }
+    for (int i = 0; i < composeRegion.getCount(); i++) {
+      composeRect(composeRegion.get(i));
+    }
+    
+    uint32_t flushStart = micros();
+    stats.lastRenderUs = flushStart - renderStart;
+    
+    // Nur die Änderungen gegenüber dem vorherigen Frame übertragen
+    memset(&flushBus, 0, sizeof(flushBus));
+    for (int i = 0; i < rectCount; i++) {
+      flushRect(dirty.get(i));
+    }
+    frameBus = flushBus;
+    
+    if (screenMirror != nullptr) {
+      for (int i = 0; i < rectCount; i++) {
+        screenMirror->markRect(dirty.get(i));
       }
     }
+    stats.lastFlushUs = micros() - flushStart;
+    
+    previousDirtyCount = rectCount;
+    for (int i = 0; i < rectCount; i++) {
+      previousDirty[i] = dirty.get(i);
+    }
+    
+    // Puffer tauschen - der nächste Frame entsteht, während DMA überträgt
+    backBuffer ^= 1;
+    canvas = frameBuffers[backBuffer];
+  }
+  
+  dirty.clear();
+  
+  if (rectCount > 0) {
+    stats.frames++;
+    stats.totalRenderUs += stats.lastRenderUs;
+    stats.totalFlushUs += stats.lastFlushUs;
+  }
+  stats.lastFrameBytes = (uint32_t)frameBus.bytes;
+  stats.lastFrameTransactions = frameBus.transactions;
+  stats.lastFrameRects = rectCount;
+  stats.totalBytes += frameBus.bytes;
+}
+
+void DisplayManager::flushRect(const Rect& rect) {
+  const uint16_t* image = frameBuffers[backBuffer]->getBuffer();
+  
+  if (!dmaTransactionOpen) {
+    // Transaktion bleibt offen, damit endWrite() nicht auf den DMA wartet
+    tft.startWrite();
+    dmaTransactionOpen = true;
+  }
+  
+  // In Streifen, die in einen Zwischenpuffer passen
+  int linesPerChunk = DMA_BOUNCE_PIXELS / rect.w;
+  for (int y = rect.y; y < rect.y + rect.h; y += linesPerChunk) {
+    int lines = min(linesPerChunk, rect.y + rect.h - y);
+    uint16_t* bounce = dmaBuffers[dmaBufferIndex];
+    dmaBufferIndex ^= 1;
+    
+    // Der Transfer aus diesem Zwischenpuffer ist abgeschlossen: pushImageDMA
+    // hat vor dem Start des letzten Transfers auf ihn gewartet
+    for (int row = 0; row < lines; row++) {
+      memcpy(&bounce[row * rect.w], &image[(y + row) * SCREEN_WIDTH + rect.x], rect.w * 2);
+    }
+    
+    tft.pushImageDMA(rect.x, y, rect.w, lines, bounce);
+    flushBus.transactions++;
+    flushBus.bytes += DisplayBackend::windowBytes(rect.w * lines);
+  }
+}
+
+void DisplayManager::finishFlush() {
+  if (dmaTransactionOpen) {
+    tft.dmaWait();
+    tft.endWrite();
+    dmaTransactionOpen = false;
   }
 }
+
+bool DisplayManager::isFramebufferActive() {
+  return framebufferActive;
+}
+
+bool DisplayManager::isFlushComplete() {
+  return !framebufferActive || !tft.dmaBusy();
+}
+
+size_t DisplayManager::getScreenshotSize() {
+  return framebufferActive ? frameBuffers[0]->getPPMSize() : 0;
+}
+
+size_t DisplayManager::readScreenshot(size_t offset, uint8_t* out, size_t maxLength) {
+  if (!framebufferActive) {
+    return 0;
+  }
+  // Vorderer Puffer = zuletzt übertragener Frame
+  return frameBuffers[backBuffer ^ 1]->readPPM(offset, out, maxLength);
+}
+
+void DisplayManager::setScreenMirror(ScreenMirror* mirror) {
+  screenMirror = mirror;
+}
+
+const MemoryBackend* DisplayManager::getFrontBuffer() {
+  return framebufferActive ? frameBuffers[backBuffer ^ 1] : nullptr;
+}
+
+DisplayStats DisplayManager::getStats() {
+  stats.framebuffer = framebufferActive;
+  return stats;
+}
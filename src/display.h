@@ -8,6 +8,13 @@
 
 #include <TFT_eSPI.h>
 #include <Arduino.h>
+#include "dirty_rect.h"
+#include "animation.h"
+#include "frame_governor.h"
+#include "text_cache.h"
+#include "display_backend.h"
+#include "tft_backend.h"
+#include "screen_mirror.h"
 
 // Display-Dimensionen
 #define SCREEN_WIDTH 240
@@ -18,6 +25,15 @@
 #define CURSOR_MIN_BRIGHTNESS 100
 #define CURSOR_MAX_BRIGHTNESS 255
 
+// Statusleiste am unteren Rand
+#define STATUS_BAR_HEIGHT 15
+#define STATUS_TEXT_MAX 32
+
+// Framebuffer-Modus: zwei RGB565-Bilder im PSRAM, Flush per SPI-DMA
+// über zwei DMA-fähige Zwischenpuffer (ESP32-DMA liest nicht aus PSRAM)
+#define DISPLAY_FRAMEBUFFER_ENABLED 1
+#define DMA_BOUNCE_PIXELS (SCREEN_WIDTH * 16)
+
 // Animationstypen
 enum ClickType {
   CLICK_NONE,
@@ -26,27 +42,84 @@ enum ClickType {
   CLICK_BOTH
 };
 
-// Animation-Struktur
-struct ClickAnimation {
-  int x;
-  int y;
-  ClickType type;
-  int frame;
-  bool active;
+// Wachstum der Effekte über die Laufzeit (Pixel, bisher 2 px pro Frame)
+#define ANIMATION_GROWTH 30
+
+// Compositor-Statistik (SPI-Bilanz, Render- und Flush-Zeiten)
+struct DisplayStats {
+  uint32_t frames;
+  uint32_t lastFrameBytes;
+  uint32_t lastFrameTransactions;
+  uint32_t lastFrameRects;
+  uint64_t totalBytes;
+  uint32_t lastRenderUs;  // CPU-Zeit für den Aufbau des Frames
+  uint32_t lastFlushUs;   // Zeit in der Übertragung (inkl. Warten auf DMA)
+  uint64_t totalRenderUs;
+  uint64_t totalFlushUs;
+  bool framebuffer;
 };
 
 class DisplayManager {
 private:
   TFT_eSPI tft;
   
-  // Animation-Tracking
-  static const int MAX_ANIMATIONS = 5;
-  ClickAnimation animations[MAX_ANIMATIONS];
+  // Klick-Effekte (Typ = ClickType)
+  AnimationEngine animationEngine;
+  
+  // Vom Frame-Budget-Regler vorgegebene Darstellungsqualität
+  QualityLevel quality;
+  
+  // Vorgerenderte Texte (Statusleiste, Info-Bildschirme)
+  TextCache textCache;
+  
+  // Compositor: Szene (Cursor, Animationen, Statusleiste) + Dirty-Bereiche
+  DirtyRegion dirty;
+  bool cursorVisible;
+  int cursorX, cursorY;
+  uint16_t cursorColor;
+  bool statusVisible;
+  char statusText[STATUS_TEXT_MAX];
+  
+  DisplayStats stats;
+  DisplayBusStats flushBus;  // Framebuffer-Modus: Übertragung des Frames
+  
+  // Zeichenziel: directBackend (Display) oder hinterer Framebuffer
+  TftBackend directBackend;
+  DisplayBackend* canvas;
+  
+  // Framebuffer-Modus
+  bool framebufferActive;
+  MemoryBackend* frameBuffers[2];
+  int backBuffer;
+  uint16_t* dmaBuffers[2];
+  int dmaBufferIndex;
+  bool dmaTransactionOpen;
+  Rect previousDirty[MAX_DIRTY_RECTS];  // Rückstand des hinteren Puffers
+  int previousDirtyCount;
+  
+  // Übertragene Bereiche für die Web-Spiegelung (optional)
+  ScreenMirror* screenMirror;
   
   // Hilfsfunktionen
-  void drawConcentricCircles(int x, int y, int frame);
-  void drawRays(int x, int y, int frame);
+  void drawConcentricCircles(int x, int y, int growth);
+  void drawRays(int x, int y, int growth);
   uint16_t speedToColor(float speed);
+  
+  // Compositor
+  Rect cursorBounds(int x, int y);
+  Rect animationBounds(const AnimationEffect& effect);
+  Rect statusBounds();
+  void drawAnimation(const AnimationEffect& effect);
+  void composeRect(const Rect& rect);
+  void resetScene();
+  void drawText(DisplayBackend* target, const char* text, int x, int y, uint8_t size,
+                uint16_t color, uint8_t datum);
+  void drawScreenText(const char* text, int x, int y, uint8_t size, uint16_t color, uint8_t datum);
+  
+  // Framebuffer-Modus
+  bool enableFramebuffer();
+  void flushRect(const Rect& rect);
+  void finishFlush();
 
 public:
   DisplayManager();
@@ -65,6 +138,26 @@ public:
   void drawCursor(int x, int y, float speed);
   void drawClickAnimation(int x, int y, ClickType type);
   void updateAnimations();
+  
+  // Geänderte Bereiche neu aufbauen und zum Display übertragen
+  bool hasPendingChanges();
+  void setQuality(QualityLevel level);
+  void renderFrame();
+  DisplayStats getStats();
+  AnimationStats getAnimationStats();
+  TextCacheStats getTextCacheStats();
+  
+  // Framebuffer-Modus: true, sobald der letzte DMA-Flush abgeschlossen ist
+  bool isFramebufferActive();
+  bool isFlushComplete();
+  
+  // Aktuelles Bild als PPM (nur im Framebuffer-Modus, sonst Größe 0)
+  size_t getScreenshotSize();
+  size_t readScreenshot(size_t offset, uint8_t* out, size_t maxLength);
+  
+  // Web-Spiegelung: zuletzt übertragener Frame (nullptr im direkten Modus)
+  void setScreenMirror(ScreenMirror* mirror);
+  const MemoryBackend* getFrontBuffer();
 };
 
 #endif
@@ -0,0 +1,145 @@
+/**
+ * Zeichen-Backend Implementierung
+ */
+
+#include "display_backend.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+  #include <esp32-hal-psram.h>
+#endif
+
+// ========== DisplayBackend ==========
+
+DisplayBackend::DisplayBackend(int16_t w, int16_t h) {
+  width = w;
+  height = h;
+  resetClip();
+  resetBusStats();
+}
+
+void DisplayBackend::setClip(const Rect& rect) {
+  clip = rect.intersect(Rect::make(0, 0, width, height));
+}
+
+void DisplayBackend::resetClip() {
+  clip = Rect::make(0, 0, width, height);
+}
+
+void DisplayBackend::fillRect(int x, int y, int w, int h, uint16_t color) {
+  Rect r = Rect::make(x, y, w, h).intersect(clip);
+  if (r.isEmpty()) {
+    return;
+  }
+
+  writeRect(r.x, r.y, r.w, r.h, color);
+  bus.transactions++;
+  bus.bytes += windowBytes(r.area());
+}
+
+void DisplayBackend::pushImage(int x, int y, int w, int h, const uint16_t* image) {
+  Rect r = Rect::make(x, y, w, h).intersect(clip);
+  if (r.isEmpty()) {
+    return;
+  }
+
+  writeImage(r.x, r.y, r.w, r.h, image + (r.y - y) * w + (r.x - x), w);
+  bus.transactions++;
+  bus.bytes += windowBytes(r.area());
+}
+
+void DisplayBackend::resetBusStats() {
+  memset(&bus, 0, sizeof(bus));
+}
+
+// ========== MemoryBackend ==========
+
+MemoryBackend::MemoryBackend(int16_t w, int16_t h) : DisplayBackend(w, h) {
+  pixels = nullptr;
+}
+
+MemoryBackend::~MemoryBackend() {
+  free(pixels);
+}
+
+bool MemoryBackend::begin(bool preferPsram) {
+  if (pixels != nullptr) {
+    return true;
+  }
+
+  size_t size = (size_t)width * height * 2;
+#ifdef ARDUINO
+  pixels = (uint16_t*)(preferPsram && psramFound() ? ps_malloc(size) : malloc(size));
+#else
+  (void)preferPsram;
+  pixels = (uint16_t*)malloc(size);
+#endif
+
+  if (pixels == nullptr) {
+    return false;
+  }
+  memset(pixels, 0, size);
+  return true;
+}
+
+void MemoryBackend::writeRect(int x, int y, int w, int h, uint16_t color) {
+  uint16_t value = toBusOrder(color);
+  for (int row = y; row < y + h; row++) {
+    uint16_t* line = &pixels[row * width + x];
+    for (int col = 0; col < w; col++) {
+      line[col] = value;
+    }
+  }
+}
+
+void MemoryBackend::writeImage(int x, int y, int w, int h, const uint16_t* image, int stride) {
+  for (int row = 0; row < h; row++) {
+    memcpy(&pixels[(y + row) * width + x], &image[row * stride], w * 2);
+  }
+}
+
+uint16_t MemoryBackend::getPixel(int x, int y) const {
+  return toBusOrder(pixels[y * width + x]);
+}
+
+static size_t ppmHeader(char* out, size_t size, int width, int height) {
+  return snprintf(out, size, "P6\n%d %d\n255\n", width, height);
+}
+
+size_t MemoryBackend::getPPMSize() const {
+  char header[24];
+  return ppmHeader(header, sizeof(header), width, height) + (size_t)width * height * 3;
+}
+
+size_t MemoryBackend::readPPM(size_t offset, uint8_t* out, size_t maxLength) const {
+  if (pixels == nullptr) {
+    return 0;
+  }
+
+  char header[24];
+  size_t headerSize = ppmHeader(header, sizeof(header), width, height);
+  size_t total = headerSize + (size_t)width * height * 3;
+  size_t written = 0;
+
+  while (written < maxLength && offset < total) {
+    if (offset < headerSize) {
+      out[written++] = header[offset++];
+      continue;
+    }
+
+    // RGB565 auf 8 Bit je Kanal aufweiten
+    size_t index = (offset - headerSize) / 3;
+    uint16_t c = toBusOrder(pixels[index]);
+    uint8_t rgb[3] = {
+      (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+      (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+      (uint8_t)((c & 0x1F) * 255 / 31)
+    };
+    out[written++] = rgb[(offset - headerSize) % 3];
+    offset++;
+  }
+
+  return written;
+}
@@ -0,0 +1,87 @@
+/**
+ * Zeichen-Backend für den Display-Compositor
+ * Einheitliche Primitive (Rechteck, Linie, Pixel, Bild) mit Clipping und
+ * einer SPI-Bilanz, als würde jedes Primitive über den Bus gehen (ein
+ * Adressfenster pro Aufruf). MemoryBackend hält ein RGB565-Bild im Speicher
+ * und kann es als PPM ausgeben. Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef DISPLAY_BACKEND_H
+#define DISPLAY_BACKEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "dirty_rect.h"
+
+// SPI-Overhead pro Adressfenster (CASET, RASET, RAMWR)
+#define SPI_WINDOW_OVERHEAD 11
+
+struct DisplayBusStats {
+  uint32_t transactions;  // Adressfenster
+  uint64_t bytes;
+};
+
+class DisplayBackend {
+protected:
+  int16_t width;
+  int16_t height;
+  Rect clip;
+  DisplayBusStats bus;
+
+  // Bereits geclippte Bereiche schreiben
+  virtual void writeRect(int x, int y, int w, int h, uint16_t color) = 0;
+  virtual void writeImage(int x, int y, int w, int h, const uint16_t* image, int stride) = 0;
+
+public:
+  DisplayBackend(int16_t width, int16_t height);
+  virtual ~DisplayBackend() {}
+
+  int16_t getWidth() const { return width; }
+  int16_t getHeight() const { return height; }
+
+  // Alles außerhalb von rect wird verworfen
+  void setClip(const Rect& rect);
+  void resetClip();
+
+  // Farben als RGB565
+  void fillRect(int x, int y, int w, int h, uint16_t color);
+  void drawHLine(int x, int y, int w, uint16_t color) { fillRect(x, y, w, 1, color); }
+  void drawVLine(int x, int y, int h, uint16_t color) { fillRect(x, y, 1, h, color); }
+  void drawPixel(int x, int y, uint16_t color) { fillRect(x, y, 1, 1, color); }
+
+  // Bild in Bus-Reihenfolge (RGB565 big-endian, wie in TFT_eSprite)
+  void pushImage(int x, int y, int w, int h, const uint16_t* image);
+
+  DisplayBusStats getBusStats() const { return bus; }
+  void resetBusStats();
+
+  static uint32_t windowBytes(uint32_t pixels) { return pixels * 2 + SPI_WINDOW_OVERHEAD; }
+  static uint16_t toBusOrder(uint16_t color) { return (uint16_t)((color >> 8) | (color << 8)); }
+};
+
+// RGB565-Bild im Speicher (Bus-Reihenfolge, direkt per DMA übertragbar)
+class MemoryBackend : public DisplayBackend {
+private:
+  uint16_t* pixels;
+
+protected:
+  void writeRect(int x, int y, int w, int h, uint16_t color) override;
+  void writeImage(int x, int y, int w, int h, const uint16_t* image, int stride) override;
+
+public:
+  MemoryBackend(int16_t width, int16_t height);
+  ~MemoryBackend() override;
+
+  // Bildspeicher anlegen (bevorzugt im PSRAM)
+  bool begin(bool preferPsram);
+
+  uint16_t* getBuffer() { return pixels; }
+  const uint16_t* getBuffer() const { return pixels; }
+  uint16_t getPixel(int x, int y) const;  // RGB565
+
+  // Binäres PPM (P6), stückweise lesbar für Streaming-Antworten
+  size_t getPPMSize() const;
+  size_t readPPM(size_t offset, uint8_t* out, size_t maxLength) const;
+};
+
+#endif
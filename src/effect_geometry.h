@@ -0,0 +1,113 @@
+/**
+ * Geometrie-Tabellen für die Klick-Effekte (zur Compile-Zeit erzeugt)
+ * Strahlen-Endpunkte je Länge und Kreis-Oktanten je Radius - zur Laufzeit
+ * kein sin/cos und kein Bresenham mehr. C++11-kompatibel (Arduino-Toolchain).
+ */
+
+#ifndef EFFECT_GEOMETRY_H
+#define EFFECT_GEOMETRY_H
+
+#include <stdint.h>
+
+#define EFFECT_MAX_RING_RADIUS 49   // Größere Ringe werden nicht gezeichnet
+#define EFFECT_MAX_RAY_LENGTH 30
+#define EFFECT_RAY_COUNT 8          // 45°-Schritte, Winkel 0° = rechts, im Uhrzeigersinn
+#define CIRCLE_OCTANT_MAX 36        // > EFFECT_MAX_RING_RADIUS / sqrt(2) + 1
+
+// Ein Kreis-Oktant: für jede Zeile i (0..length-1) die Spalte x[i],
+// beginnend am Pol (0, r) bis zur Diagonale
+struct CircleOctant {
+  uint8_t length;
+  uint8_t x[CIRCLE_OCTANT_MAX];
+};
+
+struct CircleOctantTable {
+  CircleOctant radius[EFFECT_MAX_RING_RADIUS + 1];
+};
+
+struct RayEndpoints {
+  int8_t dx[EFFECT_RAY_COUNT];
+  int8_t dy[EFFECT_RAY_COUNT];
+};
+
+struct RayEndpointTable {
+  RayEndpoints length[EFFECT_MAX_RAY_LENGTH + 1];
+};
+
+namespace effect_geometry {
+
+// Indexfolge (std::index_sequence gibt es erst ab C++14)
+template<int... I> struct IndexSeq {};
+template<int N, int... I> struct MakeIndexSeq : MakeIndexSeq<N - 1, N - 1, I...> {};
+template<int... I> struct MakeIndexSeq<0, I...> { typedef IndexSeq<I...> type; };
+
+// Ganzzahlige Wurzel per Binärsuche, gerundet
+constexpr int isqrtRange(int n, int lo, int hi) {
+  return lo >= hi ? lo
+       : ((lo + hi + 1) / 2) * ((lo + hi + 1) / 2) <= n ? isqrtRange(n, (lo + hi + 1) / 2, hi)
+       : isqrtRange(n, lo, (lo + hi + 1) / 2 - 1);
+}
+constexpr int isqrtFloor(int n) { return isqrtRange(n, 0, n / 2 + 1); }
+constexpr int roundSqrt(int n, int s) { return n > s * s + s ? s + 1 : s; }
+constexpr int isqrtRound(int n) { return roundSqrt(n, isqrtFloor(n)); }
+
+// ---------- Kreis-Oktanten ----------
+
+constexpr int circleX(int r, int i) { return isqrtRound(r * r - i * i); }
+constexpr int octantLength(int r, int i) {
+  return (i <= r && i <= circleX(r, i)) ? octantLength(r, i + 1) : i;
+}
+
+template<int... I>
+constexpr CircleOctant makeOctant(int r, IndexSeq<I...>) {
+  return CircleOctant{ (uint8_t)octantLength(r, 0),
+                       { (uint8_t)(I < octantLength(r, 0) ? circleX(r, I) : 0)... } };
+}
+
+template<int... R>
+constexpr CircleOctantTable makeCircleTable(IndexSeq<R...>) {
+  return CircleOctantTable{ { makeOctant(R, typename MakeIndexSeq<CIRCLE_OCTANT_MAX>::type())... } };
+}
+
+// ---------- Strahlen ----------
+
+constexpr int diagonal(int length) { return length * 7071 / 10000; }  // length * cos(45°)
+
+constexpr int rayDx(int length, int k) {
+  return k == 0 ? length
+       : k == 1 || k == 7 ? diagonal(length)
+       : k == 2 || k == 6 ? 0
+       : k == 4 ? -length
+       : -diagonal(length);
+}
+constexpr int rayDy(int length, int k) { return rayDx(length, (k + 6) % EFFECT_RAY_COUNT); }
+
+template<int... K>
+constexpr RayEndpoints makeRay(int length, IndexSeq<K...>) {
+  return RayEndpoints{ { (int8_t)rayDx(length, K)... }, { (int8_t)rayDy(length, K)... } };
+}
+
+template<int... L>
+constexpr RayEndpointTable makeRayTable(IndexSeq<L...>) {
+  return RayEndpointTable{ { makeRay(L, typename MakeIndexSeq<EFFECT_RAY_COUNT>::type())... } };
+}
+
+}  // namespace effect_geometry
+
+static constexpr CircleOctantTable CIRCLE_OCTANTS =
+  effect_geometry::makeCircleTable(effect_geometry::MakeIndexSeq<EFFECT_MAX_RING_RADIUS + 1>::type());
+
+static constexpr RayEndpointTable RAY_ENDPOINTS =
+  effect_geometry::makeRayTable(effect_geometry::MakeIndexSeq<EFFECT_MAX_RAY_LENGTH + 1>::type());
+
+// Stichproben - die Tabellen werden beim Übersetzen geprüft
+static_assert(CIRCLE_OCTANTS.radius[0].length == 1, "Radius 0 ist ein Punkt");
+static_assert(CIRCLE_OCTANTS.radius[10].length == 8 && CIRCLE_OCTANTS.radius[10].x[7] == 7,
+              "Oktant r=10 endet an der Diagonale");
+static_assert(CIRCLE_OCTANTS.radius[EFFECT_MAX_RING_RADIUS].length <= CIRCLE_OCTANT_MAX,
+              "CIRCLE_OCTANT_MAX zu klein");
+static_assert(RAY_ENDPOINTS.length[30].dx[0] == 30 && RAY_ENDPOINTS.length[30].dy[2] == 30 &&
+              RAY_ENDPOINTS.length[30].dx[3] == -21 && RAY_ENDPOINTS.length[30].dy[5] == -21,
+              "Strahlen-Endpunkte");
+
+#endif
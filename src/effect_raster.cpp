@@ -0,0 +1,88 @@
+/**
+ * Rasterung der Klick-Effekte Implementierung
+ */
+
+#include "effect_raster.h"
+#include <stdlib.h>
+
+void rasterRing(DisplayBackend& target, int x, int y, int radius, uint16_t color) {
+  // Aufeinanderfolgende Oktant-Punkte mit gleichem x bilden eine Strecke -
+  // jede Strecke ist ein Adressfenster statt einzelner Pixel
+  const CircleOctant& octant = CIRCLE_OCTANTS.radius[radius];
+  int start = 0;
+  
+  for (int i = 1; i <= octant.length; i++) {
+    if (i < octant.length && octant.x[i] == octant.x[start]) {
+      continue;
+    }
+    
+    int h = octant.x[start];
+    int end = i - 1;
+    
+    if (start == 0) {
+      // Strecke über die Achse: eine durchgehende Linie je Pol
+      int len = 2 * end + 1;
+      target.drawHLine(x - end, y - h, len, color);
+      target.drawHLine(x - end, y + h, len, color);
+      target.drawVLine(x - h, y - end, len, color);
+      target.drawVLine(x + h, y - end, len, color);
+    } else {
+      int len = end - start + 1;
+      target.drawHLine(x + start, y - h, len, color);
+      target.drawHLine(x - end, y - h, len, color);
+      target.drawHLine(x + start, y + h, len, color);
+      target.drawHLine(x - end, y + h, len, color);
+      target.drawVLine(x - h, y + start, len, color);
+      target.drawVLine(x - h, y - end, len, color);
+      target.drawVLine(x + h, y + start, len, color);
+      target.drawVLine(x + h, y - end, len, color);
+    }
+    
+    start = i;
+  }
+}
+
+void rasterFilledCircle(DisplayBackend& target, int x, int y, int radius, uint16_t color) {
+  // Gefüllter Kreis aus dem Oktanten: je Tabellenzeile zwei waagerechte
+  // Strecken (Zeilen y±i) plus die Pol-Zeilen je Lauf (Zeilen y±x)
+  const CircleOctant& octant = CIRCLE_OCTANTS.radius[radius];
+  int start = 0;
+  
+  for (int i = 0; i < octant.length; i++) {
+    int half = octant.x[i];
+    target.drawHLine(x - half, y - i, 2 * half + 1, color);
+    if (i > 0) {
+      target.drawHLine(x - half, y + i, 2 * half + 1, color);
+    }
+    
+    // Ende eines Laufs gleicher x-Werte: Zeile y±x in voller Breite des Laufs
+    if (i + 1 == octant.length || octant.x[i + 1] != octant.x[start]) {
+      if (octant.x[start] >= octant.length) {
+        target.drawHLine(x - i, y - octant.x[start], 2 * i + 1, color);
+        target.drawHLine(x - i, y + octant.x[start], 2 * i + 1, color);
+      }
+      start = i + 1;
+    }
+  }
+}
+
+void rasterRays(DisplayBackend& target, int x, int y, int length, bool diagonals, uint16_t color) {
+  const RayEndpoints& ray = RAY_ENDPOINTS.length[length];
+  
+  // Gegenüberliegende waagerechte/senkrechte Strahlen als eine Linie
+  target.drawHLine(x + ray.dx[4], y, 2 * length + 1, color);
+  target.drawVLine(x, y + ray.dy[6], 2 * length + 1, color);
+  
+  // Diagonalen: jedes Pixel liegt in einer eigenen Zeile und Spalte
+  if (!diagonals) {
+    return;
+  }
+  for (int k = 1; k < EFFECT_RAY_COUNT; k += 2) {
+    // Exakt 45°: |dx| == |dy|
+    int sx = ray.dx[k] > 0 ? 1 : -1;
+    int sy = ray.dy[k] > 0 ? 1 : -1;
+    for (int d = 1; d <= abs(ray.dx[k]); d++) {
+      target.drawPixel(x + d * sx, y + d * sy, color);
+    }
+  }
+}
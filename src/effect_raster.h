@@ -0,0 +1,24 @@
+/**
+ * Rasterung der Klick-Effekte und des Cursors aus den Geometrie-Tabellen
+ * Jede Strecke gleicher Zeile/Spalte ist ein Adressfenster auf dem Backend.
+ * Ohne Arduino-Abhängigkeiten, damit die Bus-Bilanz auf dem Host messbar ist.
+ */
+
+#ifndef EFFECT_RASTER_H
+#define EFFECT_RASTER_H
+
+#include <stdint.h>
+#include "display_backend.h"
+#include "effect_geometry.h"
+
+// Kreislinie (radius <= EFFECT_MAX_RING_RADIUS)
+void rasterRing(DisplayBackend& target, int x, int y, int radius, uint16_t color);
+
+// Gefüllter Kreis (Cursor)
+void rasterFilledCircle(DisplayBackend& target, int x, int y, int radius, uint16_t color);
+
+// 8 Strahlen in 45°-Schritten (length <= EFFECT_MAX_RAY_LENGTH),
+// ohne Diagonalen nur das Kreuz
+void rasterRays(DisplayBackend& target, int x, int y, int length, bool diagonals, uint16_t color);
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * Frame-Budget-Regler Implementierung
+ */
+
+#include "frame_governor.h"
+#include <string.h>
+
+FrameGovernor::FrameGovernor() {
+  cyclesPerUs = 240;
+  budgetCycles = FRAME_BUDGET_US * cyclesPerUs;
+  level = QUALITY_FULL;
+  history = 0;
+  calmFrames = 0;
+  resetStats();
+}
+
+void FrameGovernor::setBudget(uint32_t budgetUs, uint32_t cpuMhz) {
+  cyclesPerUs = cpuMhz ? cpuMhz : 1;
+  budgetCycles = budgetUs * cyclesPerUs;
+}
+
+QualityLevel FrameGovernor::recordFrame(uint32_t cycles) {
+  uint32_t us = cycles / cyclesPerUs;
+  stats.frames++;
+  stats.lastUs = us;
+  if (us > stats.maxUs) {
+    stats.maxUs = us;
+  }
+
+  bool overrun = cycles > budgetCycles;
+  history = ((history << 1) | (overrun ? 1 : 0)) & ((1u << GOVERNOR_HISTORY) - 1);
+
+  if (overrun) {
+    stats.overruns++;
+    calmFrames = 0;
+
+    if (__builtin_popcount(history) >= GOVERNOR_STEP_DOWN_OVERRUNS &&
+        level < QUALITY_LEVELS - 1) {
+      level = (QualityLevel)(level + 1);
+      stats.stepDowns++;
+      history = 0;  // Neue Stufe erst wieder nach neuen Überschreitungen senken
+    }
+  } else if ((uint64_t)cycles * 100 < (uint64_t)budgetCycles * GOVERNOR_HEADROOM_PERCENT) {
+    calmFrames++;
+    if (calmFrames >= GOVERNOR_STEP_UP_FRAMES && level > QUALITY_FULL) {
+      level = (QualityLevel)(level - 1);
+      stats.stepUps++;
+      calmFrames = 0;
+    }
+  } else {
+    calmFrames = 0;
+  }
+
+  return level;
+}
+
+FrameGovernorStats FrameGovernor::getStats() const {
+  FrameGovernorStats s = stats;
+  s.level = level;
+  return s;
+}
+
+void FrameGovernor::resetStats() {
+  memset(&stats, 0, sizeof(stats));
+  stats.level = level;
+}
+
+const char* FrameGovernor::levelName(QualityLevel level) {
+  switch (level) {
+    case QUALITY_FULL: return "full";
+    case QUALITY_REDUCED: return "reduced";
+    case QUALITY_MINIMAL: return "minimal";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,61 @@
+/**
+ * Frame-Budget-Regler: misst die Arbeit pro Frame in CPU-Zyklen und senkt
+ * bei wiederholten Überschreitungen die Darstellungsqualität stufenweise
+ * (weniger Ringe/Strahlen, keine Statusleiste). Bei genug Reserve geht es
+ * wieder eine Stufe hinauf. Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <stdint.h>
+
+#define FRAME_BUDGET_US 16000
+#define GOVERNOR_HISTORY 8           // Betrachtete letzte Frames
+#define GOVERNOR_STEP_DOWN_OVERRUNS 2 // So viele Überschreitungen darin -> Stufe runter
+#define GOVERNOR_STEP_UP_FRAMES 60   // So viele Frames mit Reserve -> Stufe hoch
+#define GOVERNOR_HEADROOM_PERCENT 60 // "Reserve": unter diesem Anteil des Budgets
+
+// Darstellungsqualität (aufsteigend = günstiger)
+enum QualityLevel {
+  QUALITY_FULL,     // 3 Ringe, 8 Strahlen, Statusleiste
+  QUALITY_REDUCED,  // 2 Ringe, 4 Strahlen (ohne Diagonalen)
+  QUALITY_MINIMAL,  // 1 Ring, 4 Strahlen, keine Statusleiste
+  QUALITY_LEVELS
+};
+
+struct FrameGovernorStats {
+  QualityLevel level;
+  uint32_t frames;
+  uint32_t overruns;
+  uint32_t stepDowns;
+  uint32_t stepUps;
+  uint32_t lastUs;
+  uint32_t maxUs;
+};
+
+class FrameGovernor {
+private:
+  uint32_t budgetCycles;
+  uint32_t cyclesPerUs;
+  QualityLevel level;
+  uint32_t history;      // Bit i = Überschreitung vor i Frames
+  uint32_t calmFrames;   // Frames in Folge mit Reserve
+  FrameGovernorStats stats;
+
+public:
+  FrameGovernor();
+
+  void setBudget(uint32_t budgetUs, uint32_t cpuMhz);
+
+  // Dauer eines Frames in CPU-Zyklen melden; liefert die neue Qualitätsstufe
+  QualityLevel recordFrame(uint32_t cycles);
+
+  QualityLevel getLevel() const { return level; }
+  FrameGovernorStats getStats() const;
+  void resetStats();
+
+  static const char* levelName(QualityLevel level);
+};
+
+#endif
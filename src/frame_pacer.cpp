@@ -0,0 +1,88 @@
+/**
+ * Frame-Pacer Implementierung
+ */
+
+#include "frame_pacer.h"
+
+FramePacer::FramePacer(LoopClock clockSource) {
+  clock = clockSource;
+  frameIntervalUs = 1000000 / DISPLAY_MAX_FPS;
+  idleTimeoutUs = DISPLAY_IDLE_TIMEOUT_MS * 1000;
+  changed = false;
+  lastFrameUs = 0;
+  lastChangeUs = 0;
+  statsStartUs = 0;
+  renderedCount = 0;
+}
+
+void FramePacer::setMaxFps(uint16_t fps) {
+  frameIntervalUs = 1000000 / (fps ? fps : 1);
+}
+
+void FramePacer::setIdleTimeout(uint32_t timeoutMs) {
+  idleTimeoutUs = timeoutMs * 1000;
+}
+
+void FramePacer::start() {
+  uint32_t now = clock();
+  // Erster Frame nach einer Änderung sofort
+  lastFrameUs = now - frameIntervalUs;
+  lastChangeUs = now;
+  resetStats();
+}
+
+void FramePacer::markChanged() {
+  changed = true;
+  lastChangeUs = clock();
+}
+
+bool FramePacer::beginFrame() {
+  if (!changed) {
+    return false;
+  }
+
+  uint32_t now = clock();
+  if (now - lastFrameUs < frameIntervalUs) {
+    return false;  // Framerate-Obergrenze
+  }
+
+  // Nach längerer Pause sofort rendern, sonst im Raster der Obergrenze bleiben
+  if (now - lastFrameUs >= 2 * frameIntervalUs) {
+    lastFrameUs = now;
+  } else {
+    lastFrameUs += frameIntervalUs;
+  }
+
+  changed = false;
+  renderedCount++;
+  return true;
+}
+
+uint32_t FramePacer::timeUntilNextFrame() {
+  if (!changed) {
+    return UINT32_MAX;
+  }
+
+  uint32_t elapsed = clock() - lastFrameUs;
+  return elapsed >= frameIntervalUs ? 0 : frameIntervalUs - elapsed;
+}
+
+bool FramePacer::isIdle() {
+  return !changed && clock() - lastChangeUs >= idleTimeoutUs;
+}
+
+FramePacerStats FramePacer::getStats() {
+  FramePacerStats stats;
+  uint32_t slots = (clock() - statsStartUs) / frameIntervalUs;
+
+  stats.rendered = renderedCount;
+  stats.skipped = slots > renderedCount ? slots - renderedCount : 0;
+  stats.maxFps = 1000000 / frameIntervalUs;
+  stats.idle = isIdle();
+  return stats;
+}
+
+void FramePacer::resetStats() {
+  statsStartUs = clock();
+  renderedCount = 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * Frame-Pacing für das Display: gerendert wird nur nach einer Änderung
+ * (Eingabe, Animation, Status), höchstens mit der eingestellten Framerate.
+ * Ohne Änderungen wechselt der Pacer nach einer Weile in den Leerlauf.
+ * Zeitquelle wie beim LoopScheduler injiziert (ohne Arduino-Abhängigkeiten).
+ */
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdint.h>
+#include "loop_scheduler.h"
+
+#define DISPLAY_MAX_FPS 60
+#define DISPLAY_IDLE_TIMEOUT_MS 2000  // Ohne Änderung so lange -> Leerlauf
+
+struct FramePacerStats {
+  uint32_t rendered;
+  uint32_t skipped;   // Frame-Slots ohne Änderung (bisher trotzdem neu gezeichnet)
+  uint16_t maxFps;
+  bool idle;
+};
+
+class FramePacer {
+private:
+  LoopClock clock;
+  uint32_t frameIntervalUs;
+  uint32_t idleTimeoutUs;
+  bool changed;
+  uint32_t lastFrameUs;
+  uint32_t lastChangeUs;
+  uint32_t statsStartUs;
+  uint32_t renderedCount;
+
+public:
+  explicit FramePacer(LoopClock clock);
+
+  void setMaxFps(uint16_t fps);
+  void setIdleTimeout(uint32_t timeoutMs);
+  void start();
+
+  // Sichtbarer Zustand hat sich geändert - nächster Frame wird gerendert
+  void markChanged();
+
+  // true, wenn jetzt ein Frame gerendert werden soll (zählt ihn)
+  bool beginFrame();
+
+  // Mikrosekunden bis zum nächsten Frame (UINT32_MAX, wenn nichts ansteht)
+  uint32_t timeUntilNextFrame();
+
+  bool isIdle();
+
+  FramePacerStats getStats();
+  void resetStats();
+};
+
+#endif
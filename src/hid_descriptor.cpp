@@ -0,0 +1,320 @@
+/**
+ * HID-Deskriptor-Parser Implementierung
+ *
+ * Unterstützt die für Mäuse relevanten Items (HID 1.11, Kap. 6.2.2):
+ * Usage Page, Usage, Usage Min/Max, Logical Min, Report Size/Count/ID,
+ * Push/Pop und Input. Alle übrigen Items werden übersprungen.
+ */
+
+#include "hid_descriptor.h"
+#include <string.h>
+
+// ========== HID-Konstanten ==========
+
+// Item-Typen
+#define HID_TYPE_MAIN 0
+#define HID_TYPE_GLOBAL 1
+#define HID_TYPE_LOCAL 2
+
+// Main-Items
+#define HID_MAIN_INPUT 0x8
+#define HID_MAIN_COLLECTION 0xA
+#define HID_MAIN_END_COLLECTION 0xC
+
+// Global-Items
+#define HID_GLOBAL_USAGE_PAGE 0x0
+#define HID_GLOBAL_LOGICAL_MIN 0x1
+#define HID_GLOBAL_REPORT_SIZE 0x7
+#define HID_GLOBAL_REPORT_ID 0x8
+#define HID_GLOBAL_REPORT_COUNT 0x9
+#define HID_GLOBAL_PUSH 0xA
+#define HID_GLOBAL_POP 0xB
+
+// Local-Items
+#define HID_LOCAL_USAGE 0x0
+#define HID_LOCAL_USAGE_MIN 0x1
+#define HID_LOCAL_USAGE_MAX 0x2
+
+// Input-Flags
+#define HID_INPUT_CONSTANT 0x01
+#define HID_INPUT_VARIABLE 0x02
+
+// Usages (Page << 16 | ID)
+#define HID_PAGE_GENERIC_DESKTOP 0x01
+#define HID_PAGE_BUTTON 0x09
+#define HID_PAGE_CONSUMER 0x0C
+#define HID_USAGE_X 0x00010030
+#define HID_USAGE_Y 0x00010031
+#define HID_USAGE_WHEEL 0x00010038
+#define HID_USAGE_AC_PAN 0x000C0238
+
+// ========== Parser-Zustand ==========
+
+struct HidGlobalState {
+  uint16_t usagePage;
+  int32_t logicalMin;
+  uint32_t reportSize;
+  uint32_t reportCount;
+  uint8_t reportId;
+};
+
+struct HidReportAccumulator {
+  bool used;
+  uint8_t reportId;
+  uint32_t bitLength;
+  HidFieldPlan fields[HID_FIELD_COUNT];
+};
+
+static uint32_t readItemData(const uint8_t* data, uint8_t size) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < size; i++) {
+    value |= (uint32_t)data[i] << (8 * i);
+  }
+  return value;
+}
+
+static int32_t signExtendItem(uint32_t value, uint8_t size) {
+  if (size == 1) return (int8_t)value;
+  if (size == 2) return (int16_t)value;
+  return (int32_t)value;
+}
+
+static void setFieldPlan(HidFieldPlan& field, uint32_t bitOffset, uint8_t bitSize, bool isSigned) {
+  field.byteOffset = bitOffset / 8;
+  field.shift = bitOffset % 8;
+  field.bitSize = bitSize;
+  field.signShift = isSigned ? 64 - bitSize : 0;
+  field.mask = (bitSize >= 64) ? ~0ULL : ((1ULL << bitSize) - 1);
+}
+
+static HidReportAccumulator* findReport(HidReportAccumulator* reports, uint8_t reportId) {
+  for (int i = 0; i < HID_MAX_REPORT_IDS; i++) {
+    if (reports[i].used && reports[i].reportId == reportId) {
+      return &reports[i];
+    }
+  }
+  for (int i = 0; i < HID_MAX_REPORT_IDS; i++) {
+    if (!reports[i].used) {
+      memset(&reports[i], 0, sizeof(reports[i]));
+      reports[i].used = true;
+      reports[i].reportId = reportId;
+      return &reports[i];
+    }
+  }
+  return nullptr;
+}
+
+// Input-Item auf die bekannten Maus-Felder abbilden
+static void addInputItem(HidReportAccumulator* report, const HidGlobalState& global, uint32_t flags,
+                         const uint32_t* usages, int usageCount,
+                         uint32_t usageMin, uint32_t usageMax, bool hasUsageRange) {
+  uint32_t bitOffset = report->bitLength;
+  report->bitLength += global.reportSize * global.reportCount;
+
+  if ((flags & HID_INPUT_CONSTANT) || global.reportSize == 0 || global.reportSize > 32) {
+    return;  // Padding oder nicht unterstützte Breite
+  }
+
+  // Die Extraktion liest 64 Bit ab byteOffset - Felder müssen im Report-Puffer liegen
+  if (report->bitLength > HID_MAX_REPORT_SIZE * 8) {
+    return;
+  }
+
+  bool isSigned = global.logicalMin < 0;
+
+  // Buttons: 1-Bit-Variablen auf der Button-Page, zusammen als Bitmaske
+  bool isButtonRange = hasUsageRange && (usageMin >> 16) == HID_PAGE_BUTTON;
+  bool isButtonPage = usageCount == 0 && !hasUsageRange && global.usagePage == HID_PAGE_BUTTON;
+  if ((isButtonRange || isButtonPage) && global.reportSize == 1 && (flags & HID_INPUT_VARIABLE)) {
+    HidFieldPlan& buttons = report->fields[HID_FIELD_BUTTONS];
+    if (buttons.bitSize == 0) {
+      uint32_t count = global.reportCount > 32 ? 32 : global.reportCount;
+      setFieldPlan(buttons, bitOffset, (uint8_t)count, false);
+    }
+    return;
+  }
+
+  if (!(flags & HID_INPUT_VARIABLE)) {
+    return;  // Arrays werden für Mäuse nicht benötigt
+  }
+
+  for (uint32_t i = 0; i < global.reportCount; i++) {
+    uint32_t usage;
+    if (usageCount > 0) {
+      usage = usages[i < (uint32_t)usageCount ? i : usageCount - 1];
+    } else if (hasUsageRange && usageMin + i <= usageMax) {
+      usage = usageMin + i;
+    } else {
+      break;
+    }
+
+    int fieldIndex = -1;
+    switch (usage) {
+      case HID_USAGE_X: fieldIndex = HID_FIELD_X; break;
+      case HID_USAGE_Y: fieldIndex = HID_FIELD_Y; break;
+      case HID_USAGE_WHEEL: fieldIndex = HID_FIELD_WHEEL; break;
+      case HID_USAGE_AC_PAN: fieldIndex = HID_FIELD_PAN; break;
+      default: break;
+    }
+
+    if (fieldIndex >= 0 && report->fields[fieldIndex].bitSize == 0) {
+      setFieldPlan(report->fields[fieldIndex], bitOffset + i * global.reportSize,
+                   (uint8_t)global.reportSize, isSigned);
+    }
+  }
+}
+
+// ========== Öffentliche API ==========
+
+bool HidDescriptorParser::parse(const uint8_t* descriptor, size_t length, HidExtractionPlan& plan) {
+  HidReportAccumulator reports[HID_MAX_REPORT_IDS];
+  memset(reports, 0, sizeof(reports));
+
+  HidGlobalState global;
+  memset(&global, 0, sizeof(global));
+  HidGlobalState globalStack[HID_MAX_GLOBAL_STACK];
+  int stackDepth = 0;
+
+  uint32_t usages[HID_MAX_USAGES];
+  int usageCount = 0;
+  uint32_t usageMin = 0;
+  uint32_t usageMax = 0;
+  bool hasUsageRange = false;
+
+  size_t pos = 0;
+  while (pos < length) {
+    uint8_t prefix = descriptor[pos++];
+
+    // Long Item überspringen
+    if (prefix == 0xFE) {
+      if (pos + 2 > length) break;
+      pos += 2 + descriptor[pos];
+      continue;
+    }
+
+    uint8_t size = prefix & 0x03;
+    if (size == 3) size = 4;
+    uint8_t type = (prefix >> 2) & 0x03;
+    uint8_t tag = prefix >> 4;
+
+    if (pos + size > length) break;
+    uint32_t value = readItemData(&descriptor[pos], size);
+    pos += size;
+
+    // Usages ohne Page-Angabe erben die aktuelle Usage Page
+    uint32_t fullUsage = (size == 4) ? value : ((uint32_t)global.usagePage << 16) | value;
+
+    switch (type) {
+      case HID_TYPE_MAIN:
+        if (tag == HID_MAIN_INPUT) {
+          HidReportAccumulator* report = findReport(reports, global.reportId);
+          if (report) {
+            addInputItem(report, global, value, usages, usageCount,
+                         usageMin, usageMax, hasUsageRange);
+          }
+        }
+        // Local-Items gelten nur bis zum nächsten Main-Item
+        usageCount = 0;
+        hasUsageRange = false;
+        break;
+
+      case HID_TYPE_GLOBAL:
+        switch (tag) {
+          case HID_GLOBAL_USAGE_PAGE: global.usagePage = (uint16_t)value; break;
+          case HID_GLOBAL_LOGICAL_MIN: global.logicalMin = signExtendItem(value, size); break;
+          case HID_GLOBAL_REPORT_SIZE: global.reportSize = value; break;
+          case HID_GLOBAL_REPORT_ID: global.reportId = (uint8_t)value; break;
+          case HID_GLOBAL_REPORT_COUNT: global.reportCount = value; break;
+          case HID_GLOBAL_PUSH:
+            if (stackDepth < HID_MAX_GLOBAL_STACK) globalStack[stackDepth++] = global;
+            break;
+          case HID_GLOBAL_POP:
+            if (stackDepth > 0) global = globalStack[--stackDepth];
+            break;
+          default:
+            break;
+        }
+        break;
+
+      case HID_TYPE_LOCAL:
+        switch (tag) {
+          case HID_LOCAL_USAGE:
+            if (usageCount < HID_MAX_USAGES) usages[usageCount++] = fullUsage;
+            break;
+          case HID_LOCAL_USAGE_MIN:
+            usageMin = fullUsage;
+            hasUsageRange = true;
+            break;
+          case HID_LOCAL_USAGE_MAX:
+            usageMax = fullUsage;
+            break;
+          default:
+            break;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  // Ersten Report mit X und Y als Maus-Report wählen
+  for (int i = 0; i < HID_MAX_REPORT_IDS; i++) {
+    HidReportAccumulator& report = reports[i];
+    if (!report.used) continue;
+    if (report.fields[HID_FIELD_X].bitSize == 0 || report.fields[HID_FIELD_Y].bitSize == 0) continue;
+
+    plan.reportId = report.reportId;
+    plan.reportLength = (uint8_t)((report.bitLength + 7) / 8);
+    memcpy(plan.fields, report.fields, sizeof(plan.fields));
+
+    const HidFieldPlan& x = plan.fields[HID_FIELD_X];
+    const HidFieldPlan& y = plan.fields[HID_FIELD_Y];
+    uint32_t xEnd = x.byteOffset * 8 + x.shift + x.bitSize;
+    uint32_t yEnd = y.byteOffset * 8 + y.shift + y.bitSize;
+    plan.minLength = (uint8_t)(((xEnd > yEnd ? xEnd : yEnd) + 7) / 8);
+    return true;
+  }
+
+  return false;
+}
+
+void HidDescriptorParser::bootProtocolPlan(HidExtractionPlan& plan) {
+  memset(&plan, 0, sizeof(plan));
+  plan.reportId = 0;
+  plan.reportLength = 4;
+  plan.minLength = 3;
+  setFieldPlan(plan.fields[HID_FIELD_BUTTONS], 0, 8, false);
+  setFieldPlan(plan.fields[HID_FIELD_X], 8, 8, true);
+  setFieldPlan(plan.fields[HID_FIELD_Y], 16, 8, true);
+  setFieldPlan(plan.fields[HID_FIELD_WHEEL], 24, 8, true);
+}
+
+bool hidDecodeReport(const HidExtractionPlan& plan, const uint8_t* data, size_t length,
+                     HidMouseReport& report) {
+  if (length < plan.minLength) {
+    return false;
+  }
+
+  // Report in gepolsterten Puffer kopieren - fehlende Bytes (z.B. Wheel
+  // bei 3-Byte-Boot-Reports) lesen sich als 0
+  uint8_t buffer[HID_MAX_REPORT_SIZE + HID_DECODE_PAD];
+  memset(buffer, 0, sizeof(buffer));
+  memcpy(buffer, data, length < HID_MAX_REPORT_SIZE ? length : HID_MAX_REPORT_SIZE);
+
+  int32_t values[HID_FIELD_COUNT];
+  for (int i = 0; i < HID_FIELD_COUNT; i++) {
+    const HidFieldPlan& field = plan.fields[i];
+    uint64_t raw;
+    memcpy(&raw, &buffer[field.byteOffset], sizeof(raw));  // Little Endian
+    raw = (raw >> field.shift) & field.mask;
+    values[i] = (int32_t)((int64_t)(raw << field.signShift) >> field.signShift);
+  }
+
+  report.buttons = (uint32_t)values[HID_FIELD_BUTTONS];
+  report.dx = values[HID_FIELD_X];
+  report.dy = values[HID_FIELD_Y];
+  report.wheel = values[HID_FIELD_WHEEL];
+  report.pan = values[HID_FIELD_PAN];
+  return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * HID-Report-Deskriptor-Parser
+ * Übersetzt den Deskriptor einmal pro Verbindung in einen kompakten
+ * Extraktionsplan (Bit-Offset, Breite, Vorzeichen je Feld)
+ */
+
+#ifndef HID_DESCRIPTOR_H
+#define HID_DESCRIPTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Parser-Grenzen
+#define HID_MAX_REPORT_IDS 8
+#define HID_MAX_USAGES 16
+#define HID_MAX_GLOBAL_STACK 4
+#define HID_MAX_REPORT_SIZE 64  // Max. Report-Länge in Bytes
+#define HID_DECODE_PAD 8        // Zusätzliche Nullbytes für 64-Bit-Lesezugriffe
+
+// Felder in fester Reihenfolge (Index in HidExtractionPlan::fields)
+enum HidMouseField {
+  HID_FIELD_BUTTONS,
+  HID_FIELD_X,
+  HID_FIELD_Y,
+  HID_FIELD_WHEEL,
+  HID_FIELD_PAN,
+  HID_FIELD_COUNT
+};
+
+// Vorberechnete Extraktion eines Feldes
+struct HidFieldPlan {
+  uint8_t byteOffset;  // Erstes Byte im Report
+  uint8_t shift;       // Bit-Offset innerhalb des 64-Bit-Fensters
+  uint8_t signShift;   // 64 - Breite bei vorzeichenbehafteten Feldern, sonst 0
+  uint8_t bitSize;     // 0 = Feld nicht vorhanden
+  uint64_t mask;       // (1 << bitSize) - 1
+};
+
+// Kompilierter Plan für einen Maus-Report
+struct HidExtractionPlan {
+  uint8_t reportId;      // 0 = Deskriptor ohne Report-IDs
+  uint8_t reportLength;  // Erwartete Länge in Bytes (ohne Report-ID)
+  uint8_t minLength;     // Mindestlänge, damit X und Y enthalten sind
+  HidFieldPlan fields[HID_FIELD_COUNT];
+};
+
+// Dekodierter Maus-Report
+struct HidMouseReport {
+  uint32_t buttons;  // Bit 0=Links, Bit 1=Rechts, Bit 2=Mitte, ...
+  int32_t dx;
+  int32_t dy;
+  int32_t wheel;
+  int32_t pan;
+};
+
+class HidDescriptorParser {
+public:
+  // Deskriptor parsen - false, wenn kein Report mit X/Y gefunden wurde
+  static bool parse(const uint8_t* descriptor, size_t length, HidExtractionPlan& plan);
+
+  // Standard-Boot-Protokoll (Buttons, int8 dx, int8 dy, int8 wheel)
+  static void bootProtocolPlan(HidExtractionPlan& plan);
+};
+
+// Report anhand des Plans dekodieren (verzweigungsfreie Feldschleife)
+bool hidDecodeReport(const HidExtractionPlan& plan, const uint8_t* data, size_t length,
+                     HidMouseReport& report);
+
+#endif
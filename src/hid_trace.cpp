@@ -0,0 +1,312 @@
+/**
+ * HID-Trace Implementierung
+ */
+
+#include "hid_trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef ARDUINO
+  #include <esp32-hal-psram.h>
+#endif
+
+// ========== Varint (LEB128) ==========
+
+static size_t encodeVarint(uint32_t value, uint8_t* out) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+  return n;
+}
+
+static void writeLE32(uint8_t* out, uint32_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+// ========== HidTraceRecorder ==========
+
+HidTraceRecorder::HidTraceRecorder() {
+  buffer = nullptr;
+  capacity = 0;
+  clear();
+}
+
+HidTraceRecorder::~HidTraceRecorder() {
+  free(buffer);
+}
+
+bool HidTraceRecorder::begin(size_t bufferSize) {
+  if (buffer != nullptr) {
+    return true;
+  }
+
+#ifdef ARDUINO
+  if (psramFound()) {
+    buffer = (uint8_t*)ps_malloc(bufferSize);
+  } else {
+    bufferSize = HID_TRACE_FALLBACK_SIZE;
+    buffer = (uint8_t*)malloc(bufferSize);
+  }
+#else
+  buffer = (uint8_t*)malloc(bufferSize);
+#endif
+
+  if (buffer == nullptr) {
+    return false;
+  }
+
+  capacity = bufferSize;
+  clear();
+  return true;
+}
+
+void HidTraceRecorder::clear() {
+  head = 0;
+  tail = 0;
+  used = 0;
+  recordCount = 0;
+  droppedCount = 0;
+  firstTimestampUs = 0;
+  lastTimestampUs = 0;
+}
+
+void HidTraceRecorder::writeBytes(const uint8_t* data, size_t length) {
+  size_t first = std::min(length, capacity - head);
+  memcpy(&buffer[head], data, first);
+  memcpy(&buffer[0], data + first, length - first);
+  head = (head + length) % capacity;
+  used += length;
+}
+
+size_t HidTraceRecorder::peekRecordSize(size_t position, uint32_t* deltaUs) const {
+  uint32_t delta = 0;
+  size_t n = 0;
+  uint8_t byte;
+
+  do {
+    byte = buffer[(position + n) % capacity];
+    delta |= (uint32_t)(byte & 0x7F) << (7 * n);
+    n++;
+  } while ((byte & 0x80) && n < 5);
+
+  if (deltaUs) {
+    *deltaUs = delta;
+  }
+
+  // Quelle, Report-ID, Länge, Daten
+  uint8_t length = buffer[(position + n + 2) % capacity];
+  return n + 3 + length;
+}
+
+void HidTraceRecorder::evictOldest() {
+  size_t size = peekRecordSize(tail, nullptr);
+  tail = (tail + size) % capacity;
+  used -= size;
+  recordCount--;
+  droppedCount++;
+
+  // Der nächste Record wird zum ältesten - sein Delta verschiebt den Startzeitpunkt
+  if (recordCount > 0) {
+    uint32_t delta;
+    peekRecordSize(tail, &delta);
+    firstTimestampUs += delta;
+  }
+}
+
+bool HidTraceRecorder::record(uint32_t timestampUs, uint8_t source, uint8_t reportId,
+                              const uint8_t* data, size_t length) {
+  if (buffer == nullptr || length > HID_TRACE_MAX_REPORT) {
+    return false;
+  }
+
+  uint8_t encoded[HID_TRACE_MAX_RECORD];
+  size_t n = encodeVarint(recordCount ? timestampUs - lastTimestampUs : 0, encoded);
+  encoded[n++] = source;
+  encoded[n++] = reportId;
+  encoded[n++] = (uint8_t)length;
+  memcpy(&encoded[n], data, length);
+  n += length;
+
+  if (n > capacity) {
+    return false;
+  }
+
+  while (capacity - used < n) {
+    evictOldest();
+  }
+
+  if (recordCount == 0) {
+    firstTimestampUs = timestampUs;
+  }
+
+  writeBytes(encoded, n);
+  lastTimestampUs = timestampUs;
+  recordCount++;
+  return true;
+}
+
+const uint8_t* HidTraceRecorder::linearize(size_t& length) {
+  length = used;
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+
+  if (tail != 0) {
+    std::rotate(buffer, buffer + tail, buffer + capacity);
+    tail = 0;
+    head = used % capacity;
+  }
+  return buffer;
+}
+
+size_t HidTraceRecorder::readStream(size_t offset, uint8_t* out, size_t maxLength) const {
+  size_t total = getStreamSize();
+  if (offset >= total) {
+    return 0;
+  }
+
+  size_t count = std::min(maxLength, total - offset);
+  size_t written = 0;
+
+  // Header
+  if (offset < HID_TRACE_HEADER_SIZE) {
+    uint8_t header[HID_TRACE_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, HID_TRACE_MAGIC, 4);
+    header[4] = HID_TRACE_VERSION;
+    writeLE32(&header[8], firstTimestampUs);
+    writeLE32(&header[12], recordCount);
+
+    size_t n = std::min(count, HID_TRACE_HEADER_SIZE - offset);
+    memcpy(out, &header[offset], n);
+    written += n;
+  }
+
+  // Records ab dem ältesten
+  while (written < count) {
+    size_t recordOffset = offset + written - HID_TRACE_HEADER_SIZE;
+    size_t position = (tail + recordOffset) % capacity;
+    size_t n = std::min(count - written, capacity - position);
+    memcpy(&out[written], &buffer[position], n);
+    written += n;
+  }
+
+  return written;
+}
+
+// ========== HidTracePlayer ==========
+
+HidTracePlayer::HidTracePlayer() {
+  records = nullptr;
+  length = 0;
+  position = 0;
+  traceTimeUs = 0;
+  startUs = 0;
+  speedPercent = HID_TRACE_SPEED_ORIGINAL;
+  firstRecord = true;
+  active = false;
+  playedCount = 0;
+}
+
+void HidTracePlayer::begin(const uint8_t* traceRecords, size_t traceLength, uint32_t nowUs,
+                           uint16_t speed) {
+  records = traceRecords;
+  length = traceLength;
+  position = 0;
+  traceTimeUs = 0;
+  startUs = nowUs;
+  speedPercent = speed;
+  firstRecord = true;
+  playedCount = 0;
+  active = records != nullptr && length > 0;
+}
+
+bool HidTracePlayer::beginStream(const uint8_t* stream, size_t streamLength, uint32_t nowUs,
+                                 uint16_t speed) {
+  if (streamLength < HID_TRACE_HEADER_SIZE ||
+      memcmp(stream, HID_TRACE_MAGIC, 4) != 0 ||
+      stream[4] != HID_TRACE_VERSION) {
+    return false;
+  }
+
+  begin(stream + HID_TRACE_HEADER_SIZE, streamLength - HID_TRACE_HEADER_SIZE, nowUs, speed);
+  return true;
+}
+
+void HidTracePlayer::stop() {
+  active = false;
+}
+
+bool HidTracePlayer::decodeNext(HidTraceRecord& record, uint32_t& deltaUs,
+                                size_t& nextPosition) const {
+  size_t pos = position;
+  uint32_t delta = 0;
+  int shift = 0;
+
+  while (pos < length) {
+    uint8_t byte = records[pos++];
+    delta |= (uint32_t)(byte & 0x7F) << shift;
+    shift += 7;
+    if (!(byte & 0x80) || shift >= 35) break;
+  }
+
+  if (pos + 3 > length) {
+    return false;
+  }
+
+  record.source = records[pos];
+  record.reportId = records[pos + 1];
+  record.length = records[pos + 2];
+  pos += 3;
+
+  if (record.length > HID_TRACE_MAX_REPORT || pos + record.length > length) {
+    return false;  // Abgeschnittener oder defekter Trace
+  }
+
+  memcpy(record.data, &records[pos], record.length);
+  deltaUs = delta;
+  nextPosition = pos + record.length;
+  return true;
+}
+
+bool HidTracePlayer::next(uint32_t nowUs, HidTraceRecord& record) {
+  if (!active) {
+    return false;
+  }
+
+  uint32_t deltaUs;
+  size_t nextPosition;
+  if (!decodeNext(record, deltaUs, nextPosition)) {
+    active = false;
+    return false;
+  }
+
+  uint32_t recordTimeUs = firstRecord ? 0 : traceTimeUs + deltaUs;
+
+  // Zeitpunkt auf der Wiedergabe-Zeitachse
+  uint32_t scheduledUs = nowUs;
+  if (speedPercent != HID_TRACE_SPEED_MAX) {
+    scheduledUs = startUs + (uint32_t)((uint64_t)recordTimeUs * 100 / speedPercent);
+    if ((int32_t)(nowUs - scheduledUs) < 0) {
+      return false;  // Noch nicht fällig
+    }
+  }
+
+  record.timestampUs = scheduledUs;
+  traceTimeUs = recordTimeUs;
+  position = nextPosition;
+  firstRecord = false;
+  playedCount++;
+
+  if (position >= length) {
+    active = false;
+  }
+  return true;
+}
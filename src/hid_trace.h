@@ -0,0 +1,117 @@
+/**
+ * HID-Trace: Aufzeichnung und deterministische Wiedergabe roher Reports
+ * Ohne Arduino-Abhängigkeiten, damit Traces auch auf dem Host laufen
+ *
+ * Stream-Format (Little Endian):
+ *   Header:  "HIDT", Version (1), 3 Byte reserviert,
+ *            uint32 Zeitstempel des ersten Reports (µs), uint32 Anzahl Reports
+ *   Record:  Varint Delta-µs zum vorherigen Report (beim ersten ignoriert),
+ *            uint8 Quelle, uint8 Report-ID, uint8 Länge, Report-Bytes
+ */
+
+#ifndef HID_TRACE_H
+#define HID_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HID_TRACE_MAGIC "HIDT"
+#define HID_TRACE_VERSION 1
+#define HID_TRACE_HEADER_SIZE 16
+#define HID_TRACE_MAX_REPORT 64
+#define HID_TRACE_MAX_RECORD (5 + 3 + HID_TRACE_MAX_REPORT)
+
+#define HID_TRACE_PSRAM_SIZE (256 * 1024)   // Ringpuffer im PSRAM
+#define HID_TRACE_FALLBACK_SIZE (16 * 1024) // Ohne PSRAM
+
+// Wiedergabe-Geschwindigkeit
+#define HID_TRACE_SPEED_ORIGINAL 100  // Prozent
+#define HID_TRACE_SPEED_MAX 0         // So schnell wie möglich
+
+struct HidTraceRecord {
+  uint32_t timestampUs;  // Originaler (bzw. skalierter) Zeitstempel
+  uint8_t source;
+  uint8_t reportId;
+  uint8_t length;
+  uint8_t data[HID_TRACE_MAX_REPORT];
+};
+
+class HidTraceRecorder {
+private:
+  uint8_t* buffer;
+  size_t capacity;
+  size_t head;  // Schreibposition
+  size_t tail;  // Ältester Record
+  size_t used;
+  uint32_t recordCount;
+  uint32_t droppedCount;      // Wegen Platzmangel verdrängte Records
+  uint32_t firstTimestampUs;  // Zeitstempel des ältesten Records
+  uint32_t lastTimestampUs;
+
+  void writeBytes(const uint8_t* data, size_t length);
+  size_t peekRecordSize(size_t position, uint32_t* deltaUs) const;
+  void evictOldest();
+
+public:
+  HidTraceRecorder();
+  ~HidTraceRecorder();
+
+  // Puffer anlegen (PSRAM bevorzugt) - mehrfacher Aufruf ist unkritisch
+  bool begin(size_t bufferSize = HID_TRACE_PSRAM_SIZE);
+  void clear();
+
+  // Report anhängen, verdrängt bei Bedarf die ältesten Records
+  bool record(uint32_t timestampUs, uint8_t source, uint8_t reportId,
+              const uint8_t* data, size_t length);
+
+  // Ring so umsortieren, dass die Records ab buffer[0] zusammenhängend liegen
+  const uint8_t* linearize(size_t& length);
+
+  // Export als Stream (Header + Records), in beliebigen Stücken lesbar.
+  // Während des Exports nicht aufzeichnen.
+  size_t getStreamSize() const { return HID_TRACE_HEADER_SIZE + used; }
+  size_t readStream(size_t offset, uint8_t* out, size_t maxLength) const;
+
+  uint32_t getRecordCount() const { return recordCount; }
+  uint32_t getDroppedCount() const { return droppedCount; }
+  uint32_t getFirstTimestamp() const { return firstTimestampUs; }
+  size_t getCapacity() const { return capacity; }
+  size_t getUsed() const { return used; }
+};
+
+class HidTracePlayer {
+private:
+  const uint8_t* records;
+  size_t length;
+  size_t position;
+  uint32_t traceTimeUs;    // Trace-Zeit des nächsten Records relativ zum ersten
+  uint32_t startUs;        // Wiedergabebeginn (Wanduhr)
+  uint16_t speedPercent;
+  bool firstRecord;
+  bool active;
+  uint32_t playedCount;
+
+  bool decodeNext(HidTraceRecord& record, uint32_t& deltaUs, size_t& nextPosition) const;
+
+public:
+  HidTracePlayer();
+
+  // Records (ohne Header) wiedergeben, z.B. aus HidTraceRecorder::linearize()
+  void begin(const uint8_t* records, size_t length, uint32_t nowUs,
+             uint16_t speedPercent = HID_TRACE_SPEED_ORIGINAL);
+
+  // Kompletten Stream mit Header wiedergeben (z.B. heruntergeladene Datei)
+  bool beginStream(const uint8_t* stream, size_t length, uint32_t nowUs,
+                   uint16_t speedPercent = HID_TRACE_SPEED_ORIGINAL);
+
+  void stop();
+
+  // Nächsten fälligen Record liefern. Der Zeitstempel wird auf die
+  // Wiedergabe-Zeitachse (ab nowUs bei begin()) umgerechnet.
+  bool next(uint32_t nowUs, HidTraceRecord& record);
+
+  bool isActive() const { return active; }
+  uint32_t getPlayedCount() const { return playedCount; }
+};
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * Latenz-Messung Implementierung
+ */
+
+#include "latency_stats.h"
+
+// ========== LatencyHistogram ==========
+
+LatencyHistogram::LatencyHistogram() {
+  reset();
+}
+
+void LatencyHistogram::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  count = 0;
+  maxValue = 0;
+  sum = 0;
+}
+
+int LatencyHistogram::bucketIndex(uint32_t valueUs) {
+  const uint32_t subBuckets = 1 << LATENCY_SUB_BUCKETS_LOG2;
+
+  // Kleine Werte linear
+  if (valueUs < subBuckets) {
+    return valueUs;
+  }
+
+  // Oktave + die nächsten LATENCY_SUB_BUCKETS_LOG2 Bits
+  int octave = 31 - __builtin_clz(valueUs);
+  int sub = (valueUs >> (octave - LATENCY_SUB_BUCKETS_LOG2)) & (subBuckets - 1);
+  int index = (octave - LATENCY_SUB_BUCKETS_LOG2 + 1) * subBuckets + sub;
+
+  return index < LATENCY_BUCKETS ? index : LATENCY_BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(int index) {
+  const int subBuckets = 1 << LATENCY_SUB_BUCKETS_LOG2;
+
+  if (index < subBuckets) {
+    return index;
+  }
+
+  int octave = index / subBuckets + LATENCY_SUB_BUCKETS_LOG2 - 1;
+  int sub = index % subBuckets;
+  uint64_t lower = ((uint64_t)(subBuckets + sub)) << (octave - LATENCY_SUB_BUCKETS_LOG2);
+  uint64_t width = 1ULL << (octave - LATENCY_SUB_BUCKETS_LOG2);
+  uint64_t upper = lower + width - 1;
+  return upper > 0xFFFFFFFFULL ? 0xFFFFFFFF : (uint32_t)upper;
+}
+
+void LatencyHistogram::record(uint32_t valueUs) {
+  buckets[bucketIndex(valueUs)]++;
+  count++;
+  sum += valueUs;
+  if (valueUs > maxValue) {
+    maxValue = valueUs;
+  }
+}
+
+uint32_t LatencyHistogram::getMean() const {
+  return count ? (uint32_t)(sum / count) : 0;
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percentile) const {
+  if (count == 0) return 0;
+
+  // Rang des gesuchten Werts (aufgerundet)
+  uint32_t rank = ((uint64_t)count * percentile + 99) / 100;
+  if (rank == 0) rank = 1;
+
+  uint32_t seen = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      uint32_t upper = bucketUpperBound(i);
+      return upper < maxValue ? upper : maxValue;
+    }
+  }
+  return maxValue;
+}
+
+// ========== LatencyMonitor ==========
+
+LatencyMonitor::LatencyMonitor() {
+  lock = portMUX_INITIALIZER_UNLOCKED;
+  lastIngressUs = 0;
+}
+
+void LatencyMonitor::recordFrame(uint32_t ingressUs, uint32_t updateUs,
+                                 uint32_t renderStartUs, uint32_t flushDoneUs) {
+  // Nur Frames mit neuem Report zählen
+  if (ingressUs == 0 || ingressUs == lastIngressUs) {
+    return;
+  }
+  lastIngressUs = ingressUs;
+
+  portENTER_CRITICAL(&lock);
+  histograms[LATENCY_QUEUE].record(updateUs - ingressUs);
+  histograms[LATENCY_WAIT].record(renderStartUs - updateUs);
+  histograms[LATENCY_RENDER].record(flushDoneUs - renderStartUs);
+  histograms[LATENCY_TOTAL].record(flushDoneUs - ingressUs);
+  portEXIT_CRITICAL(&lock);
+}
+
+void LatencyMonitor::snapshot(LatencyHistogram* out) {
+  portENTER_CRITICAL(&lock);
+  for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    out[i] = histograms[i];
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void LatencyMonitor::reset() {
+  portENTER_CRITICAL(&lock);
+  for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    histograms[i].reset();
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+const char* LatencyMonitor::stageName(LatencyStage stage) {
+  switch (stage) {
+    case LATENCY_QUEUE: return "queue";
+    case LATENCY_WAIT: return "wait";
+    case LATENCY_RENDER: return "render";
+    case LATENCY_TOTAL: return "total";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,65 @@
+/**
+ * Latenz-Messung Eingang -> Pixel
+ * Histogramme mit festen Buckets (4 Stufen je Zweierpotenz) im RAM
+ */
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <Arduino.h>
+
+#define LATENCY_BUCKETS 96          // Deckt 0 µs bis ~16 s ab
+#define LATENCY_SUB_BUCKETS_LOG2 2  // 4 Unter-Buckets je Oktave
+
+// Messstrecken
+enum LatencyStage {
+  LATENCY_QUEUE,   // HID-Callback -> update()
+  LATENCY_WAIT,    // update() -> Render-Start
+  LATENCY_RENDER,  // Render-Start -> SPI-Flush fertig
+  LATENCY_TOTAL,   // HID-Callback -> SPI-Flush fertig
+  LATENCY_STAGE_COUNT
+};
+
+class LatencyHistogram {
+private:
+  uint32_t buckets[LATENCY_BUCKETS];
+  uint32_t count;
+  uint32_t maxValue;
+  uint64_t sum;
+
+  static int bucketIndex(uint32_t valueUs);
+  static uint32_t bucketUpperBound(int index);
+
+public:
+  LatencyHistogram();
+
+  void reset();
+  void record(uint32_t valueUs);
+
+  uint32_t getCount() const { return count; }
+  uint32_t getMax() const { return maxValue; }
+  uint32_t getMean() const;
+  uint32_t getPercentile(uint8_t percentile) const;  // Obergrenze des Buckets
+};
+
+class LatencyMonitor {
+private:
+  LatencyHistogram histograms[LATENCY_STAGE_COUNT];
+  portMUX_TYPE lock;
+  uint32_t lastIngressUs;  // Zuletzt gemessener Report (keine Doppelzählung)
+
+public:
+  LatencyMonitor();
+
+  // Nach dem Flush eines Frames mit den Zeitstempeln seines neuesten Reports
+  void recordFrame(uint32_t ingressUs, uint32_t updateUs,
+                   uint32_t renderStartUs, uint32_t flushDoneUs);
+
+  // Kopie für den Web-Task
+  void snapshot(LatencyHistogram* out);
+  void reset();
+
+  static const char* stageName(LatencyStage stage);
+};
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Loop-Scheduler Implementierung
+ */
+
+#include "loop_scheduler.h"
+#include <string.h>
+
+LoopScheduler::LoopScheduler(LoopClock clockSource) {
+  clock = clockSource;
+  memset(intervalUs, 0, sizeof(intervalUs));
+  memset(lastRunUs, 0, sizeof(lastRunUs));
+  memset(taskStartUs, 0, sizeof(taskStartUs));
+  memset(stats, 0, sizeof(stats));
+  statsStartUs = 0;
+  idleUs = 0;
+}
+
+void LoopScheduler::setInterval(LoopTask task, uint32_t intervalMs) {
+  intervalUs[task] = intervalMs * 1000;
+}
+
+void LoopScheduler::start() {
+  uint32_t now = clock();
+  for (int i = 0; i < TASK_COUNT; i++) {
+    lastRunUs[i] = now;
+  }
+  resetStats();
+}
+
+bool LoopScheduler::isDue(LoopTask task) {
+  if (intervalUs[task] == 0) {
+    return false;
+  }
+
+  uint32_t now = clock();
+  if (now - lastRunUs[task] < intervalUs[task]) {
+    return false;
+  }
+
+  lastRunUs[task] = now;
+  return true;
+}
+
+void LoopScheduler::beginTask(LoopTask task) {
+  taskStartUs[task] = clock();
+}
+
+void LoopScheduler::endTask(LoopTask task) {
+  uint32_t duration = clock() - taskStartUs[task];
+  LoopTaskStats& s = stats[task];
+
+  s.runs++;
+  s.lastUs = duration;
+  s.totalUs += duration;
+  if (duration > s.maxUs) {
+    s.maxUs = duration;
+  }
+}
+
+uint32_t LoopScheduler::timeUntilNextTask() {
+  uint32_t now = clock();
+  uint32_t next = UINT32_MAX;
+
+  for (int i = 0; i < TASK_COUNT; i++) {
+    if (intervalUs[i] == 0) {
+      continue;
+    }
+    uint32_t elapsed = now - lastRunUs[i];
+    uint32_t remaining = elapsed >= intervalUs[i] ? 0 : intervalUs[i] - elapsed;
+    if (remaining < next) {
+      next = remaining;
+    }
+  }
+  return next;
+}
+
+void LoopScheduler::resetStats() {
+  memset(stats, 0, sizeof(stats));
+  idleUs = 0;
+  statsStartUs = clock();
+}
+
+const char* LoopScheduler::taskName(LoopTask task) {
+  switch (task) {
+    case TASK_MOUSE: return "mouse";
+    case TASK_DISPLAY: return "display";
+    case TASK_NETWORK: return "network";
+    case TASK_MIRROR: return "mirror";
+    case TASK_TELEMETRY: return "telemetry";
+    case TASK_OTA: return "ota";
+    case TASK_DISCOVERY: return "discovery";
+    default: return "unknown";
+  }
+}
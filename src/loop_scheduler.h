@@ -0,0 +1,74 @@
+/**
+ * Loop-Scheduler für die periodischen Aufgaben in loop()
+ * Ohne Arduino-Abhängigkeiten: die Zeitquelle wird übergeben, damit der
+ * Ablauf auch mit einer virtuellen Uhr (schneller als Echtzeit) läuft
+ */
+
+#ifndef LOOP_SCHEDULER_H
+#define LOOP_SCHEDULER_H
+
+#include <stdint.h>
+
+// Periodische Aufgaben in loop()
+enum LoopTask {
+  TASK_MOUSE,
+  TASK_DISPLAY,
+  TASK_NETWORK,
+  TASK_MIRROR,
+  TASK_TELEMETRY,
+  TASK_OTA,
+  TASK_DISCOVERY,
+  TASK_COUNT
+};
+
+// Laufzeit-Statistik je Aufgabe
+struct LoopTaskStats {
+  uint32_t runs;
+  uint32_t lastUs;   // Dauer des letzten Laufs
+  uint32_t maxUs;
+  uint64_t totalUs;
+};
+
+// Zeitquelle in Mikrosekunden (z.B. micros() oder virtuelle Uhr)
+typedef uint32_t (*LoopClock)();
+
+class LoopScheduler {
+private:
+  LoopClock clock;
+  uint32_t intervalUs[TASK_COUNT];
+  uint32_t lastRunUs[TASK_COUNT];
+  uint32_t taskStartUs[TASK_COUNT];
+  LoopTaskStats stats[TASK_COUNT];
+  uint32_t statsStartUs;
+  uint64_t idleUs;
+
+public:
+  explicit LoopScheduler(LoopClock clock);
+
+  // Intervall 0: Aufgabe läuft ereignisgesteuert (nie fällig, nur Laufzeitmessung)
+  void setInterval(LoopTask task, uint32_t intervalMs);
+  void start();
+
+  // true, wenn die Aufgabe fällig ist (merkt sich den Startzeitpunkt)
+  bool isDue(LoopTask task);
+
+  // Laufzeit einer Aufgabe messen
+  void beginTask(LoopTask task);
+  void endTask(LoopTask task);
+
+  // Mikrosekunden bis zur nächsten fälligen Aufgabe
+  uint32_t timeUntilNextTask();
+
+  // Zeit, die loop() schlafend verbracht hat (für die Leerlauf-Quote)
+  void addIdleTime(uint32_t us) { idleUs += us; }
+  uint64_t getIdleUs() const { return idleUs; }
+
+  uint32_t now() const { return clock(); }
+  LoopTaskStats getStats(LoopTask task) const { return stats[task]; }
+  uint32_t getStatsWindowUs() const { return clock() - statsStartUs; }
+  void resetStats();
+
+  static const char* taskName(LoopTask task);
+};
+
+#endif
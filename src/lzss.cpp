@@ -0,0 +1,82 @@
+/**
+ * LZSS-Dekompression Implementierung
+ */
+
+#include "lzss.h"
+#include <string.h>
+
+LzssDecoder::LzssDecoder() {
+  reset();
+}
+
+void LzssDecoder::reset() {
+  memset(window, 0, sizeof(window));
+  windowPos = 0;
+  outputLength = 0;
+  flags = 0;
+  flagsLeft = 0;
+  matchLow = -1;
+  totalOut = 0;
+  failed = false;
+}
+
+bool LzssDecoder::emit(uint8_t value, OtaSink& sink) {
+  window[windowPos] = value;
+  windowPos = (windowPos + 1) & (LZSS_WINDOW_SIZE - 1);
+  output[outputLength++] = value;
+  totalOut++;
+
+  if (outputLength == LZSS_OUTPUT_CHUNK) {
+    outputLength = 0;
+    return sink.write(output, LZSS_OUTPUT_CHUNK);
+  }
+  return true;
+}
+
+bool LzssDecoder::feed(const uint8_t* data, size_t length, OtaSink& sink) {
+  for (size_t i = 0; i < length && !failed; i++) {
+    uint8_t value = data[i];
+
+    if (flagsLeft == 0) {
+      flags = value;
+      flagsLeft = 8;
+      continue;
+    }
+
+    if (flags & 1) {
+      // Literal
+      failed = !emit(value, sink);
+    } else if (matchLow < 0) {
+      matchLow = value;
+      continue;  // Zweites Byte des Verweises abwarten
+    } else {
+      uint16_t distance = (((value >> 4) << 8) | matchLow) + 1;
+      uint8_t count = (value & 0x0F) + LZSS_MIN_MATCH;
+      matchLow = -1;
+
+      if (distance > totalOut) {
+        failed = true;  // Verweis vor den Anfang des Stroms
+        break;
+      }
+      for (uint8_t k = 0; k < count && !failed; k++) {
+        failed = !emit(window[(windowPos - distance) & (LZSS_WINDOW_SIZE - 1)], sink);
+      }
+    }
+
+    flags >>= 1;
+    flagsLeft--;
+  }
+  return !failed;
+}
+
+bool LzssDecoder::flush(OtaSink& sink) {
+  if (failed || matchLow >= 0) {
+    return false;  // Strom endet mitten in einem Verweis
+  }
+  if (outputLength > 0) {
+    size_t length = outputLength;
+    outputLength = 0;
+    return sink.write(output, length);
+  }
+  return true;
+}
@@ -0,0 +1,58 @@
+/**
+ * LZSS-Dekompression für komprimierte OTA-Images (tools/ota_compress.py)
+ *
+ * Strom: Flag-Byte (LSB zuerst) für je 8 Einträge; Bit 1 = Literal (1 Byte),
+ * Bit 0 = Verweis (2 Bytes): Abstand-1 in 12 Bit, Länge-3 in 4 Bit
+ *   Byte 0 = Abstand[7:0], Byte 1 = Abstand[11:8] << 4 | (Länge - 3)
+ * 4-KB-Fenster, Ausgabe in festen Blöcken - der Eingang darf in beliebig
+ * kleinen Stücken kommen. Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef LZSS_H
+#define LZSS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LZSS_WINDOW_SIZE 4096
+#define LZSS_MIN_MATCH 3
+#define LZSS_MAX_MATCH 18
+#define LZSS_OUTPUT_CHUNK 1024
+
+// Empfänger der entpackten Daten (z.B. Flash-Schreiber)
+class OtaSink {
+public:
+  virtual ~OtaSink() {}
+  virtual bool write(const uint8_t* data, size_t length) = 0;
+};
+
+class LzssDecoder {
+private:
+  uint8_t window[LZSS_WINDOW_SIZE];
+  uint16_t windowPos;
+  uint8_t output[LZSS_OUTPUT_CHUNK];
+  size_t outputLength;
+
+  uint8_t flags;
+  uint8_t flagsLeft;    // Noch offene Einträge des aktuellen Flag-Bytes
+  int16_t matchLow;     // Erstes Byte eines Verweises (-1 = keins)
+  uint32_t totalOut;
+  bool failed;
+
+  bool emit(uint8_t value, OtaSink& sink);
+
+public:
+  LzssDecoder();
+
+  void reset();
+
+  // Eingang verarbeiten; false, wenn der Empfänger oder der Strom fehlerhaft ist
+  bool feed(const uint8_t* data, size_t length, OtaSink& sink);
+
+  // Restliche Ausgabe schreiben (am Ende des Stroms)
+  bool flush(OtaSink& sink);
+
+  uint32_t getOutputSize() const { return totalOut; }
+};
+
+#endif
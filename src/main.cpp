@@ -18,6 +18,11 @@
 #include "mouse_handler.h"
 #include "webserver.h"
 #include "network.h"
+#include "latency_stats.h"
+#include "loop_scheduler.h"
+#include "frame_pacer.h"
+#include "frame_governor.h"
+#include "screen_mirror.h"
 
 // ========== Globale Variablen ==========
 
@@ -25,15 +30,61 @@ DisplayManager displayManager;
 MouseHandler mouseHandler;
 WebServerManager webServer;
 NetworkManager networkManager;
+LatencyMonitor latencyMonitor;
+
+// Zeitquelle für den Scheduler (auf dem Host durch virtuelle Uhr ersetzbar)
+static uint32_t loopClock() {
+  return micros();
+}
 
 // Timing für verschiedene Tasks
-unsigned long lastDisplayUpdate = 0;
-unsigned long lastMousePoll = 0;
-unsigned long lastNetworkCheck = 0;
+LoopScheduler scheduler(loopClock);
+
+// Display rendert nur nach Änderungen (max. DISPLAY_MAX_FPS)
+FramePacer framePacer(loopClock);
+bool displayIdle = false;
+
+// Senkt die Darstellungsqualität, wenn Frames ihr Zeitbudget überschreiten
+FrameGovernor frameGovernor;
+
+// Übertragene Display-Bereiche für die Web-Spiegelung
+ScreenMirror screenMirror(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+// Von MouseHandler per Task-Benachrichtigung gesetzt (neue Reports)
+bool inputSignaled = false;
+
+// Web-OTA läuft im Webserver-Task - Anzeige nur aus loop()
+bool otaDisplayed = false;
+int otaLastPercentage = -1;
+
+// Takt der Live-Telemetrie (schnellster verbundener Client, 0 = keiner)
+uint32_t telemetryInterval = 0;
+
+// Lese-Cursor für die Tasten-Flanken des MouseHandlers
+uint32_t buttonEventCursor = 0;
+
+// Framebuffer-Modus: Zeitstempel des Frames, dessen DMA-Flush noch läuft
+struct PendingFrame {
+  bool pending;
+  uint32_t ingressUs;
+  uint32_t updateUs;
+  uint32_t renderStartUs;
+};
+PendingFrame pendingFrame = {false, 0, 0, 0};
 
-const unsigned long DISPLAY_UPDATE_INTERVAL = 16;  // ~60 FPS
 const unsigned long MOUSE_POLL_INTERVAL = 10;      // 100 Hz Maus-Polling
-const unsigned long NETWORK_CHECK_INTERVAL = 5000; // 5 Sekunden
+const unsigned long MOUSE_IDLE_POLL_INTERVAL = 50; // Leerlauf (Reports wecken sofort)
+const unsigned long NETWORK_CHECK_INTERVAL = 250;  // Backoff-Auflösung (update() blockiert nicht)
+const unsigned long MIRROR_INTERVAL = 50;          // 20 Hz Bildschirm-Spiegelung
+const unsigned long OTA_PROGRESS_INTERVAL = 250;   // Max. 4 Hz OTA-Anzeige
+const unsigned long DISCOVERY_INTERVAL = 250;      // BT-Funde gesammelt streamen
+
+// ========== Vorwärtsdeklarationen ==========
+
+void handleButtonEvent(const ButtonEvent& event);
+void onOTAStart();
+void onOTAProgress(unsigned int progress, unsigned int total);
+void onOTAEnd();
 
 // ========== Setup-Funktion ==========
 
@@ -51,6 +102,7 @@ void setup() {
 
   // 1. Display initialisieren (erstes visuelles Feedback)
   Serial.println("[SETUP] Initialisiere Display...");
+  displayManager.setScreenMirror(&screenMirror);
   if (displayManager.begin()) {
     Serial.println("[OK] Display bereit");
     displayManager.showBootScreen("Starte System...");
@@ -74,6 +126,12 @@ void setup() {
   // 3. Webserver starten
   Serial.println("[SETUP] Initialisiere Webserver...");
   displayManager.showBootScreen("Starte Webserver...");
+  webServer.setLatencyMonitor(&latencyMonitor);
+  webServer.setLoopScheduler(&scheduler);
+  webServer.setDisplayManager(&displayManager);
+  webServer.setFramePacer(&framePacer);
+  webServer.setFrameGovernor(&frameGovernor);
+  webServer.setScreenMirror(&screenMirror);
   if (webServer.begin(&mouseHandler, &networkManager)) {
     Serial.println("[OK] Webserver bereit");
     Serial.printf("[INFO] Webinterface: http://%s\n", 
@@ -86,8 +144,10 @@ void setup() {
   // 4. Maus-Handler initialisieren
   Serial.println("[SETUP] Initialisiere Maus-Handler...");
   displayManager.showBootScreen("Suche Maus...");
+  mouseHandler.setInputNotifyTask(xTaskGetCurrentTaskHandle());
   if (mouseHandler.begin()) {
     Serial.println("[OK] Maus-Handler bereit");
+    buttonEventCursor = mouseHandler.getButtonEventSeq();
   } else {
     Serial.println("[ERROR] Maus-Handler-Initialisierung fehlgeschlagen!");
   }
@@ -111,20 +171,28 @@ void setup() {
   );
 
   // Initialen Status aktualisieren
-  lastDisplayUpdate = millis();
-  lastMousePoll = millis();
-  lastNetworkCheck = millis();
+  scheduler.setInterval(TASK_MOUSE, MOUSE_POLL_INTERVAL);
+  scheduler.setInterval(TASK_DISPLAY, 0);  // Ereignisgesteuert über framePacer
+  scheduler.setInterval(TASK_NETWORK, NETWORK_CHECK_INTERVAL);
+  scheduler.setInterval(TASK_MIRROR, MIRROR_INTERVAL);
+  scheduler.setInterval(TASK_OTA, OTA_PROGRESS_INTERVAL);
+  scheduler.setInterval(TASK_DISCOVERY, DISCOVERY_INTERVAL);
+  scheduler.start();
+  framePacer.start();
+  frameGovernor.setBudget(FRAME_BUDGET_US, getCpuFrequencyMhz());
 }
 
 // ========== Loop-Funktion ==========
 
 void loop() {
-  unsigned long currentMillis = millis();
-
+  // Zyklenzähler: Arbeit dieses Durchlaufs bis zum fertigen Frame
+  uint32_t passStartCycles = ESP.getCycleCount();
+  
   // ========== Maus-Polling ==========
-  // Hohe Frequenz (100 Hz) für flüssige Mausbewegung
-  if (currentMillis - lastMousePoll >= MOUSE_POLL_INTERVAL) {
-    lastMousePoll = currentMillis;
+  // Hohe Frequenz (100 Hz) für flüssige Mausbewegung, neue Reports sofort
+  if (scheduler.isDue(TASK_MOUSE) || inputSignaled) {
+    inputSignaled = false;
+    scheduler.beginTask(TASK_MOUSE);
     
     mouseHandler.update();
     
@@ -148,105 +216,200 @@ void loop() {
         );
       }
     }
+    
+    scheduler.endTask(TASK_MOUSE);
   }
 
   // ========== Display-Update ==========
-  // 60 FPS für flüssige Animationen
-  if (currentMillis - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL) {
-    lastDisplayUpdate = currentMillis;
+  // Szene aktualisieren (nur Zustand), gerendert wird nur nach Änderungen
+  if (mouseHandler.isMouseConnected()) {
+    // Maus-Daten abrufen
+    MouseData mouseData = mouseHandler.getMouseData();
     
-    if (mouseHandler.isMouseConnected()) {
-      // Maus-Daten abrufen
-      MouseData mouseData = mouseHandler.getMouseData();
-      
-      // Cursor zeichnen (mit geschwindigkeitsbasierter Helligkeit)
-      displayManager.drawCursor(
-        mouseData.x, 
-        mouseData.y, 
-        mouseData.speed
-      );
-      
-      // Klick-Animationen zeichnen
-      if (mouseData.leftButton && mouseData.rightButton) {
-        // Beide Tasten: Kombination
-        displayManager.drawClickAnimation(
-          mouseData.x, 
-          mouseData.y, 
-          CLICK_BOTH
-        );
-      } else if (mouseData.leftButton) {
-        // Linksklick: Konzentrische Kreise
-        displayManager.drawClickAnimation(
-          mouseData.x, 
-          mouseData.y, 
-          CLICK_LEFT
-        );
-      } else if (mouseData.rightButton) {
-        // Rechtsklick: Strahlen
-        displayManager.drawClickAnimation(
-          mouseData.x, 
-          mouseData.y, 
-          CLICK_RIGHT
-        );
+    // Cursor zeichnen (mit geschwindigkeitsbasierter Helligkeit)
+    displayManager.drawCursor(
+      mouseData.x, 
+      mouseData.y, 
+      mouseData.speed
+    );
+    
+    // Klick-Animationen aus den Tasten-Flanken (einmal pro Drücken,
+    // auch bei Klicks zwischen zwei Frames)
+    ButtonEvent event;
+    while (mouseHandler.pollButtonEvent(buttonEventCursor, event)) {
+      if (event.skipped > 0) {
+        Serial.printf("[MOUSE] %u Tasten-Flanken verpasst\n", event.skipped);
       }
+      handleButtonEvent(event);
+    }
+    
+    // Status am unteren Rand (wird nur bei Textänderung neu gezeichnet)
+    displayManager.showMouseStatus("Maus verbunden");
+    
+    // Animationen updaten (Kreise/Strahlen ausblenden)
+    displayManager.updateAnimations();
+    
+    if (displayManager.hasPendingChanges()) {
+      framePacer.markChanged();
+    }
+    
+    if (framePacer.beginFrame()) {
+      scheduler.beginTask(TASK_DISPLAY);
+      uint32_t renderStartUs = micros();
       
-      // Status am unteren Rand
-      displayManager.showMouseStatus("Maus verbunden");
-      
-      // Debug-Ausgabe bei Klicks
-      static bool lastLeftButton = false;
-      static bool lastRightButton = false;
+      // Nur geänderte Bereiche übertragen
+      displayManager.renderFrame();
       
-      if (mouseData.leftButton && !lastLeftButton) {
-        Serial.printf("[MOUSE] Linksklick bei (%d, %d)\n", 
-                     mouseData.x, mouseData.y);
-      }
-      if (mouseData.rightButton && !lastRightButton) {
-        Serial.printf("[MOUSE] Rechtsklick bei (%d, %d)\n", 
-                     mouseData.x, mouseData.y);
+      if (displayManager.isFramebufferActive()) {
+        // DMA läuft im Hintergrund - Latenz erst nach dem Flush erfassen
+        pendingFrame.pending = true;
+        pendingFrame.ingressUs = mouseData.ingressUs;
+        pendingFrame.updateUs = mouseData.updateUs;
+        pendingFrame.renderStartUs = renderStartUs;
+      } else {
+        // TFT-Zugriffe sind blockierend - hier ist der SPI-Transfer abgeschlossen
+        latencyMonitor.recordFrame(mouseData.ingressUs, mouseData.updateUs,
+                                   renderStartUs, micros());
       }
       
-      lastLeftButton = mouseData.leftButton;
-      lastRightButton = mouseData.rightButton;
+      scheduler.endTask(TASK_DISPLAY);
+      
+      // Bei wiederholten Budget-Überschreitungen günstiger zeichnen
+      QualityLevel level = frameGovernor.recordFrame(ESP.getCycleCount() - passStartCycles);
+      displayManager.setQuality(level);
     }
-    
-    // Animationen updaten (Kreise/Strahlen ausblenden)
-    displayManager.updateAnimations();
+  }
+  
+  // Im Leerlauf die Maus seltener abfragen - Reports wecken loop() sofort
+  if (framePacer.isIdle() != displayIdle) {
+    displayIdle = !displayIdle;
+    scheduler.setInterval(TASK_MOUSE, displayIdle ? MOUSE_IDLE_POLL_INTERVAL : MOUSE_POLL_INTERVAL);
+  }
+
+  // Abgeschlossenen DMA-Flush für die Latenzmessung erfassen
+  if (pendingFrame.pending && displayManager.isFlushComplete()) {
+    latencyMonitor.recordFrame(pendingFrame.ingressUs, pendingFrame.updateUs,
+                               pendingFrame.renderStartUs, micros());
+    pendingFrame.pending = false;
   }
 
   // ========== Netzwerk-Check ==========
-  // Niedrige Frequenz (alle 5 Sekunden)
-  if (currentMillis - lastNetworkCheck >= NETWORK_CHECK_INTERVAL) {
-    lastNetworkCheck = currentMillis;
+  // 4 Hz: nur Zustandsprüfung, Verbindungsaufbau läuft im WiFi-Treiber
+  if (scheduler.isDue(TASK_NETWORK)) {
+    scheduler.beginTask(TASK_NETWORK);
     
-    // Netzwerkstatus prüfen
+    // Station-Zustandsautomat (Versuche, Timeouts, Backoff) und Scan-Timeout;
+    // Verbindungsereignisse kommen per WiFi.onEvent, hier wird nie gewartet
     networkManager.update();
     
-    // Optional: Reconnect-Logik für Station Mode
-    if (networkManager.isStationEnabled() && !networkManager.isStationConnected()) {
-      static int reconnectAttempts = 0;
-      reconnectAttempts++;
-      
-      if (reconnectAttempts <= 3) {
-        Serial.printf("[WIFI] Reconnect-Versuch %d/3...\n", reconnectAttempts);
-        networkManager.reconnectStation();
-      } else {
-        // Nach 3 Versuchen: Aufgeben bis zum nächsten manuellen Versuch
-        reconnectAttempts = 0;
+    scheduler.endTask(TASK_NETWORK);
+  }
+
+  // ========== Live-Telemetrie ==========
+  // Nur mit verbundenen Clients getaktet (max. TELEMETRY_MAX_HZ)
+  uint32_t interval = webServer.getTelemetryInterval();
+  if (interval != telemetryInterval) {
+    telemetryInterval = interval;
+    scheduler.setInterval(TASK_TELEMETRY, telemetryInterval);
+  }
+  if (scheduler.isDue(TASK_TELEMETRY)) {
+    scheduler.beginTask(TASK_TELEMETRY);
+    webServer.updateTelemetry();
+    scheduler.endTask(TASK_TELEMETRY);
+  }
+
+  // ========== Bildschirm-Spiegelung ==========
+  // Geänderte Kacheln an verbundene Browser (nicht blockierend)
+  if (scheduler.isDue(TASK_MIRROR)) {
+    scheduler.beginTask(TASK_MIRROR);
+    webServer.updateMirror();
+    scheduler.endTask(TASK_MIRROR);
+  }
+
+  // ========== OTA-Fortschritt ==========
+  // Gedrosselt statt bei jedem TCP-Segment neu zu zeichnen
+  if (scheduler.isDue(TASK_OTA)) {
+    scheduler.beginTask(TASK_OTA);
+    
+    OtaStats ota = webServer.getOtaStats();
+    if (ota.active && ota.received > 0) {
+      if (!otaDisplayed) {
+        otaDisplayed = true;
+        onOTAStart();
+      }
+      if (ota.uploadSize > 0) {
+        onOTAProgress(ota.received, ota.uploadSize);
       }
+    } else if (otaDisplayed && !ota.active) {
+      otaDisplayed = false;
+      if (!ota.success && webServer.getOtaError() != nullptr) {
+        Serial.printf("[OTA ERROR] %s\n", webServer.getOtaError());
+        displayManager.showError(webServer.getOtaError());
+      }
+    }
+    
+    if (webServer.isRestartDue()) {
+      onOTAEnd();
+      delay(100);
+      ESP.restart();
     }
+    
+    scheduler.endTask(TASK_OTA);
+  }
+
+  // ========== BT-Gerätesuche ==========
+  // Neue Funde aus dem GAP-Callback an die SSE-Clients
+  if (scheduler.isDue(TASK_DISCOVERY)) {
+    scheduler.beginTask(TASK_DISCOVERY);
+    webServer.updateDiscovery();
+    scheduler.endTask(TASK_DISCOVERY);
   }
 
   // ========== Webserver-Tasks ==========
   // Asynchroner Webserver läuft im Hintergrund
   // Keine explizite Verarbeitung nötig
   
-  // Kleine Verzögerung für Watchdog
-  delay(1);
+  // Schlafen bis zur nächsten Aufgabe, zum nächsten Frame oder bis ein
+  // Report eintrifft (mind. 1 Tick für den Watchdog)
+  uint32_t waitUs = min(scheduler.timeUntilNextTask(), framePacer.timeUntilNextFrame());
+  if (pendingFrame.pending) {
+    waitUs = 0;  // DMA-Abschluss im nächsten Tick prüfen
+  }
+  TickType_t waitTicks = max((TickType_t)1, (TickType_t)pdMS_TO_TICKS(waitUs / 1000));
+  
+  uint32_t sleepStartUs = micros();
+  inputSignaled = ulTaskNotifyTake(pdTRUE, waitTicks) > 0;
+  scheduler.addIdleTime(micros() - sleepStartUs);
 }
 
 // ========== Hilfs-Funktionen ==========
 
+/**
+ * Setzt eine Tasten-Flanke in eine Klick-Animation um
+ * Nur das Drücken löst eine Animation aus
+ */
+void handleButtonEvent(const ButtonEvent& event) {
+  if (!event.pressed) {
+    return;
+  }
+  
+  bool left = event.buttons & MOUSE_BUTTON_LEFT;
+  bool right = event.buttons & MOUSE_BUTTON_RIGHT;
+  
+  if (left && right) {
+    // Beide Tasten: Kombination
+    displayManager.drawClickAnimation(event.x, event.y, CLICK_BOTH);
+  } else if (event.button == MOUSE_BUTTON_LEFT) {
+    // Linksklick: Konzentrische Kreise
+    Serial.printf("[MOUSE] Linksklick bei (%d, %d)\n", event.x, event.y);
+    displayManager.drawClickAnimation(event.x, event.y, CLICK_LEFT);
+  } else if (event.button == MOUSE_BUTTON_RIGHT) {
+    // Rechtsklick: Strahlen
+    Serial.printf("[MOUSE] Rechtsklick bei (%d, %d)\n", event.x, event.y);
+    displayManager.drawClickAnimation(event.x, event.y, CLICK_RIGHT);
+  }
+}
+
 /**
  * Wird bei kritischen Fehlern aufgerufen
  * Zeigt Fehler auf Display und Serial an
@@ -267,6 +430,7 @@ void handleCriticalError(const char* errorMessage) {
  */
 void onOTAStart() {
   Serial.println("[OTA] Update gestartet");
+  otaLastPercentage = 0;
   displayManager.showOTAProgress(0);
 }
 
@@ -274,7 +438,11 @@ void onOTAStart() {
  * Wird während OTA-Update aufgerufen
  */
 void onOTAProgress(unsigned int progress, unsigned int total) {
-  int percentage = (progress * 100) / total;
+  int percentage = (uint64_t)progress * 100 / total;
+  if (percentage == otaLastPercentage) {
+    return;  // Nur bei neuem Prozentwert neu zeichnen
+  }
+  otaLastPercentage = percentage;
   Serial.printf("[OTA] Fortschritt: %d%%\n", percentage);
   displayManager.showOTAProgress(percentage);
 }
@@ -12,7 +12,6 @@
 
 static MouseHandler* g_mouseHandlerInstance = nullptr;
 static void (*g_bleDeviceCallback)(BLEMouseDevice) = nullptr;
-static void (*g_btClassicDeviceCallback)(BTClassicDevice) = nullptr;
 static void (*g_usbDeviceCallback)(USBMouseDevice) = nullptr;
 
 // ========== Konstruktor ==========
@@ -25,9 +24,11 @@ MouseHandler::MouseHandler() {
   btClassicInitialized = false;
   btClassicConnected = false;
   memset(btClassicAddress, 0, sizeof(btClassicAddress));
+  btDiscoveryRunning = false;
+  btDiscoveryJob = 0;
+  btScanLock = portMUX_INITIALIZER_UNLOCKED;
   
   usbConnected = false;
-  usbHID = nullptr;
   
   currentMouseType = MOUSE_NONE;
   
@@ -35,12 +36,28 @@ MouseHandler::MouseHandler() {
   currentData.y = 67;
   currentData.leftButton = false;
   currentData.rightButton = false;
+  currentData.buttons = 0;
+  currentData.wheel = 0;
   currentData.speed = 0.0f;
   currentData.type = MOUSE_NONE;
+  currentData.ingressUs = 0;
+  currentData.updateUs = 0;
   
-  lastX = currentData.x;
-  lastY = currentData.y;
-  lastUpdateTime = millis();
+  rawX = 0;
+  rawY = 0;
+  currentReportTimeUs = 0;
+  
+  publishedData = currentData;
+  dataLock = portMUX_INITIALIZER_UNLOCKED;
+  
+  HidDescriptorParser::bootProtocolPlan(reportPlan);
+  planPending = false;
+  
+  buttonEventSeq = 0;
+  inputNotifyTask = nullptr;
+  
+  traceRecording = false;
+  traceLock = portMUX_INITIALIZER_UNLOCKED;
   
   g_mouseHandlerInstance = this;
 }
@@ -59,34 +76,105 @@ bool MouseHandler::begin() {
 // ========== Update-Loop ==========
 
 void MouseHandler::update() {
-  // Geschwindigkeit berechnen
-  unsigned long now = millis();
-  if (now - lastUpdateTime > 100) {
-    currentData.speed = calculateSpeed();
-    lastX = currentData.x;
-    lastY = currentData.y;
-    lastUpdateTime = now;
+  // Neuen Extraktionsplan übernehmen (nach Verbindungsaufbau)
+  portENTER_CRITICAL(&dataLock);
+  if (planPending) {
+    reportPlan = pendingPlan;
+    planPending = false;
+  }
+  portEXIT_CRITICAL(&dataLock);
+  
+  // Alle seit dem letzten Aufruf eingegangenen Reports einzeln verarbeiten
+  RawMouseReport report;
+  bool received = false;
+  bool replaying = isTraceReplaying();
+  while (reportQueue.pop(report)) {
+    if (replaying) {
+      continue;  // Während der Wiedergabe wird Live-Input verworfen
+    }
+    
+    portENTER_CRITICAL(&traceLock);
+    if (traceRecording) {
+      traceRecorder.record(report.timestampUs, report.source, report.reportId,
+                           report.data, report.length);
+    }
+    portEXIT_CRITICAL(&traceLock);
+    
+    processReport(report);
+    received = true;
   }
   
+  // Trace-Wiedergabe speist dieselbe Verarbeitung wie Live-Reports
+  if (replaying) {
+    pumpTraceReplay();
+    received = true;
+  }
+  
+  if (received) {
+    currentData.ingressUs = currentReportTimeUs;
+    currentData.updateUs = micros();
+  }
+  
+  // Geschwindigkeit ohne neue Reports abklingen lassen
+  velocityFilter.tick(micros());
+  currentData.speed = velocityFilter.getSpeed();
+  
   // USB-Polling (falls USB-Maus verbunden)
   // TODO: Wird implementiert wenn USB-Support aktiv ist
+  
+  publishData();
 }
 
 // ========== Status-Funktionen ==========
 
 bool MouseHandler::isMouseConnected() {
-  return currentMouseType != MOUSE_NONE;
+  return currentMouseType != MOUSE_NONE || isTraceReplaying();
 }
 
 MouseData MouseHandler::getMouseData() {
-  currentData.type = currentMouseType;
-  return currentData;
+  // Snapshot lesen - wird auch vom Web-Task aufgerufen
+  portENTER_CRITICAL(&dataLock);
+  MouseData data = publishedData;
+  portEXIT_CRITICAL(&dataLock);
+  return data;
 }
 
 MouseType MouseHandler::getMouseType() {
   return currentMouseType;
 }
 
+ReportQueueStats MouseHandler::getQueueStats() {
+  return reportQueue.getStats();
+}
+
+bool MouseHandler::pollButtonEvent(uint32_t& cursor, ButtonEvent& event) {
+  bool available = false;
+  uint32_t skipped = 0;
+  
+  portENTER_CRITICAL(&dataLock);
+  if (buttonEventSeq - cursor > BUTTON_EVENT_CAPACITY) {
+    // Konsument zu langsam - überschriebene Flanken zählen
+    skipped = buttonEventSeq - BUTTON_EVENT_CAPACITY - cursor;
+    cursor = buttonEventSeq - BUTTON_EVENT_CAPACITY;
+  }
+  if (cursor != buttonEventSeq) {
+    event = buttonEvents[cursor % BUTTON_EVENT_CAPACITY];
+    event.skipped = skipped;
+    cursor++;
+    available = true;
+  }
+  portEXIT_CRITICAL(&dataLock);
+  
+  return available;
+}
+
+uint32_t MouseHandler::getButtonEventSeq() {
+  portENTER_CRITICAL(&dataLock);
+  uint32_t seq = buttonEventSeq;
+  portEXIT_CRITICAL(&dataLock);
+  return seq;
+}
+
 // ========== Disconnect ==========
 
 void MouseHandler::disconnectMouse() {
@@ -110,26 +198,181 @@ void MouseHandler::disconnectMouse() {
   Serial.println("[MouseHandler] Maus getrennt");
 }
 
-// ========== Hilfsfunktionen ==========
+// ========== Report-Queue ==========
+
+bool MouseHandler::enqueueReport(MouseType source, uint8_t reportId, const uint8_t* data, size_t length) {
+  // Läuft im Kontext des jeweiligen Transport-Callbacks (Producer)
+  bool queued = reportQueue.push(micros(), (uint8_t)source, reportId, data, length);
+  notifyInput();
+  return queued;
+}
+
+void MouseHandler::setInputNotifyTask(TaskHandle_t task) {
+  inputNotifyTask = task;
+}
+
+void MouseHandler::notifyInput() {
+  if (inputNotifyTask != nullptr) {
+    xTaskNotifyGive(inputNotifyTask);
+  }
+}
 
-float MouseHandler::calculateSpeed() {
-  unsigned long now = millis();
-  unsigned long deltaTime = now - lastUpdateTime;
+void MouseHandler::processReport(const RawMouseReport& report) {
+  // Läuft in update() (Consumer)
+  // Reports anderer IDs (z.B. Tastatur bei Kombi-Geräten) ignorieren
+  if (reportPlan.reportId != 0 && report.reportId != reportPlan.reportId) {
+    return;
+  }
   
-  if (deltaTime == 0) return currentData.speed;
+  uint8_t data[REPORT_MAX_SIZE];
+  memcpy(data, report.data, report.length);
+  currentReportTimeUs = report.timestampUs;
   
-  int dx = currentData.x - lastX;
-  int dy = currentData.y - lastY;
-  float distance = sqrt(dx * dx + dy * dy);
+  switch (report.source) {
+    case MOUSE_BT_CLASSIC:
+      processBTClassicData(data, report.length);
+      break;
+    case MOUSE_USB:
+      processUSBMouseReport(data, report.length);
+      break;
+    case MOUSE_BLE:
+      processBLEMouseReport(data, report.length);
+      break;
+    default:
+      break;
+  }
+}
+
+void MouseHandler::pumpTraceReplay() {
+  // Höchstens eine Queue-Füllung pro Aufruf (auch bei maximaler Geschwindigkeit)
+  HidTraceRecord record;
+  for (int i = 0; i < REPORT_QUEUE_CAPACITY; i++) {
+    portENTER_CRITICAL(&traceLock);
+    bool due = tracePlayer.next(micros(), record);
+    portEXIT_CRITICAL(&traceLock);
+    
+    if (!due) break;
+    
+    RawMouseReport report;
+    report.timestampUs = record.timestampUs;
+    report.source = record.source;
+    report.reportId = record.reportId;
+    report.length = record.length > REPORT_MAX_SIZE ? REPORT_MAX_SIZE : record.length;
+    memcpy(report.data, record.data, report.length);
+    processReport(report);
+  }
+}
+
+void MouseHandler::publishData() {
+  currentData.type = currentMouseType;
+  
+  portENTER_CRITICAL(&dataLock);
+  publishedData = currentData;
+  portEXIT_CRITICAL(&dataLock);
+}
+
+// ========== HID-Trace ==========
+
+bool MouseHandler::startTraceRecording() {
+  // Die Wiedergabe liest direkt aus dem Recorder-Puffer, clear() darf
+  // ihn nicht unter ihr wegziehen
+  stopTraceReplay();
+  
+  if (!traceRecorder.begin()) {
+    Serial.println("[Trace] Kein Speicher für Trace-Puffer");
+    return false;
+  }
   
-  // Pixel pro Sekunde
-  float speed = distance / (deltaTime / 1000.0f);
+  portENTER_CRITICAL(&traceLock);
+  traceRecorder.clear();
+  traceRecording = true;
+  portEXIT_CRITICAL(&traceLock);
   
-  // Sanfte Geschwindigkeitsänderung (Low-Pass-Filter)
-  return currentData.speed * 0.7f + speed * 0.3f;
+  Serial.printf("[Trace] Aufzeichnung gestartet (%u Bytes Puffer)\n", traceRecorder.getCapacity());
+  return true;
+}
+
+void MouseHandler::stopTraceRecording() {
+  portENTER_CRITICAL(&traceLock);
+  traceRecording = false;
+  portEXIT_CRITICAL(&traceLock);
+}
+
+bool MouseHandler::isTraceRecording() {
+  return traceRecording;
 }
 
-void MouseHandler::updateMousePosition(int8_t dx, int8_t dy) {
+bool MouseHandler::startTraceReplay(uint16_t speedPercent) {
+  stopTraceRecording();
+  stopTraceReplay();
+  
+  // Recorder und Player sind jetzt inaktiv - Umsortieren ohne Lock möglich
+  size_t length = 0;
+  const uint8_t* records = traceRecorder.linearize(length);
+  if (records == nullptr || length == 0) {
+    return false;
+  }
+  
+  portENTER_CRITICAL(&traceLock);
+  tracePlayer.begin(records, length, micros(), speedPercent);
+  portEXIT_CRITICAL(&traceLock);
+  
+  Serial.printf("[Trace] Wiedergabe von %u Reports (%u%%)\n",
+               traceRecorder.getRecordCount(), speedPercent);
+  notifyInput();
+  return true;
+}
+
+void MouseHandler::stopTraceReplay() {
+  portENTER_CRITICAL(&traceLock);
+  tracePlayer.stop();
+  portEXIT_CRITICAL(&traceLock);
+}
+
+bool MouseHandler::isTraceReplaying() {
+  portENTER_CRITICAL(&traceLock);
+  bool active = tracePlayer.isActive();
+  portEXIT_CRITICAL(&traceLock);
+  return active;
+}
+
+uint32_t MouseHandler::getTraceRecordCount() {
+  return traceRecorder.getRecordCount();
+}
+
+size_t MouseHandler::getTraceSize() {
+  return traceRecorder.getStreamSize();
+}
+
+size_t MouseHandler::readTrace(size_t offset, uint8_t* out, size_t maxLength) {
+  // Export nur aus einem stehenden Puffer: Aufzeichnung beenden und unter
+  // dem Lock kopieren, damit update() nicht zwischen zwei Stücken verdrängt
+  portENTER_CRITICAL(&traceLock);
+  traceRecording = false;
+  size_t copied = traceRecorder.readStream(offset, out, maxLength);
+  portEXIT_CRITICAL(&traceLock);
+  return copied;
+}
+
+// ========== Hilfsfunktionen ==========
+
+void MouseHandler::applyHidReport(const uint8_t* data, size_t length) {
+  HidMouseReport report;
+  if (!hidDecodeReport(reportPlan, data, length, report)) {
+    return;
+  }
+  
+  currentData.wheel += report.wheel;
+  updateMousePosition(report.dx, report.dy);
+  
+  // Geschwindigkeit pro Report mit dem Eingangszeitstempel
+  rawX += report.dx;
+  rawY += report.dy;
+  velocityFilter.addSample(rawX, rawY, currentReportTimeUs);
+  updateMouseButtons(report.buttons);
+}
+
+void MouseHandler::updateMousePosition(int dx, int dy) {
   currentData.x += dx;
   currentData.y += dy;
   
@@ -138,14 +381,35 @@ void MouseHandler::updateMousePosition(int8_t dx, int8_t dy) {
   currentData.y = constrain(currentData.y, 0, 135);
 }
 
-void MouseHandler::updateMouseButtons(bool left, bool right) {
-  // Nur bei Änderung ausgeben
-  if (left != currentData.leftButton || right != currentData.rightButton) {
-    Serial.printf("[MouseHandler] Buttons: L=%d R=%d\n", left, right);
+void MouseHandler::updateMouseButtons(uint32_t buttons) {
+  uint32_t changed = (buttons ^ currentData.buttons) & BUTTON_EVENT_TRACKED_BUTTONS;
+  
+  currentData.buttons = buttons;
+  currentData.leftButton = buttons & MOUSE_BUTTON_LEFT;
+  currentData.rightButton = buttons & MOUSE_BUTTON_RIGHT;
+  
+  // Jede Flanke einzeln melden - auch Klicks kürzer als ein Display-Frame
+  for (uint8_t button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button <<= 1) {
+    if (changed & button) {
+      emitButtonEvent(button, buttons & button);
+    }
   }
+}
+
+void MouseHandler::emitButtonEvent(uint8_t button, bool pressed) {
+  ButtonEvent event;
+  event.timestampUs = currentReportTimeUs;
+  event.x = currentData.x;
+  event.y = currentData.y;
+  event.button = button;
+  event.pressed = pressed;
+  event.buttons = currentData.buttons;
+  event.skipped = 0;
   
-  currentData.leftButton = left;
-  currentData.rightButton = right;
+  portENTER_CRITICAL(&dataLock);
+  buttonEvents[buttonEventSeq % BUTTON_EVENT_CAPACITY] = event;
+  buttonEventSeq++;
+  portEXIT_CRITICAL(&dataLock);
 }
 
 
@@ -219,34 +483,69 @@ bool MouseHandler::initBTClassic() {
   return true;
 }
 
-void MouseHandler::scanBTClassicMice(void (*callback)(BTClassicDevice device)) {
+uint32_t MouseHandler::startBTDiscovery() {
   if (!btClassicInitialized) {
     if (!initBTClassic()) {
       Serial.println("[BT-Classic] Kann nicht scannen - Initialisierung fehlgeschlagen");
-      return;
+      return 0;
     }
   }
   
-  Serial.println("[BT-Classic] Starte Scan (10 Sekunden)...");
-  g_btClassicDeviceCallback = callback;
+  portENTER_CRITICAL(&btScanLock);
+  if (btDiscoveryRunning) {
+    uint32_t job = btDiscoveryJob;
+    portEXIT_CRITICAL(&btScanLock);
+    return job;  // Laufende Suche mitbenutzen
+  }
+  btDiscoveryRunning = true;
+  uint32_t job = ++btDiscoveryJob;
+  portEXIT_CRITICAL(&btScanLock);
+  
+  Serial.printf("[BT-Classic] Starte Suche %u...\n", job);
   
-  // Discovery starten (10 Sekunden)
-  esp_err_t ret = esp_bt_gap_start_discovery(ESP_BT_INQ_MODE_GENERAL_INQUIRY, 10, 0);
+  // Ergebnisse kommen über btClassicGapCallback, das Ende per DISC_STATE_CHANGED
+  esp_err_t ret = esp_bt_gap_start_discovery(ESP_BT_INQ_MODE_GENERAL_INQUIRY, BT_DISCOVERY_DURATION, 0);
   if (ret != ESP_OK) {
     Serial.printf("[BT-Classic] Scan-Start fehlgeschlagen: %s\n", esp_err_to_name(ret));
+    portENTER_CRITICAL(&btScanLock);
+    btDiscoveryRunning = false;
+    portEXIT_CRITICAL(&btScanLock);
+  }
+  return job;
+}
+
+bool MouseHandler::isBTDiscoveryRunning() {
+  portENTER_CRITICAL(&btScanLock);
+  bool running = btDiscoveryRunning;
+  portEXIT_CRITICAL(&btScanLock);
+  return running;
+}
+
+int MouseHandler::getBTDevices(BtDevice* out, int maxCount, uint32_t sinceSeq, uint32_t& seq) {
+  int copied = 0;
+  portENTER_CRITICAL(&btScanLock);
+  for (int i = 0; i < btDevices.getCount() && copied < maxCount; i++) {
+    const BtDevice& device = btDevices.get(i);
+    if (device.seq > sinceSeq) {
+      out[copied++] = device;
+    }
   }
+  seq = btDevices.getSeq();
+  portEXIT_CRITICAL(&btScanLock);
+  return copied;
 }
 
 void MouseHandler::btClassicGapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param) {
   switch (event) {
     case ESP_BT_GAP_DISC_RES_EVT: {
-      // Device gefunden
+      // Device gefunden (BT-Task)
       esp_bt_gap_dev_prop_t* prop = param->disc_res.prop;
       
       // Prüfe Class of Device (HID-Devices haben 0x2580 oder 0x0580)
       uint32_t cod = 0;
       bool isHID = false;
-      String deviceName = "";
+      char deviceName[BT_DISCOVERY_NAME_MAX] = "";
+      int8_t rssi = BT_RSSI_NONE;  // Nicht jeder Fund meldet einen Pegel
       
       for (int i = 0; i < param->disc_res.num_prop; i++) {
         if (prop[i].type == ESP_BT_GAP_DEV_PROP_COD) {
@@ -260,27 +559,34 @@ void MouseHandler::btClassicGapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_
           }
         }
         else if (prop[i].type == ESP_BT_GAP_DEV_PROP_BDNAME) {
-          deviceName = String((char*)prop[i].val);
+          // Name ist nicht nullterminiert
+          int length = min(prop[i].len, BT_DISCOVERY_NAME_MAX - 1);
+          memcpy(deviceName, prop[i].val, length);
+          deviceName[length] = '\0';
+        }
+        else if (prop[i].type == ESP_BT_GAP_DEV_PROP_RSSI) {
+          rssi = *(int8_t*)prop[i].val;
         }
       }
       
-      if (isHID && g_btClassicDeviceCallback != nullptr) {
-        BTClassicDevice device;
-        device.name = deviceName;
-        
-        // BT-Adresse als String
-        char addr_str[18];
-        sprintf(addr_str, "%02X:%02X:%02X:%02X:%02X:%02X",
-                param->disc_res.bda[0], param->disc_res.bda[1],
-                param->disc_res.bda[2], param->disc_res.bda[3],
-                param->disc_res.bda[4], param->disc_res.bda[5]);
-        device.address = String(addr_str);
-        device.rssi = param->disc_res.rssi[0];
-        
+      MouseHandler* self = g_mouseHandlerInstance;
+      if (self == nullptr) {
+        break;
+      }
+      
+      // Mäuse aufnehmen; spätere Funde ohne CoD (z.B. nur Name) ergänzen sie
+      portENTER_CRITICAL(&self->btScanLock);
+      bool known = self->btDevices.find(param->disc_res.bda) >= 0;
+      if (isHID || known) {
+        self->btDevices.update(param->disc_res.bda, deviceName, rssi, cod, millis());
+      }
+      portEXIT_CRITICAL(&self->btScanLock);
+      
+      if (isHID && !known) {
+        char address[18];
+        BtDeviceTable::formatAddress(param->disc_res.bda, address);
         Serial.printf("[BT-Classic] HID-Device gefunden: %s (%s) RSSI: %d\n",
-                     device.name.c_str(), device.address.c_str(), device.rssi);
-        
-        g_btClassicDeviceCallback(device);
+                      deviceName, address, rssi);
       }
       break;
     }
@@ -288,6 +594,11 @@ void MouseHandler::btClassicGapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_
     case ESP_BT_GAP_DISC_STATE_CHANGED_EVT: {
       if (param->disc_st_chg.state == ESP_BT_GAP_DISCOVERY_STOPPED) {
         Serial.println("[BT-Classic] Scan abgeschlossen");
+        if (g_mouseHandlerInstance != nullptr) {
+          portENTER_CRITICAL(&g_mouseHandlerInstance->btScanLock);
+          g_mouseHandlerInstance->btDiscoveryRunning = false;
+          portEXIT_CRITICAL(&g_mouseHandlerInstance->btScanLock);
+        }
       }
       break;
     }
@@ -352,28 +663,39 @@ void MouseHandler::btClassicHIDCallback(void* handler_args, esp_event_base_t bas
   switch (event) {
     case ESP_HIDH_OPEN_EVENT: {
       Serial.println("[BT-Classic HID] Verbindung geöffnet");
+      
+      // Report-Deskriptor einmalig in Extraktionsplan übersetzen
+      HidExtractionPlan plan;
+      HidDescriptorParser::bootProtocolPlan(plan);
+      
+      size_t numMaps = 0;
+      esp_hid_raw_report_map_t* maps = nullptr;
+      if (esp_hidh_dev_report_maps_get(param->open.dev, &numMaps, &maps) == ESP_OK) {
+        for (size_t i = 0; i < numMaps; i++) {
+          if (HidDescriptorParser::parse(maps[i].data, maps[i].len, plan)) {
+            break;
+          }
+        }
+      }
+      
+      Serial.printf("[BT-Classic HID] Report-ID %d, X %d Bit, Y %d Bit, %d Tasten\n",
+                   plan.reportId, plan.fields[HID_FIELD_X].bitSize,
+                   plan.fields[HID_FIELD_Y].bitSize, plan.fields[HID_FIELD_BUTTONS].bitSize);
+      
+      if (handler) {
+        portENTER_CRITICAL(&handler->dataLock);
+        handler->pendingPlan = plan;
+        handler->planPending = true;
+        portEXIT_CRITICAL(&handler->dataLock);
+      }
       break;
     }
     
     case ESP_HIDH_INPUT_EVENT: {
-      // HID Mouse Report Format (Standard):
-      // Byte 0: Buttons (Bit 0=Left, Bit 1=Right, Bit 2=Middle, ...)
-      // Byte 1: X-Movement (int8_t)
-      // Byte 2: Y-Movement (int8_t)
-      // Byte 3: Wheel (int8_t, optional)
-      
-      if (param->input.length >= 3) {
-        uint8_t* data = param->input.data;
-        
-        bool leftButton = data[0] & 0x01;
-        bool rightButton = data[0] & 0x02;
-        int8_t dx = (int8_t)data[1];
-        int8_t dy = (int8_t)data[2];
-        
-        if (handler) {
-          handler->updateMousePosition(dx, dy);
-          handler->updateMouseButtons(leftButton, rightButton);
-        }
+      // Nur einreihen - Dekodierung erfolgt in update() (processBTClassicData)
+      if (handler) {
+        handler->enqueueReport(MOUSE_BT_CLASSIC, param->input.report_id,
+                               param->input.data, param->input.length);
       }
       break;
     }
@@ -392,19 +714,6 @@ void MouseHandler::btClassicHIDCallback(void* handler_args, esp_event_base_t bas
   }
 }
 
-void MouseHandler::processBTClassicData(uint8_t* data, size_t length) {
-  // Diese Funktion wird vom HID-Callback aufgerufen
-  if (length < 3) return;
-  
-  bool leftButton = data[0] & 0x01;
-  bool rightButton = data[0] & 0x02;
-  int8_t dx = (int8_t)data[1];
-  int8_t dy = (int8_t)data[2];
-  
-  updateMousePosition(dx, dy);
-  updateMouseButtons(leftButton, rightButton);
-}
-
 #else
 // Bluetooth nicht aktiviert
 bool MouseHandler::initBTClassic() {
@@ -412,8 +721,18 @@ bool MouseHandler::initBTClassic() {
   return false;
 }
 
-void MouseHandler::scanBTClassicMice(void (*callback)(BTClassicDevice device)) {
+uint32_t MouseHandler::startBTDiscovery() {
   Serial.println("[BT-Classic] Bluetooth nicht verfügbar");
+  return 0;
+}
+
+bool MouseHandler::isBTDiscoveryRunning() {
+  return false;
+}
+
+int MouseHandler::getBTDevices(BtDevice* out, int maxCount, uint32_t sinceSeq, uint32_t& seq) {
+  seq = 0;
+  return 0;
 }
 
 bool MouseHandler::connectBTClassic(const char* address) {
@@ -428,9 +747,15 @@ bool MouseHandler::connectBTClassicMouse(const char* address) {
 void MouseHandler::disconnectBTClassic() {}
 void MouseHandler::btClassicGapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param) {}
 void MouseHandler::btClassicHIDCallback(void* handler_args, esp_event_base_t base, int32_t id, void* event_data) {}
-void MouseHandler::processBTClassicData(uint8_t* data, size_t length) {}
 #endif
 
+void MouseHandler::processBTClassicData(uint8_t* data, size_t length) {
+  // Layout laut Extraktionsplan (Deskriptor oder Boot-Protokoll:
+  // Buttons, int8 X, int8 Y, optional int8 Wheel) - auch für Trace-Wiedergabe
+  // in Builds ohne Bluetooth
+  applyHidReport(data, length);
+}
+
 
 // ============================================================================
 // USB - PRIORITÄT 2
@@ -452,7 +777,7 @@ bool MouseHandler::connectUSBMouse() {
   return false;
 }
 
-void MouseHandler::scanUSBMice(void (*callback)(USBMouseDevice device)) {
+void MouseHandler::scanUSBMice(std::function<void(USBMouseDevice)> callback) {
   Serial.println("[USB] USB-Scan noch nicht implementiert");
 }
 
@@ -493,7 +818,7 @@ bool MouseHandler::connectBLEMouse(const char* address) {
   return connectBLE(address);
 }
 
-void MouseHandler::scanBLEMice(void (*callback)(BLEMouseDevice device)) {
+void MouseHandler::scanBLEMice(std::function<void(BLEMouseDevice)> callback) {
   Serial.println("[BLE] BLE-Scan noch nicht implementiert");
 }
 
@@ -513,6 +838,6 @@ void MouseHandler::notifyCallback(NimBLERemoteCharacteristic* pChar,
                                   uint8_t* pData, size_t length, bool isNotify) {
   // TODO: BLE-Notification-Handler
   if (g_mouseHandlerInstance) {
-    g_mouseHandlerInstance->processBLEMouseReport(pData, length);
+    g_mouseHandlerInstance->enqueueReport(MOUSE_BLE, 0, pData, length);
   }
 }
@@ -9,12 +9,18 @@
 #include <Arduino.h>
 #include <functional>
 #include <NimBLEDevice.h>
+#include "report_queue.h"
+#include "hid_descriptor.h"
+#include "velocity_filter.h"
+#include "hid_trace.h"
+#include "bt_discovery.h"
 
 // Bluetooth Classic (nur Basic-APIs, kein HID-Host)
 #ifdef CONFIG_BT_ENABLED
   #include "esp_bt_main.h"
   #include "esp_bt_device.h"
   #include "esp_gap_bt_api.h"
+  #include "esp_hidh.h"
 #endif
 
 // Maus-Typen
@@ -31,19 +37,35 @@ struct MouseData {
   int y;
   bool leftButton;
   bool rightButton;
+  uint32_t buttons;  // Alle Tasten als Bitmaske
+  int wheel;         // Aufsummierte Scrollrad-Schritte
   float speed;
   MouseType type;
+  uint32_t ingressUs;  // Eingangszeit des neuesten Reports (micros())
+  uint32_t updateUs;   // Zeitpunkt der Verarbeitung in update()
 };
 
-// BLE-Scan-Ergebnis
-struct BLEMouseDevice {
-  String name;
-  String address;
-  int rssi;
+// Maus-Tasten (Bits in MouseData::buttons)
+#define MOUSE_BUTTON_LEFT 0x01
+#define MOUSE_BUTTON_RIGHT 0x02
+#define MOUSE_BUTTON_MIDDLE 0x04
+
+// Tasten-Flanken (Ringpuffer, jeder Konsument hat eigenen Cursor)
+#define BUTTON_EVENT_CAPACITY 32
+#define BUTTON_EVENT_TRACKED_BUTTONS 0x07  // Links, Rechts, Mitte
+
+struct ButtonEvent {
+  uint32_t timestampUs;  // Eingangszeit des auslösenden Reports
+  int x;
+  int y;
+  uint8_t button;        // MOUSE_BUTTON_*
+  bool pressed;          // true = Drücken, false = Loslassen
+  uint32_t buttons;      // Tastenzustand nach der Flanke
+  uint32_t skipped;      // Davor verlorene Flanken (Konsument zu langsam)
 };
 
-// BT-Classic-Scan-Ergebnis
-struct BTClassicDevice {
+// BLE-Scan-Ergebnis
+struct BLEMouseDevice {
   String name;
   String address;
   int rssi;
@@ -68,6 +90,17 @@ private:
   bool btClassicConnected;
   uint8_t btClassicAddress[6];
   
+  // Gerätesuche (GAP-Callback schreibt, Webserver liest; geschützt durch btScanLock)
+  BtDeviceTable btDevices;
+  bool btDiscoveryRunning;
+  uint32_t btDiscoveryJob;
+  portMUX_TYPE btScanLock;
+  
+  // Extraktionsplan aus dem Report-Deskriptor (Standard: Boot-Protokoll)
+  HidExtractionPlan reportPlan;
+  HidExtractionPlan pendingPlan;  // Vom HID-Task gesetzt, in update() übernommen
+  bool planPending;
+  
   // USB-spezifisch
   bool usbConnected;
   
@@ -76,8 +109,31 @@ private:
   
   // Maus-Daten
   MouseData currentData;
-  int lastX, lastY;
-  unsigned long lastUpdateTime;
+  
+  // Geschwindigkeit aus Report-Zeitstempeln (ungeklemmte Rohposition)
+  VelocityFilter velocityFilter;
+  int32_t rawX, rawY;
+  uint32_t currentReportTimeUs;
+  
+  // Report-Queue zwischen Transport-Callbacks und update()
+  ReportQueue reportQueue;
+  
+  // Veröffentlichter Snapshot für loop() und Web-Task
+  MouseData publishedData;
+  portMUX_TYPE dataLock;
+  
+  // Trace-Aufzeichnung und -Wiedergabe (geschützt durch traceLock)
+  HidTraceRecorder traceRecorder;
+  HidTracePlayer tracePlayer;
+  bool traceRecording;
+  portMUX_TYPE traceLock;
+  
+  // Tasten-Flanken (geschützt durch dataLock)
+  ButtonEvent buttonEvents[BUTTON_EVENT_CAPACITY];
+  uint32_t buttonEventSeq;  // Anzahl bisher erzeugter Flanken
+  
+  // Task, der bei neuen Reports geweckt wird (loop() schläft bis dahin)
+  TaskHandle_t inputNotifyTask;
   
   // Private Methoden - BLE
   bool connectBLE(const char* address);
@@ -90,6 +146,7 @@ private:
   bool connectBTClassic(const char* address);
   void disconnectBTClassic();
   static void btClassicGapCallback(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param);
+  static void btClassicHIDCallback(void* handler_args, esp_event_base_t base, int32_t id, void* event_data);
   void processBTClassicData(uint8_t* data, size_t length);
   
   // Private Methoden - USB
@@ -99,9 +156,15 @@ private:
   static void usbEventCallback(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
   
   // Gemeinsame Hilfsfunktionen
-  float calculateSpeed();
-  void updateMousePosition(int8_t dx, int8_t dy);
-  void updateMouseButtons(bool left, bool right);
+  bool enqueueReport(MouseType source, uint8_t reportId, const uint8_t* data, size_t length);
+  void processReport(const RawMouseReport& report);
+  void publishData();
+  void pumpTraceReplay();
+  void applyHidReport(const uint8_t* data, size_t length);
+  void updateMousePosition(int dx, int dy);
+  void updateMouseButtons(uint32_t buttons);
+  void emitButtonEvent(uint8_t button, bool pressed);
+  void notifyInput();
 
 public:
   MouseHandler();
@@ -109,10 +172,32 @@ public:
   bool begin();
   void update();
   
+  // Task-Benachrichtigung bei eingehenden Reports (z.B. loop-Task)
+  void setInputNotifyTask(TaskHandle_t task);
+  
   // Status
   bool isMouseConnected();
   MouseData getMouseData();
   MouseType getMouseType();
+  ReportQueueStats getQueueStats();
+  
+  // HID-Trace (Aufzeichnung der Roh-Reports, Wiedergabe statt Live-Input).
+  // Aufzeichnung beendet eine laufende Wiedergabe, readTrace() die Aufzeichnung.
+  bool startTraceRecording();
+  void stopTraceRecording();
+  bool isTraceRecording();
+  bool startTraceReplay(uint16_t speedPercent);
+  void stopTraceReplay();
+  bool isTraceReplaying();
+  uint32_t getTraceRecordCount();
+  size_t getTraceSize();
+  size_t readTrace(size_t offset, uint8_t* out, size_t maxLength);
+  
+  // Nächste Tasten-Flanke ab cursor lesen (cursor startet bei
+  // getButtonEventSeq()). Wurden Flanken überschrieben, springt cursor zur
+  // ältesten verfügbaren und event.skipped nennt die verlorenen.
+  bool pollButtonEvent(uint32_t& cursor, ButtonEvent& event);
+  uint32_t getButtonEventSeq();
   
   // BLE-Funktionen
   bool connectBLEMouse(const char* address);
@@ -120,7 +205,15 @@ public:
   
   // BT-Classic-Funktionen (vereinfacht)
   bool connectBTClassicMouse(const char* address);
-  void scanBTClassicMice(std::function<void(BTClassicDevice)> callback);
+  
+  // Gerätesuche als Hintergrund-Job; liefert die Job-ID, weitere Aufrufe
+  // während der Suche hängen sich an denselben Job
+  uint32_t startBTDiscovery();
+  bool isBTDiscoveryRunning();
+  
+  // Geräte mit Änderungen nach sinceSeq kopieren (0 = alle); seq erhält
+  // den neuesten Stand für den nächsten Aufruf
+  int getBTDevices(BtDevice* out, int maxCount, uint32_t sinceSeq, uint32_t& seq);
   
   // USB-Funktionen (Stubs)
   bool connectUSBMouse();
@@ -7,16 +7,60 @@
 
 NetworkManager::NetworkManager() {
   apEnabled = false;
-  stationEnabled = false;
-  stationConnected = false;
+  stationLock = portMUX_INITIALIZER_UNLOCKED;
+  
+  memset(&stationCache, 0, sizeof(stationCache));
+  cacheValid = false;
+  staticIPActive = false;
   apIP = IPAddress(192, 168, 4, 1);
+  
+  scanLock = portMUX_INITIALIZER_UNLOCKED;
+  scanCount = 0;
+  scanJobId = 0;
+  scanRunning = false;
+  scanPrevious = false;
+  scanChannel = 0;
+  scanChannelStartMs = 0;
+  scanDoneMs = 0;
 }
 
 bool NetworkManager::begin() {
   WiFi.mode(WIFI_AP_STA); // Dual-Mode: AP + Station
   
+  // Wiederverbinden übernimmt StationLink (mit Backoff statt im Takt des Treibers)
+  WiFi.setAutoReconnect(false);
+  stationControl.seed(esp_random());
+  
+  WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+    onStationEvent(event, info);
+  }, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+    onStationEvent(event, info);
+  }, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  
+  // Scan-Ergebnisse kommen per Ereignis, nicht durch Warten
+  WiFi.onEvent([this](WiFiEvent_t, WiFiEventInfo_t) {
+    onScanDone();
+  }, ARDUINO_EVENT_WIFI_SCAN_DONE);
+  
   // Access Point starten
-  return startAccessPoint();
+  bool apStarted = startAccessPoint();
+  
+  // Zuletzt genutztes Netz: erster Versuch über BSSID/Kanal aus dem Cache
+  if (loadStationCache()) {
+    Serial.printf("[NETWORK] Gespeicherte Station: %s (Kanal %u)\n",
+                  stationCache.ssid, stationCache.channel);
+    stationSSID = stationCache.ssid;
+    stationPassword = stationCache.password;
+    
+    portENTER_CRITICAL(&stationLock);
+    stationControl.setCached(true);
+    stationControl.start(millis(), true);
+    portEXIT_CRITICAL(&stationLock);
+    update();
+  }
+  
+  return apStarted;
 }
 
 bool NetworkManager::startAccessPoint() {
@@ -40,9 +84,29 @@ bool NetworkManager::startAccessPoint() {
 }
 
 void NetworkManager::update() {
-  // Check station connection status
-  if (stationEnabled) {
-    stationConnected = WiFi.status() == WL_CONNECTED;
+  // Fällige Verbindungsversuche starten, hängende abbrechen - nie warten
+  portENTER_CRITICAL(&stationLock);
+  StationCommand command = stationControl.update(millis());
+  portEXIT_CRITICAL(&stationLock);
+  
+  if (command.action == STATION_ACTION_CONNECT) {
+    Serial.printf("[NETWORK] Verbinde mit %s (Versuch %u%s)...\n", stationSSID.c_str(),
+                  command.attempt, command.fast ? ", Cache" : "");
+    beginAttempt(command.fast);
+  } else if (command.action == STATION_ACTION_DISCONNECT) {
+    Serial.println("[NETWORK] Verbindungsversuch ohne Antwort - abgebrochen");
+    WiFi.disconnect();
+  }
+  
+  // NVS-Schreibzugriff nicht im Ereignis-Task
+  if (command.saveCache) {
+    saveStationCache();
+  }
+  
+  // Scan-Job, dessen Ereignis ausbleibt, mit dem Zwischenstand beenden
+  if (scanRunning && millis() - scanChannelStartMs > WIFI_SCAN_TIMEOUT_MS) {
+    Serial.printf("[NETWORK] Scan auf Kanal %u ohne Antwort - Job beendet\n", scanChannel);
+    finishScan();
   }
 }
 
@@ -59,72 +123,309 @@ IPAddress NetworkManager::getAPIP() {
 }
 
 bool NetworkManager::connectToWiFi(const char* ssid, const char* password) {
-  Serial.printf("[NETWORK] Verbinde mit %s...\n", ssid);
+  if (ssid == nullptr || ssid[0] == '\0') {
+    return false;
+  }
+  
+  // Zugangsdaten nur aus loop() bzw. dem Webserver-Task ändern; der
+  // Ereignis-Task liest sie nicht
+  // Die Trennung des bisherigen Versuchs zählt nicht als Fehlschlag
+  portENTER_CRITICAL(&stationLock);
+  stationControl.stop();
+  portEXIT_CRITICAL(&stationLock);
   
+  WiFi.disconnect();
   stationSSID = ssid;
   stationPassword = password;
   
-  WiFi.begin(ssid, password);
-  
-  // Warte max. 10 Sekunden
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-    delay(500);
-    Serial.print(".");
-    attempts++;
-  }
+  // Neue Zugangsdaten: voller Verbindungsaufbau, Cache erst nach Erfolg
+  portENTER_CRITICAL(&stationLock);
+  stationControl.start(millis(), false);
+  portEXIT_CRITICAL(&stationLock);
   
-  if (WiFi.status() == WL_CONNECTED) {
-    stationEnabled = true;
-    stationConnected = true;
-    Serial.printf("\n[NETWORK] Verbunden! IP: %s\n", WiFi.localIP().toString().c_str());
-    return true;
-  } else {
-    Serial.println("\n[NETWORK] Verbindung fehlgeschlagen");
-    return false;
-  }
+  // Erster Versuch sofort, Ergebnis kommt per Ereignis
+  update();
+  return true;
 }
 
 void NetworkManager::disconnectWiFi() {
+  portENTER_CRITICAL(&stationLock);
+  stationControl.stop();
+  portEXIT_CRITICAL(&stationLock);
+  
+  // Manuell getrennt bleibt auch nach einem Neustart getrennt
   WiFi.disconnect();
-  stationEnabled = false;
-  stationConnected = false;
+  clearStationCache();
   Serial.println("[NETWORK] WiFi getrennt");
 }
 
-bool NetworkManager::reconnectStation() {
-  if (!stationEnabled || stationSSID.length() == 0) {
-    return false;
+void NetworkManager::beginAttempt(bool fast) {
+  if (fast) {
+#if WIFI_FAST_CONNECT_STATIC_IP
+    // Bisherige Adresse statt DHCP (Lease kann inzwischen vergeben sein -
+    // dann scheitert der Versuch und der normale Aufbau übernimmt)
+    if (stationCache.ip != 0) {
+      WiFi.config(IPAddress(stationCache.ip), IPAddress(stationCache.gateway),
+                  IPAddress(stationCache.subnet), IPAddress(stationCache.dns));
+      staticIPActive = true;
+    }
+#endif
+    WiFi.begin(stationSSID.c_str(), stationPassword.c_str(), stationCache.channel, stationCache.bssid);
+    return;
+  }
+  
+  if (staticIPActive) {
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);  // Zurück auf DHCP
+    staticIPActive = false;
   }
+  WiFi.begin(stationSSID.c_str(), stationPassword.c_str());
+}
+
+void NetworkManager::onStationEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+  // Läuft im WiFi-Ereignis-Task
+  uint32_t now = millis();
+  
+  portENTER_CRITICAL(&stationLock);
+  StationState before = stationControl.getState();
+  bool fast = stationControl.isFastAttempt();
+  bool counted = true;
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    stationControl.onConnected(now);
+  } else {
+    counted = stationControl.onDisconnected(now, info.wifi_sta_disconnected.reason);
+  }
+  StationLinkStats stats = stationControl.getStats(now);
+  portEXIT_CRITICAL(&stationLock);
   
-  return connectToWiFi(stationSSID.c_str(), stationPassword.c_str());
+  if (!counted) {
+    return;  // Trennung eines selbst abgebrochenen Versuchs
+  }
+  if (stats.state == STATION_CONNECTED && before != STATION_CONNECTED) {
+    Serial.printf("[NETWORK] Verbunden nach %u ms%s (%u ms seit Boot)! IP: %s\n",
+                  stats.lastConnectMs, fast ? " über Cache" : "", now,
+                  IPAddress(info.got_ip.ip_info.ip.addr).toString().c_str());
+  } else if (fast && event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    Serial.printf("[NETWORK] Schnellverbindung fehlgeschlagen (Grund %u) - normaler Verbindungsaufbau\n",
+                  info.wifi_sta_disconnected.reason);
+  } else if (stats.state == STATION_BACKOFF && before != STATION_BACKOFF) {
+    Serial.printf("[NETWORK] Station getrennt (Grund %u), nächster Versuch in %u ms\n",
+                  info.wifi_sta_disconnected.reason, stats.retryInMs);
+  }
 }
 
 bool NetworkManager::isStationEnabled() {
-  return stationEnabled;
+  portENTER_CRITICAL(&stationLock);
+  bool enabled = stationControl.getState() != STATION_IDLE;
+  portEXIT_CRITICAL(&stationLock);
+  return enabled;
 }
 
 bool NetworkManager::isStationConnected() {
-  return stationConnected;
+  portENTER_CRITICAL(&stationLock);
+  bool connected = stationControl.getState() == STATION_CONNECTED;
+  portEXIT_CRITICAL(&stationLock);
+  return connected;
+}
+
+StationLinkStats NetworkManager::getStationStats() {
+  portENTER_CRITICAL(&stationLock);
+  StationLinkStats stats = stationControl.getStats(millis());
+  portEXIT_CRITICAL(&stationLock);
+  return stats;
+}
+
+uint8_t NetworkManager::getLastDisconnectReason() {
+  portENTER_CRITICAL(&stationLock);
+  uint8_t reason = stationControl.getLastDisconnectReason();
+  portEXIT_CRITICAL(&stationLock);
+  return reason;
+}
+
+StationTiming NetworkManager::getStationTiming() {
+  portENTER_CRITICAL(&stationLock);
+  StationTiming result = stationControl.getTiming();
+  portEXIT_CRITICAL(&stationLock);
+  return result;
+}
+
+// ========== Station-Cache (NVS) ==========
+
+bool NetworkManager::loadStationCache() {
+  Preferences prefs;
+  if (!prefs.begin(WIFI_CACHE_NAMESPACE, true)) {
+    return false;  // Namespace existiert noch nicht
+  }
+  size_t length = prefs.getBytes(WIFI_CACHE_KEY, &stationCache, sizeof(stationCache));
+  prefs.end();
+  
+  cacheValid = length == sizeof(stationCache) &&
+               stationCache.version == WIFI_CACHE_VERSION &&
+               stationCache.ssid[0] != '\0';
+  if (!cacheValid) {
+    memset(&stationCache, 0, sizeof(stationCache));
+  }
+  stationCache.ssid[32] = '\0';
+  stationCache.password[64] = '\0';
+  return cacheValid;
+}
+
+void NetworkManager::saveStationCache() {
+  StationCache entry;
+  memset(&entry, 0, sizeof(entry));  // Gleiche Füllbytes für memcmp
+  entry.version = WIFI_CACHE_VERSION;
+  strncpy(entry.ssid, stationSSID.c_str(), sizeof(entry.ssid) - 1);
+  strncpy(entry.password, stationPassword.c_str(), sizeof(entry.password) - 1);
+  uint8_t* bssid = WiFi.BSSID();
+  if (bssid != nullptr) {
+    memcpy(entry.bssid, bssid, sizeof(entry.bssid));
+  }
+  entry.channel = WiFi.channel();
+  entry.ip = (uint32_t)WiFi.localIP();
+  entry.gateway = (uint32_t)WiFi.gatewayIP();
+  entry.subnet = (uint32_t)WiFi.subnetMask();
+  entry.dns = (uint32_t)WiFi.dnsIP();
+  
+  // Flash schonen: nur bei Änderung (neuer AP, Kanal oder Lease) schreiben
+  if (cacheValid && memcmp(&entry, &stationCache, sizeof(entry)) == 0) {
+    return;
+  }
+  
+  Preferences prefs;
+  if (!prefs.begin(WIFI_CACHE_NAMESPACE, false)) {
+    Serial.println("[NETWORK] NVS nicht verfügbar - Station nicht gespeichert");
+    return;
+  }
+  bool saved = prefs.putBytes(WIFI_CACHE_KEY, &entry, sizeof(entry)) == sizeof(entry);
+  prefs.end();
+  
+  if (saved) {
+    stationCache = entry;
+    cacheValid = true;
+    Serial.printf("[NETWORK] Station gespeichert: %s (Kanal %u)\n", entry.ssid, entry.channel);
+  }
+}
+
+void NetworkManager::clearStationCache() {
+  if (!cacheValid) {
+    return;
+  }
+  Preferences prefs;
+  if (prefs.begin(WIFI_CACHE_NAMESPACE, false)) {
+    prefs.remove(WIFI_CACHE_KEY);
+    prefs.end();
+  }
+  memset(&stationCache, 0, sizeof(stationCache));
+  cacheValid = false;
 }
 
 IPAddress NetworkManager::getStationIP() {
   return WiFi.localIP();
 }
 
-int NetworkManager::scanNetworks() {
-  Serial.println("[NETWORK] Scanne WiFi-Netzwerke...");
-  return WiFi.scanNetworks();
+// ========== WiFi-Scan (Hintergrund-Job) ==========
+
+uint32_t NetworkManager::requestScan(bool force) {
+  portENTER_CRITICAL(&scanLock);
+  bool fresh = scanJobId != 0 && millis() - scanDoneMs < WIFI_SCAN_CACHE_TTL_MS;
+  if (scanRunning || (fresh && !force)) {
+    // Gleichzeitige Anfragen teilen sich den laufenden Job bzw. den Cache
+    uint32_t job = scanJobId;
+    portEXIT_CRITICAL(&scanLock);
+    return job;
+  }
+  scanJobId++;
+  scanRunning = true;
+  // Alte Ergebnisse bleiben sichtbar, bis der neue Job etwas gefunden hat
+  scanPrevious = scanCount > 0;
+  uint32_t job = scanJobId;
+  portEXIT_CRITICAL(&scanLock);
+  
+  Serial.printf("[NETWORK] Scan-Job %u gestartet\n", job);
+  if (!startChannelScan(1)) {
+    finishScan();
+  }
+  return job;
+}
+
+bool NetworkManager::startChannelScan(uint8_t channel) {
+  scanChannel = channel;
+  scanChannelStartMs = millis();
+  // Asynchron, aktiv, ein Kanal - kehrt sofort zurück
+  int16_t result = WiFi.scanNetworks(true, false, false, WIFI_SCAN_MS_PER_CHANNEL, channel);
+  return result == WIFI_SCAN_RUNNING;
 }
 
-String NetworkManager::getScannedSSID(int index) {
-  return WiFi.SSID(index);
+void NetworkManager::onScanDone() {
+  // Läuft im WiFi-Ereignis-Task
+  if (!scanRunning) {
+    WiFi.scanDelete();
+    return;
+  }
+  
+  int16_t found = WiFi.scanComplete();
+  for (int16_t i = 0; i < found; i++) {
+    wifi_ap_record_t* record = (wifi_ap_record_t*)WiFi.getScanInfoByIndex(i);
+    if (record == nullptr || record->ssid[0] == '\0') {
+      continue;  // Versteckte Netze lassen sich hier nicht verbinden
+    }
+    
+    // Gleiche SSID auf mehreren APs/Kanälen: stärksten Eintrag behalten
+    portENTER_CRITICAL(&scanLock);
+    if (scanPrevious) {
+      scanCount = 0;
+      scanPrevious = false;
+    }
+    int slot = -1;
+    for (int k = 0; k < scanCount; k++) {
+      if (strncmp(scanResults[k].ssid, (const char*)record->ssid, 32) == 0) {
+        slot = record->rssi > scanResults[k].rssi ? k : -2;
+        break;
+      }
+    }
+    if (slot == -1 && scanCount < WIFI_SCAN_MAX_RESULTS) {
+      slot = scanCount++;
+    }
+    if (slot >= 0) {
+      WiFiNetwork& net = scanResults[slot];
+      strncpy(net.ssid, (const char*)record->ssid, 32);
+      net.ssid[32] = '\0';
+      net.rssi = record->rssi;
+      net.channel = record->primary;
+      net.encrypted = record->authmode != WIFI_AUTH_OPEN;
+    }
+    portEXIT_CRITICAL(&scanLock);
+  }
+  WiFi.scanDelete();
+  
+  if (scanChannel >= WIFI_SCAN_CHANNELS || !startChannelScan(scanChannel + 1)) {
+    finishScan();
+  }
 }
 
-int NetworkManager::getScannedRSSI(int index) {
-  return WiFi.RSSI(index);
+void NetworkManager::finishScan() {
+  portENTER_CRITICAL(&scanLock);
+  scanRunning = false;
+  if (scanPrevious) {
+    // Job ohne Fund: jetzt erst gilt das leere Ergebnis
+    scanCount = 0;
+    scanPrevious = false;
+  }
+  scanDoneMs = millis();
+  uint8_t count = scanCount;
+  portEXIT_CRITICAL(&scanLock);
+  
+  Serial.printf("[NETWORK] Scan-Job %u fertig: %u Netzwerke\n", scanJobId, count);
 }
 
-bool NetworkManager::getScannedEncryption(int index) {
-  return WiFi.encryptionType(index) != WIFI_AUTH_OPEN;
+int NetworkManager::getScanResults(WiFiNetwork* out, int maxCount, WiFiScanStatus& status) {
+  portENTER_CRITICAL(&scanLock);
+  int count = scanCount < maxCount ? scanCount : maxCount;
+  memcpy(out, scanResults, count * sizeof(WiFiNetwork));
+  status.jobId = scanJobId;
+  status.running = scanRunning;
+  status.channel = scanRunning ? scanChannel - 1 : WIFI_SCAN_CHANNELS;
+  status.count = scanCount;
+  status.ageMs = scanRunning ? 0 : millis() - scanDoneMs;
+  portEXIT_CRITICAL(&scanLock);
+  return count;
 }
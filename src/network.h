@@ -7,6 +7,8 @@
 
 #include <WiFi.h>
 #include <Arduino.h>
+#include <Preferences.h>
+#include "station_control.h"
 
 // AP-Konfiguration
 #define AP_SSID "ESPMAUS"
@@ -14,16 +16,87 @@
 #define AP_CHANNEL 6
 #define AP_MAX_CONNECTIONS 4
 
+// WiFi-Scan als Hintergrund-Job: Kanal für Kanal (der AP bleibt zwischen
+// den Kanälen erreichbar), Ergebnisse wachsen mit und bleiben im Cache
+#define WIFI_SCAN_MAX_RESULTS 24
+#define WIFI_SCAN_CHANNELS 13
+#define WIFI_SCAN_MS_PER_CHANNEL 120
+#define WIFI_SCAN_CACHE_TTL_MS 30000
+#define WIFI_SCAN_TIMEOUT_MS 5000  // Ohne SCAN_DONE-Ereignis Job beenden
+
+// Letzte erfolgreiche Station-Verbindung im NVS: beim Boot direkt mit
+// BSSID und Kanal (ohne Scan) und optional der bisherigen Adresse (ohne
+// DHCP) verbinden; scheitert das, folgt ein normaler Verbindungsaufbau
+#define WIFI_CACHE_NAMESPACE "wifi"
+#define WIFI_CACHE_KEY "station"
+#define WIFI_CACHE_VERSION 1
+#define WIFI_FAST_CONNECT_STATIC_IP 0  // 1 = gespeicherte Adresse ohne DHCP (Lease wird nicht erneuert)
+
+struct StationCache {
+  uint8_t version;
+  char ssid[33];
+  char password[65];
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;       // 0 = keine Adresse gespeichert
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+struct WiFiNetwork {
+  char ssid[33];
+  int8_t rssi;
+  uint8_t channel;
+  bool encrypted;
+};
+
+struct WiFiScanStatus {
+  uint32_t jobId;    // Fortlaufend, 0 = noch nie gescannt
+  bool running;
+  uint8_t channel;   // Zuletzt abgeschlossener Kanal
+  uint8_t count;
+  uint32_t ageMs;    // Alter des abgeschlossenen Ergebnisses
+};
+
 class NetworkManager {
 private:
   bool apEnabled;
-  bool stationEnabled;
-  bool stationConnected;
   
   String stationSSID;
   String stationPassword;
   
+  // Station-Verbindung (WiFi-Ereignis-Task meldet, loop() handelt)
+  StationControl stationControl;
+  portMUX_TYPE stationLock;
+  
+  // Schnellverbindung aus dem NVS-Cache
+  StationCache stationCache;
+  bool cacheValid;
+  bool staticIPActive;  // WiFi.config() mit Cache-Adresse gesetzt
+  
   IPAddress apIP;
+  
+  // WiFi-Scan (Ereignis-Task schreibt, Webserver-Task liest)
+  portMUX_TYPE scanLock;
+  WiFiNetwork scanResults[WIFI_SCAN_MAX_RESULTS];
+  uint8_t scanCount;
+  uint32_t scanJobId;
+  bool scanRunning;
+  bool scanPrevious;  // scanResults stammen noch vom vorigen Job
+  uint8_t scanChannel;
+  uint32_t scanChannelStartMs;
+  uint32_t scanDoneMs;
+  
+  void onStationEvent(WiFiEvent_t event, WiFiEventInfo_t info);
+  void beginAttempt(bool fast);
+  bool loadStationCache();
+  void saveStationCache();
+  void clearStationCache();
+  
+  bool startChannelScan(uint8_t channel);
+  void onScanDone();
+  void finishScan();
 
 public:
   NetworkManager();
@@ -37,19 +110,24 @@ public:
   const char* getAPPassword();
   IPAddress getAPIP();
   
-  // Station Mode
+  // Station Mode: connectToWiFi() startet nur den Versuch und kehrt sofort
+  // zurück; Verbinden und Wiederverbinden treibt update() voran
   bool connectToWiFi(const char* ssid, const char* password);
   void disconnectWiFi();
-  bool reconnectStation();
   bool isStationEnabled();
   bool isStationConnected();
   IPAddress getStationIP();
+  StationLinkStats getStationStats();
+  StationTiming getStationTiming();
+  uint8_t getLastDisconnectReason();
+  
+  // WiFi-Scanning: liefert die Job-ID; läuft bereits ein Job oder ist der
+  // Cache jünger als WIFI_SCAN_CACHE_TTL_MS, wird kein neuer gestartet
+  uint32_t requestScan(bool force);
   
-  // WiFi-Scanning
-  int scanNetworks();
-  String getScannedSSID(int index);
-  int getScannedRSSI(int index);
-  bool getScannedEncryption(int index);
+  // Ergebnisse kopieren (auch Zwischenstand eines laufenden Jobs; bis zum
+  // ersten Fund des neuen Jobs die des vorigen)
+  int getScanResults(WiFiNetwork* out, int maxCount, WiFiScanStatus& status);
 };
 
 #endif
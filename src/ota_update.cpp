@@ -0,0 +1,234 @@
+/**
+ * OTA-Update Implementierung
+ */
+
+#include "ota_update.h"
+#include <Update.h>
+#include <new>
+
+static bool parseHex(const char* hex, uint8_t* out, size_t length) {
+  if (hex == nullptr || strlen(hex) != length * 2) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    char byte[3] = {hex[i * 2], hex[i * 2 + 1], '\0'};
+    char* end;
+    out[i] = (uint8_t)strtoul(byte, &end, 16);
+    if (*end != '\0') {
+      return false;
+    }
+  }
+  return true;
+}
+
+OtaUpdater::OtaUpdater() {
+  memset(&stats, 0, sizeof(stats));
+  startMs = 0;
+  error = nullptr;
+  headerLength = 0;
+  headerDone = false;
+  verifyHash = false;
+  decoder = nullptr;
+  writer = nullptr;
+  mbedtls_sha256_init(&sha);
+}
+
+OtaUpdater::~OtaUpdater() {
+  releaseDecoder();
+  mbedtls_sha256_free(&sha);
+}
+
+void OtaUpdater::begin(const char* expectedSha256, uint32_t uploadSize) {
+  if (stats.active) {
+    abort();
+  }
+  
+  memset(&stats, 0, sizeof(stats));
+  stats.active = true;
+  stats.uploadSize = uploadSize;
+  startMs = millis();
+  error = nullptr;
+  headerLength = 0;
+  headerDone = false;
+  verifyHash = parseHex(expectedSha256, expectedHash, OTA_HASH_SIZE);
+  releaseDecoder();
+  
+  mbedtls_sha256_free(&sha);
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+}
+
+bool OtaUpdater::startImage(uint32_t size) {
+  stats.imageSize = size;
+  if (!Update.begin(size ? size : UPDATE_SIZE_UNKNOWN)) {
+    Update.printError(Serial);
+    fail("Update.begin fehlgeschlagen");
+    return false;
+  }
+  return true;
+}
+
+bool OtaUpdater::process(const uint8_t* data, size_t length) {
+  if (!stats.active || error != nullptr) {
+    return false;
+  }
+  if (stats.uploadSize && stats.received + length > stats.uploadSize) {
+    fail("Mehr Daten als angekündigt");
+    return false;
+  }
+  stats.received += length;
+  
+  // Kopf erkennen: komprimierte Images beginnen mit "LZS1", rohe mit 0xE9
+  while (!headerDone && length > 0) {
+    if (headerLength == 0 && data[0] != OTA_COMPRESSED_MAGIC[0]) {
+      headerDone = true;
+      if (!startImage(0)) {
+        return false;
+      }
+      break;
+    }
+    
+    header[headerLength++] = *data++;
+    length--;
+    
+    if (headerLength == 4 && memcmp(header, OTA_COMPRESSED_MAGIC, 4) != 0) {
+      fail("Unbekanntes Image-Format");
+      return false;
+    }
+    if (headerLength == OTA_HEADER_SIZE) {
+      headerDone = true;
+      stats.compressed = true;
+      uint32_t size = header[4] | header[5] << 8 | header[6] << 16 | (uint32_t)header[7] << 24;
+      memcpy(expectedHash, &header[8], OTA_HASH_SIZE);
+      verifyHash = true;
+      
+      decoder = new (std::nothrow) LzssDecoder();
+      if (decoder == nullptr) {
+        fail("Kein Speicher für den Entpacker");
+        return false;
+      }
+      if (!startImage(size)) {
+        return false;
+      }
+    }
+  }
+  
+  if (length == 0 || !headerDone) {
+    return true;
+  }
+  
+  bool ok = stats.compressed ? decoder->feed(data, length, *this) : write(data, length);
+  if (!ok) {
+    if (error == nullptr) {
+      fail("Fehlerhafter komprimierter Datenstrom");
+    }
+    releaseDecoder();  // Erst nach feed(), fail() läuft ggf. darin
+  }
+  return ok;
+}
+
+bool OtaUpdater::write(const uint8_t* data, size_t length) {
+  if (error != nullptr) {
+    return false;
+  }
+  if (stats.imageSize && stats.written + length > stats.imageSize) {
+    fail("Image größer als angegeben");
+    return false;
+  }
+  
+  mbedtls_sha256_update(&sha, data, length);
+  if (Update.write((uint8_t*)data, length) != length) {
+    Update.printError(Serial);
+    fail("Flash-Schreibfehler");
+    return false;
+  }
+  stats.written += length;
+  return true;
+}
+
+bool OtaUpdater::finish() {
+  if (!stats.active) {
+    return false;
+  }
+  
+  if (error == nullptr && !headerDone) {
+    fail("Leerer Upload");
+  }
+  if (error == nullptr && decoder != nullptr && !decoder->flush(*this) && error == nullptr) {
+    fail("Komprimierter Datenstrom unvollständig");
+  }
+  if (error == nullptr && stats.imageSize && stats.written != stats.imageSize) {
+    fail("Image unvollständig");
+  }
+  
+  if (error == nullptr && verifyHash) {
+    uint8_t digest[OTA_HASH_SIZE];
+    mbedtls_sha256_finish(&sha, digest);
+    if (memcmp(digest, expectedHash, OTA_HASH_SIZE) != 0) {
+      fail("SHA-256 stimmt nicht");
+    }
+  }
+  
+  if (error == nullptr && !Update.end(true)) {
+    Update.printError(Serial);
+    fail("Update.end fehlgeschlagen");
+  }
+  
+  releaseDecoder();
+  stats.active = false;
+  stats.success = error == nullptr;
+  stats.durationMs = millis() - startMs;
+  
+  uint32_t ms = stats.durationMs ? stats.durationMs : 1;
+  Serial.printf("[OTA] %s: %u Bytes übertragen, %u Bytes Image in %u ms "
+                "(%u KB/s Übertragung, %u KB/s effektiv)%s\n",
+                stats.success ? "Erfolgreich" : "Fehlgeschlagen",
+                stats.received, stats.written, stats.durationMs,
+                stats.received / ms, stats.written / ms,
+                stats.compressed ? " [komprimiert]" : "");
+  return stats.success;
+}
+
+void OtaUpdater::abort() {
+  if (stats.active && headerDone) {
+    Update.abort();
+  }
+  releaseDecoder();
+  stats.active = false;
+}
+
+bool OtaUpdater::claim(const void* request, uint32_t offset) {
+  if (!stats.active || error != nullptr || writer != nullptr || offset != stats.received) {
+    return false;
+  }
+  writer = request;
+  return true;
+}
+
+bool OtaUpdater::release(const void* request) {
+  if (!isWriter(request)) {
+    return false;
+  }
+  writer = nullptr;
+  return true;
+}
+
+void OtaUpdater::fail(const char* message) {
+  if (error == nullptr) {
+    error = message;
+    Serial.printf("[OTA] Fehler: %s\n", message);
+  }
+  if (stats.active && headerDone) {
+    Update.abort();
+  }
+  // Sitzung beenden: loop() zeigt den Fehler, ein neues begin() startet neu
+  if (stats.active) {
+    stats.active = false;
+    stats.durationMs = millis() - startMs;
+  }
+}
+
+void OtaUpdater::releaseDecoder() {
+  delete decoder;
+  decoder = nullptr;
+}
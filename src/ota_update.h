@@ -0,0 +1,85 @@
+/**
+ * OTA-Update aus dem Web-Upload: rohe .bin oder LZSS-komprimiert
+ * (tools/ota_compress.py), Entpacken in festen Puffern während die
+ * Stücke eintreffen, SHA-256-Prüfung vor Update.end()
+ */
+
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <Arduino.h>
+#include <mbedtls/sha256.h>
+#include "lzss.h"
+
+// Kopf komprimierter Images: "LZS1", Originalgröße (u32 LE), SHA-256
+#define OTA_COMPRESSED_MAGIC "LZS1"
+#define OTA_HEADER_SIZE 40
+#define OTA_HASH_SIZE 32
+
+struct OtaStats {
+  bool active;
+  bool compressed;
+  bool success;
+  uint32_t uploadSize;  // Angekündigte Upload-Größe (0 = unbekannt)
+  uint32_t received;    // Übertragene Bytes = Offset zum Fortsetzen
+  uint32_t written;     // Geschriebene Image-Bytes
+  uint32_t imageSize;   // Erwartete Größe (0 = unbekannt)
+  uint32_t durationMs;
+};
+
+class OtaUpdater : private OtaSink {
+private:
+  OtaStats stats;
+  uint32_t startMs;
+  const char* error;
+
+  uint8_t header[OTA_HEADER_SIZE];
+  size_t headerLength;
+  bool headerDone;
+
+  uint8_t expectedHash[OTA_HASH_SIZE];
+  bool verifyHash;
+  mbedtls_sha256_context sha;
+
+  LzssDecoder* decoder;  // Nur während komprimierter Uploads (~5 KB)
+  const void* writer;    // Request, der gerade schreibt (nullptr = frei)
+
+  bool write(const uint8_t* data, size_t length) override;
+  bool startImage(uint32_t size);
+  void fail(const char* message);
+  void releaseDecoder();
+
+public:
+  OtaUpdater();
+  ~OtaUpdater();
+
+  // Neuer Upload; expectedSha256 (64 Hex-Zeichen) prüft auch rohe Images
+  void begin(const char* expectedSha256 = nullptr, uint32_t uploadSize = 0);
+
+  // Empfangenes Stück verarbeiten
+  bool process(const uint8_t* data, size_t length);
+
+  // Hash und Größe prüfen, dann Update.end()
+  bool finish();
+  void abort();
+
+  // Schreibrecht für einen Request: immer nur einer, und nur genau am
+  // aktuellen Offset. release() wirkt nur für den Inhaber.
+  bool claim(const void* request, uint32_t offset);
+  bool release(const void* request);
+  bool isWriter(const void* request) const { return request != nullptr && request == writer; }
+  bool isClaimed() const { return writer != nullptr; }
+
+  // Der Upload lässt sich an getOffset() fortsetzen, solange er aktiv ist:
+  // Entpacker und Hash laufen über die Unterbrechung hinweg weiter.
+  // Ein Fehler beendet die Sitzung, getError() bleibt bis zum nächsten begin().
+  bool isActive() const { return stats.active; }
+  uint32_t getOffset() const { return stats.received; }
+  bool isComplete() const { return stats.uploadSize && stats.received >= stats.uploadSize; }
+
+  bool hasError() const { return error != nullptr; }
+  const char* getError() const { return error; }
+  OtaStats getStats() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * Report-Queue-Implementierung
+ *
+ * head wird nur vom Producer geschrieben, tail nur vom Consumer.
+ * Die Indizes laufen frei über (uint32_t) und werden per Maske
+ * auf die Slots abgebildet.
+ */
+
+#include "report_queue.h"
+#include <string.h>
+
+static_assert((REPORT_QUEUE_CAPACITY & (REPORT_QUEUE_CAPACITY - 1)) == 0,
+              "REPORT_QUEUE_CAPACITY muss eine Zweierpotenz sein");
+
+static const uint32_t REPORT_QUEUE_MASK = REPORT_QUEUE_CAPACITY - 1;
+
+ReportQueue::ReportQueue() {
+  head.store(0, std::memory_order_relaxed);
+  pushedCount.store(0, std::memory_order_relaxed);
+  droppedCount.store(0, std::memory_order_relaxed);
+  truncatedCount.store(0, std::memory_order_relaxed);
+
+  tail.store(0, std::memory_order_relaxed);
+  poppedCount.store(0, std::memory_order_relaxed);
+  highWaterMark.store(0, std::memory_order_relaxed);
+}
+
+bool ReportQueue::push(uint32_t timestampUs, uint8_t source, uint8_t reportId,
+                       const uint8_t* data, size_t length) {
+  uint32_t h = head.load(std::memory_order_relaxed);
+  uint32_t t = tail.load(std::memory_order_acquire);
+
+  if (h - t >= REPORT_QUEUE_CAPACITY) {
+    // Queue voll - neuesten Report verwerfen (Consumer besitzt tail)
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (length > REPORT_MAX_SIZE) {
+    truncatedCount.fetch_add(1, std::memory_order_relaxed);
+    length = REPORT_MAX_SIZE;
+  }
+
+  RawMouseReport& slot = slots[h & REPORT_QUEUE_MASK];
+  slot.timestampUs = timestampUs;
+  slot.source = source;
+  slot.reportId = reportId;
+  slot.length = (uint8_t)length;
+  memcpy(slot.data, data, length);
+
+  // Slot-Inhalt vor dem neuen head sichtbar machen
+  head.store(h + 1, std::memory_order_release);
+  pushedCount.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool ReportQueue::pop(RawMouseReport& report) {
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  uint32_t h = head.load(std::memory_order_acquire);
+
+  if (h == t) {
+    return false;
+  }
+
+  uint32_t fill = h - t;
+  if (fill > highWaterMark.load(std::memory_order_relaxed)) {
+    highWaterMark.store(fill, std::memory_order_relaxed);
+  }
+
+  report = slots[t & REPORT_QUEUE_MASK];
+
+  // Slot erst nach dem Kopieren freigeben
+  tail.store(t + 1, std::memory_order_release);
+  poppedCount.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ReportQueue::clear() {
+  tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+uint32_t ReportQueue::size() const {
+  uint32_t h = head.load(std::memory_order_acquire);
+  uint32_t t = tail.load(std::memory_order_acquire);
+  return h - t;
+}
+
+ReportQueueStats ReportQueue::getStats() const {
+  ReportQueueStats stats;
+  stats.pushed = pushedCount.load(std::memory_order_relaxed);
+  stats.popped = poppedCount.load(std::memory_order_relaxed);
+  stats.dropped = droppedCount.load(std::memory_order_relaxed);
+  stats.truncated = truncatedCount.load(std::memory_order_relaxed);
+  stats.highWater = highWaterMark.load(std::memory_order_relaxed);
+  return stats;
+}
@@ -0,0 +1,67 @@
+/**
+ * Lock-freie Report-Queue (Single Producer / Single Consumer)
+ * Producer: HID-/Transport-Callbacks, Consumer: MouseHandler::update()
+ */
+
+#ifndef REPORT_QUEUE_H
+#define REPORT_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// Queue-Konfiguration
+#define REPORT_QUEUE_CAPACITY 64   // Muss Zweierpotenz sein
+#define REPORT_MAX_SIZE 16         // Max. Bytes pro Roh-Report
+#define REPORT_QUEUE_ALIGN 64      // Cache-Line (ESP32: 32, Host: 64)
+
+// Roher, zeitgestempelter Maus-Report
+struct RawMouseReport {
+  uint32_t timestampUs;  // Eingangszeitpunkt (micros())
+  uint8_t source;        // MouseType der Quelle
+  uint8_t reportId;
+  uint8_t length;
+  uint8_t data[REPORT_MAX_SIZE];
+};
+
+// Queue-Statistik (Überlauf-Zähler etc.)
+struct ReportQueueStats {
+  uint32_t pushed;
+  uint32_t popped;
+  uint32_t dropped;    // Queue voll, Report verworfen
+  uint32_t truncated;  // Report länger als REPORT_MAX_SIZE
+  uint32_t highWater;  // Max. Füllstand
+};
+
+class ReportQueue {
+private:
+  // Producer-Seite (eigene Cache-Line)
+  alignas(REPORT_QUEUE_ALIGN) std::atomic<uint32_t> head;
+  std::atomic<uint32_t> pushedCount;
+  std::atomic<uint32_t> droppedCount;
+  std::atomic<uint32_t> truncatedCount;
+
+  // Consumer-Seite (eigene Cache-Line)
+  alignas(REPORT_QUEUE_ALIGN) std::atomic<uint32_t> tail;
+  std::atomic<uint32_t> poppedCount;
+  std::atomic<uint32_t> highWaterMark;
+
+  alignas(REPORT_QUEUE_ALIGN) RawMouseReport slots[REPORT_QUEUE_CAPACITY];
+
+public:
+  ReportQueue();
+
+  // Producer (nur ein Task!)
+  bool push(uint32_t timestampUs, uint8_t source, uint8_t reportId,
+            const uint8_t* data, size_t length);
+
+  // Consumer (nur ein Task!)
+  bool pop(RawMouseReport& report);
+  void clear();
+
+  // Von beliebigem Task lesbar
+  uint32_t size() const;
+  ReportQueueStats getStats() const;
+};
+
+#endif
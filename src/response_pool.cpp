@@ -0,0 +1,72 @@
+/**
+ * Antwortpuffer-Pool Implementierung
+ */
+
+#include "response_pool.h"
+#include <stdlib.h>
+
+ResponsePool::ResponsePool() {
+  memory = nullptr;
+  bufferSize = 0;
+  slotCount = 0;
+  for (int i = 0; i < RESPONSE_POOL_MAX_SLOTS; i++) {
+    busy[i].store(false, std::memory_order_relaxed);
+  }
+  acquiredCount.store(0, std::memory_order_relaxed);
+  exhaustedCount.store(0, std::memory_order_relaxed);
+  oversizeCount.store(0, std::memory_order_relaxed);
+  inUseCount.store(0, std::memory_order_relaxed);
+  highWaterMark.store(0, std::memory_order_relaxed);
+}
+
+ResponsePool::~ResponsePool() {
+  free(memory);
+}
+
+bool ResponsePool::begin(int slots, size_t size) {
+  if (memory != nullptr || slots <= 0 || slots > RESPONSE_POOL_MAX_SLOTS) {
+    return false;
+  }
+  memory = (uint8_t*)malloc(slots * size);
+  if (memory == nullptr) {
+    return false;
+  }
+  slotCount = slots;
+  bufferSize = size;
+  return true;
+}
+
+int ResponsePool::acquire() {
+  for (int i = 0; i < slotCount; i++) {
+    bool expected = false;
+    if (busy[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      acquiredCount.fetch_add(1, std::memory_order_relaxed);
+      uint8_t inUse = inUseCount.fetch_add(1, std::memory_order_relaxed) + 1;
+      if (inUse > highWaterMark.load(std::memory_order_relaxed)) {
+        highWaterMark.store(inUse, std::memory_order_relaxed);
+      }
+      return i;
+    }
+  }
+  exhaustedCount.fetch_add(1, std::memory_order_relaxed);
+  return -1;
+}
+
+void ResponsePool::release(int slot) {
+  if (slot < 0 || slot >= slotCount) {
+    return;
+  }
+  if (busy[slot].exchange(false, std::memory_order_release)) {
+    inUseCount.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+ResponsePoolStats ResponsePool::getStats() const {
+  ResponsePoolStats stats;
+  stats.acquired = acquiredCount.load(std::memory_order_relaxed);
+  stats.exhausted = exhaustedCount.load(std::memory_order_relaxed);
+  stats.oversize = oversizeCount.load(std::memory_order_relaxed);
+  stats.inUse = inUseCount.load(std::memory_order_relaxed);
+  stats.highWater = highWaterMark.load(std::memory_order_relaxed);
+  return stats;
+}
@@ -0,0 +1,56 @@
+/**
+ * Pool vorab reservierter Antwortpuffer für JSON-Antworten
+ * Handler serialisieren direkt in einen freien Puffer; er wird erst nach
+ * dem Senden (Verbindungsende) zurückgegeben. Kein String, keine
+ * Allokation pro Request - der Heap fragmentiert auch bei Dauerabfrage nicht.
+ * Ohne Arduino-Abhängigkeiten, acquire/release sind threadsicher.
+ */
+
+#ifndef RESPONSE_POOL_H
+#define RESPONSE_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define RESPONSE_POOL_MAX_SLOTS 8
+
+struct ResponsePoolStats {
+  uint32_t acquired;
+  uint32_t exhausted;  // Kein Puffer frei
+  uint32_t oversize;   // Antwort größer als ein Puffer
+  uint8_t inUse;
+  uint8_t highWater;
+};
+
+class ResponsePool {
+private:
+  uint8_t* memory;
+  size_t bufferSize;
+  int slotCount;
+  std::atomic<bool> busy[RESPONSE_POOL_MAX_SLOTS];
+  std::atomic<uint32_t> acquiredCount;
+  std::atomic<uint32_t> exhaustedCount;
+  std::atomic<uint32_t> oversizeCount;
+  std::atomic<uint8_t> inUseCount;
+  std::atomic<uint8_t> highWaterMark;
+
+public:
+  ResponsePool();
+  ~ResponsePool();
+
+  // Einmalig beim Start: slots Puffer zu je size Bytes
+  bool begin(int slots, size_t size);
+
+  // Freien Puffer belegen, -1 wenn alle belegt sind
+  int acquire();
+  void release(int slot);
+
+  uint8_t* getBuffer(int slot) { return memory + slot * bufferSize; }
+  size_t getBufferSize() const { return bufferSize; }
+
+  void countOversize() { oversizeCount.fetch_add(1, std::memory_order_relaxed); }
+  ResponsePoolStats getStats() const;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * Bildschirm-Spiegelung Implementierung
+ */
+
+#include "screen_mirror.h"
+#include <string.h>
+
+// ========== TileSet ==========
+
+void TileSet::clear() {
+  memset(bits, 0, sizeof(bits));
+}
+
+bool TileSet::any() const {
+  for (size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+    if (bits[i]) return true;
+  }
+  return false;
+}
+
+void TileSet::merge(const TileSet& other) {
+  for (size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+    bits[i] |= other.bits[i];
+  }
+}
+
+// ========== ScreenMirror ==========
+
+ScreenMirror::ScreenMirror(int16_t w, int16_t h) {
+  width = w;
+  height = h;
+  tilesX = (w + MIRROR_TILE_SIZE - 1) / MIRROR_TILE_SIZE;
+  tilesY = (h + MIRROR_TILE_SIZE - 1) / MIRROR_TILE_SIZE;
+  changed.clear();
+}
+
+void ScreenMirror::markRect(const Rect& rect) {
+  Rect r = rect.intersect(Rect::make(0, 0, width, height));
+  if (r.isEmpty()) {
+    return;
+  }
+
+  for (int ty = r.y / MIRROR_TILE_SIZE; ty <= (r.y + r.h - 1) / MIRROR_TILE_SIZE; ty++) {
+    for (int tx = r.x / MIRROR_TILE_SIZE; tx <= (r.x + r.w - 1) / MIRROR_TILE_SIZE; tx++) {
+      changed.set(ty * tilesX + tx);
+    }
+  }
+}
+
+void ScreenMirror::markAll() {
+  fillAll(changed);
+}
+
+void ScreenMirror::takeChanged(TileSet& out) {
+  out = changed;
+  changed.clear();
+}
+
+void ScreenMirror::fillAll(TileSet& set) const {
+  set.clear();
+  for (int i = 0; i < getTileCount(); i++) {
+    set.set(i);
+  }
+}
+
+size_t ScreenMirror::encodeTile(const uint16_t* pixels, int tile, uint8_t* out) const {
+  int x0 = (tile % tilesX) * MIRROR_TILE_SIZE;
+  int y0 = (tile / tilesX) * MIRROR_TILE_SIZE;
+  int w = width - x0 < MIRROR_TILE_SIZE ? width - x0 : MIRROR_TILE_SIZE;
+  int h = height - y0 < MIRROR_TILE_SIZE ? height - y0 : MIRROR_TILE_SIZE;
+
+  size_t n = 0;
+  out[n++] = (uint8_t)(tile % tilesX);
+  out[n++] = (uint8_t)(tile / tilesX);
+
+  // Läufe gleicher Farbe in Zeilenreihenfolge (auch über Zeilenenden hinweg)
+  uint16_t runColor = 0;
+  int runLength = 0;
+  for (int y = y0; y < y0 + h; y++) {
+    const uint16_t* row = &pixels[y * width + x0];
+    for (int x = 0; x < w; x++) {
+      uint16_t color = DisplayBackend::toBusOrder(row[x]);
+      if (runLength > 0 && (color != runColor || runLength == 255)) {
+        out[n++] = (uint8_t)runLength;
+        out[n++] = runColor & 0xFF;
+        out[n++] = runColor >> 8;
+        runLength = 0;
+      }
+      runColor = color;
+      runLength++;
+    }
+  }
+  out[n++] = (uint8_t)runLength;
+  out[n++] = runColor & 0xFF;
+  out[n++] = runColor >> 8;
+  return n;
+}
+
+size_t ScreenMirror::encode(const MemoryBackend& source, TileSet& pending,
+                            uint8_t* out, size_t maxLength) const {
+  const size_t worstCase = 2 + 3 * MIRROR_TILE_SIZE * MIRROR_TILE_SIZE;
+  const uint16_t* pixels = source.getBuffer();
+  if (pixels == nullptr || maxLength < MIRROR_HEADER_SIZE + worstCase) {
+    return 0;
+  }
+
+  size_t n = MIRROR_HEADER_SIZE;
+  uint16_t count = 0;
+
+  for (int tile = 0; tile < getTileCount(); tile++) {
+    if (!pending.test(tile)) {
+      continue;
+    }
+    if (maxLength - n < worstCase) {
+      break;  // Rest in der nächsten Nachricht
+    }
+    n += encodeTile(pixels, tile, &out[n]);
+    pending.reset(tile);
+    count++;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  out[0] = MIRROR_MAGIC;
+  out[1] = MIRROR_VERSION;
+  out[2] = count & 0xFF;
+  out[3] = count >> 8;
+  return n;
+}
@@ -0,0 +1,69 @@
+/**
+ * Bildschirm-Spiegelung: sammelt geänderte 16x16-Kacheln und kodiert sie
+ * lauflängenkomprimiert (RGB565) für die WebSocket-Übertragung.
+ *
+ * Nachricht (little-endian):
+ *   'M', Version, Anzahl Kacheln (u16)
+ *   je Kachel: Spalte (u8), Zeile (u8), dann Läufe aus
+ *              Anzahl (u8, 1..255) + Farbe (u16 RGB565) bis die Kachel voll ist
+ * Randkacheln sind entsprechend kleiner. Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef SCREEN_MIRROR_H
+#define SCREEN_MIRROR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "dirty_rect.h"
+#include "display_backend.h"
+
+#define MIRROR_TILE_SIZE 16
+#define MIRROR_MAX_TILES 256
+#define MIRROR_MAGIC 'M'
+#define MIRROR_VERSION 1
+#define MIRROR_HEADER_SIZE 4
+
+// Bitmenge über alle Kacheln
+struct TileSet {
+  uint32_t bits[MIRROR_MAX_TILES / 32];
+
+  void clear();
+  bool any() const;
+  void merge(const TileSet& other);
+  void set(int tile) { bits[tile >> 5] |= 1u << (tile & 31); }
+  void reset(int tile) { bits[tile >> 5] &= ~(1u << (tile & 31)); }
+  bool test(int tile) const { return bits[tile >> 5] & (1u << (tile & 31)); }
+};
+
+class ScreenMirror {
+private:
+  int16_t width;
+  int16_t height;
+  int tilesX;
+  int tilesY;
+  TileSet changed;  // Seit dem letzten takeChanged()
+
+  size_t encodeTile(const uint16_t* pixels, int tile, uint8_t* out) const;
+
+public:
+  ScreenMirror(int16_t width, int16_t height);
+
+  // Vom Compositor: Bereich wurde neu übertragen
+  void markRect(const Rect& rect);
+  void markAll();
+
+  // Geänderte Kacheln abholen (werden zurückgesetzt)
+  void takeChanged(TileSet& out);
+
+  // Alle Kacheln als ausstehend markieren (z.B. für neue Clients)
+  void fillAll(TileSet& set) const;
+
+  // So viele ausstehende Kacheln kodieren, wie in out passen; kodierte
+  // Kacheln werden aus pending entfernt. Liefert die Nachrichtenlänge.
+  size_t encode(const MemoryBackend& source, TileSet& pending,
+                uint8_t* out, size_t maxLength) const;
+
+  int getTileCount() const { return tilesX * tilesY; }
+};
+
+#endif
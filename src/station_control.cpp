@@ -0,0 +1,101 @@
+/**
+ * Station-Ablaufsteuerung Implementierung
+ */
+
+#include "station_control.h"
+#include <string.h>
+
+StationControl::StationControl() {
+  fastConnect = false;
+  fastAttempt = false;
+  pendingAborts = 0;
+  cacheDirty = false;
+  lastDisconnectReason = 0;
+  memset(&timing, 0, sizeof(timing));
+}
+
+void StationControl::expectAbort() {
+  // Nur ein laufender Treiber meldet die Trennung
+  StationState state = link.getState();
+  if ((state == STATION_CONNECTING || state == STATION_CONNECTED) && pendingAborts < UINT8_MAX) {
+    pendingAborts++;
+  }
+}
+
+void StationControl::start(uint32_t nowMs, bool fast) {
+  fastConnect = fast;
+  fastAttempt = false;
+  link.start(nowMs);
+}
+
+void StationControl::stop() {
+  expectAbort();
+  link.stop();
+  fastConnect = false;
+  fastAttempt = false;
+}
+
+StationCommand StationControl::update(uint32_t nowMs) {
+  StationCommand command;
+  command.action = link.update(nowMs);
+  command.fast = false;
+
+  if (command.action == STATION_ACTION_CONNECT) {
+    command.fast = fastConnect;
+    fastConnect = false;
+    fastAttempt = command.fast;
+  } else if (command.action == STATION_ACTION_DISCONNECT) {
+    // Timeout im Verbindungsaufbau: der Aufrufer bricht den Versuch ab
+    if (pendingAborts < UINT8_MAX) {
+      pendingAborts++;
+    }
+    if (fastAttempt) {
+      // Schnellverbindung hängt: sofort normal verbinden statt Backoff
+      fastAttempt = false;
+      link.start(nowMs);
+    }
+  }
+
+  command.attempt = link.getStats(nowMs).attempts;
+  command.saveCache = cacheDirty;
+  cacheDirty = false;
+  return command;
+}
+
+void StationControl::onConnected(uint32_t nowMs) {
+  StationState before = link.getState();
+  bool fast = fastAttempt;
+  link.onConnected(nowMs);
+  fastAttempt = false;
+  if (before == STATION_CONNECTED || link.getState() != STATION_CONNECTED) {
+    return;
+  }
+
+  // Ältere Trennungen kommen vor der neuen Verbindung - keine mehr offen
+  pendingAborts = 0;
+  timing.lastFast = fast;
+  if (timing.bootConnectMs == 0) {
+    timing.bootConnectMs = nowMs;
+    timing.bootFast = fast;
+  }
+  cacheDirty = true;
+}
+
+bool StationControl::onDisconnected(uint32_t nowMs, uint8_t reason) {
+  lastDisconnectReason = reason;
+
+  // Nachzügler eines selbst abgebrochenen oder ersetzten Versuchs
+  if (reason == STATION_REASON_ASSOC_LEAVE && pendingAborts > 0) {
+    pendingAborts--;
+    return false;
+  }
+
+  if (fastAttempt && link.getState() == STATION_CONNECTING) {
+    // Cache passt nicht (AP/Kanal gewechselt): sofort normal verbinden
+    fastAttempt = false;
+    link.start(nowMs);
+  } else {
+    link.onDisconnected(nowMs);
+  }
+  return true;
+}
@@ -0,0 +1,75 @@
+/**
+ * Ablaufsteuerung der Station-Verbindung zwischen WiFi-Ereignis-Task und
+ * loop(): Schnellverbindung aus dem NVS-Cache, Zeitmessung bis zur ersten
+ * Verbindung und das Aussortieren von STA_DISCONNECTED-Ereignissen, die
+ * zu einem selbst abgebrochenen Versuch gehören. Ohne Arduino-Abhängigkeiten
+ * (Sperre und WiFi-Aufrufe beim Aufrufer).
+ */
+
+#ifndef STATION_CONTROL_H
+#define STATION_CONTROL_H
+
+#include <stdint.h>
+#include "station_link.h"
+
+// Grund, den der Treiber nach eigenem esp_wifi_disconnect() meldet
+// (WIFI_REASON_ASSOC_LEAVE) - auch wenn WiFi.begin() einen Versuch ersetzt
+#define STATION_REASON_ASSOC_LEAVE 8
+
+// Zeit vom Boot bis zur ersten Station-Verbindung (millis() bei GOT_IP)
+struct StationTiming {
+  uint32_t bootConnectMs;  // 0 = seit dem Boot noch nicht verbunden
+  bool bootFast;           // Über den NVS-Cache verbunden
+  bool cached;             // Gültiger Cache beim Boot vorhanden
+  bool lastFast;           // Letzte Verbindung über den Cache
+};
+
+// Was loop() nach update() am Treiber tun soll
+struct StationCommand {
+  StationAction action;
+  bool fast;         // CONNECT über BSSID/Kanal aus dem Cache
+  uint32_t attempt;  // Nummer des gestarteten Versuchs
+  bool saveCache;    // Verbunden - Cache aus loop() schreiben (NVS)
+};
+
+class StationControl {
+private:
+  StationLink link;
+  bool fastConnect;      // Nächster Versuch nutzt den Cache
+  bool fastAttempt;      // Laufender Versuch nutzt den Cache
+  uint8_t pendingAborts; // Eigene Trennungen, deren Ereignis noch aussteht
+  bool cacheDirty;
+  uint8_t lastDisconnectReason;
+  StationTiming timing;
+
+  void expectAbort();
+
+public:
+  StationControl();
+
+  void seed(uint32_t value) { link.seed(value); }
+
+  // Neuer Verbindungsaufbau (Boot aus dem Cache: fast = true)
+  void start(uint32_t nowMs, bool fast);
+
+  // Verbindung aufgeben; der Aufrufer trennt danach selbst (WiFi.disconnect)
+  void stop();
+
+  // Aus loop(): fällige Versuche und Timeouts. Bei DISCONNECT trennt der
+  // Aufrufer - das Ereignis dazu wird dann nicht als Fehlschlag gezählt.
+  StationCommand update(uint32_t nowMs);
+
+  // Ereignisse aus dem WiFi-Task (GOT_IP / STA_DISCONNECTED); false, wenn
+  // das Ereignis zu einem abgebrochenen Versuch gehörte und ignoriert wurde
+  void onConnected(uint32_t nowMs);
+  bool onDisconnected(uint32_t nowMs, uint8_t reason);
+
+  StationState getState() const { return link.getState(); }
+  StationLinkStats getStats(uint32_t nowMs) const { return link.getStats(nowMs); }
+  bool isFastAttempt() const { return fastAttempt; }
+  uint8_t getLastDisconnectReason() const { return lastDisconnectReason; }
+  StationTiming getTiming() const { return timing; }
+  void setCached(bool cached) { timing.cached = cached; }
+};
+
+#endif
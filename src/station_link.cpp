@@ -0,0 +1,126 @@
+/**
+ * Station-Zustandsautomat Implementierung
+ */
+
+#include "station_link.h"
+
+StationLink::StationLink() {
+  state = STATION_IDLE;
+  stateSinceMs = 0;
+  retryAtMs = 0;
+  attempts = 0;
+  failures = 0;
+  lastConnectMs = 0;
+  jitterState = 0x9E3779B9;
+}
+
+void StationLink::seed(uint32_t value) {
+  // xorshift darf nicht bei 0 starten
+  jitterState = value != 0 ? value : 0x9E3779B9;
+}
+
+uint32_t StationLink::nextRandom() {
+  jitterState ^= jitterState << 13;
+  jitterState ^= jitterState >> 17;
+  jitterState ^= jitterState << 5;
+  return jitterState;
+}
+
+uint32_t StationLink::backoffFor(uint8_t failures) {
+  uint32_t delay = STATION_BACKOFF_BASE_MS;
+  for (uint8_t i = 1; i < failures && delay < STATION_BACKOFF_MAX_MS; i++) {
+    delay *= 2;
+  }
+  return delay < STATION_BACKOFF_MAX_MS ? delay : STATION_BACKOFF_MAX_MS;
+}
+
+void StationLink::start(uint32_t nowMs) {
+  attempts = 0;
+  failures = 0;
+  state = STATION_BACKOFF;
+  stateSinceMs = nowMs;
+  retryAtMs = nowMs;
+}
+
+void StationLink::stop() {
+  state = STATION_IDLE;
+}
+
+void StationLink::scheduleRetry(uint32_t nowMs) {
+  if (failures < 255) {
+    failures++;
+  }
+
+  // Halbe Wartezeit fest, halbe zufällig ("equal jitter")
+  uint32_t delay = backoffFor(failures);
+  uint32_t half = delay / 2;
+  retryAtMs = nowMs + half + nextRandom() % (half + 1);
+
+  state = STATION_BACKOFF;
+  stateSinceMs = nowMs;
+}
+
+void StationLink::onConnected(uint32_t nowMs) {
+  if (state == STATION_IDLE) {
+    return;
+  }
+  if (state == STATION_CONNECTING) {
+    lastConnectMs = nowMs - stateSinceMs;
+  }
+  state = STATION_CONNECTED;
+  stateSinceMs = nowMs;
+  failures = 0;
+}
+
+void StationLink::onDisconnected(uint32_t nowMs) {
+  // Im Backoff kommen Nachzügler des abgebrochenen Versuchs - ignorieren
+  if (state == STATION_CONNECTING || state == STATION_CONNECTED) {
+    scheduleRetry(nowMs);
+  }
+}
+
+StationAction StationLink::update(uint32_t nowMs) {
+  switch (state) {
+    case STATION_BACKOFF:
+      // Vorzeichenbehafteter Vergleich übersteht den millis()-Überlauf
+      if ((int32_t)(nowMs - retryAtMs) >= 0) {
+        state = STATION_CONNECTING;
+        stateSinceMs = nowMs;
+        attempts++;
+        return STATION_ACTION_CONNECT;
+      }
+      return STATION_ACTION_NONE;
+
+    case STATION_CONNECTING:
+      if (nowMs - stateSinceMs >= STATION_CONNECT_TIMEOUT_MS) {
+        scheduleRetry(nowMs);
+        return STATION_ACTION_DISCONNECT;
+      }
+      return STATION_ACTION_NONE;
+
+    default:
+      return STATION_ACTION_NONE;
+  }
+}
+
+StationLinkStats StationLink::getStats(uint32_t nowMs) const {
+  StationLinkStats stats;
+  stats.state = state;
+  stats.attempts = attempts;
+  stats.failures = failures;
+  stats.retryInMs = state == STATION_BACKOFF && (int32_t)(retryAtMs - nowMs) > 0 ?
+    retryAtMs - nowMs : 0;
+  stats.connectedMs = state == STATION_CONNECTED ? nowMs - stateSinceMs : 0;
+  stats.lastConnectMs = lastConnectMs;
+  return stats;
+}
+
+const char* StationLink::stateName(StationState state) {
+  switch (state) {
+    case STATION_IDLE: return "idle";
+    case STATION_CONNECTING: return "connecting";
+    case STATION_CONNECTED: return "connected";
+    case STATION_BACKOFF: return "backoff";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,79 @@
+/**
+ * Zustandsautomat für die Station-Verbindung: Verbindungsaufbau und
+ * Wiederverbinden ereignisgesteuert, ohne Warteschleifen in loop().
+ * Fehlversuche werden mit exponentiellem Backoff plus Jitter wiederholt.
+ * Ohne Arduino-Abhängigkeiten: Zeit und Ereignisse werden übergeben.
+ */
+
+#ifndef STATION_LINK_H
+#define STATION_LINK_H
+
+#include <stdint.h>
+
+#define STATION_CONNECT_TIMEOUT_MS 15000  // Ohne GOT_IP gilt der Versuch als gescheitert
+#define STATION_BACKOFF_BASE_MS 1000
+#define STATION_BACKOFF_MAX_MS 60000
+
+enum StationState {
+  STATION_IDLE,        // Keine Zugangsdaten oder manuell getrennt
+  STATION_CONNECTING,  // WiFi.begin() läuft, warte auf GOT_IP
+  STATION_CONNECTED,
+  STATION_BACKOFF      // Warte bis zum nächsten Versuch
+};
+
+// Was der Aufrufer nach update() am WiFi-Treiber tun soll
+enum StationAction {
+  STATION_ACTION_NONE,
+  STATION_ACTION_CONNECT,    // Neuen Verbindungsversuch starten
+  STATION_ACTION_DISCONNECT  // Hängenden Versuch abbrechen
+};
+
+struct StationLinkStats {
+  StationState state;
+  uint32_t attempts;       // Gestartete Versuche seit start()
+  uint8_t failures;        // Aufeinanderfolgende Fehlschläge
+  uint32_t retryInMs;      // Nur im Backoff
+  uint32_t connectedMs;    // Dauer der bestehenden Verbindung
+  uint32_t lastConnectMs;  // Dauer des letzten erfolgreichen Versuchs
+};
+
+class StationLink {
+private:
+  StationState state;
+  uint32_t stateSinceMs;
+  uint32_t retryAtMs;
+  uint32_t attempts;
+  uint8_t failures;
+  uint32_t lastConnectMs;
+  uint32_t jitterState;
+
+  void scheduleRetry(uint32_t nowMs);
+  uint32_t nextRandom();
+
+public:
+  StationLink();
+
+  // Startwert für den Jitter (z.B. esp_random()), damit Geräte nach einem
+  // gemeinsamen AP-Ausfall nicht im Gleichtakt wiederverbinden
+  void seed(uint32_t value);
+
+  // Neue Zugangsdaten: der nächste update() startet sofort einen Versuch
+  void start(uint32_t nowMs);
+  void stop();
+
+  // Ereignisse aus dem WiFi-Task (GOT_IP / STA_DISCONNECTED)
+  void onConnected(uint32_t nowMs);
+  void onDisconnected(uint32_t nowMs);
+
+  // Aus loop(): fällige Versuche und Timeouts, kehrt sofort zurück
+  StationAction update(uint32_t nowMs);
+
+  // Wartezeit vor dem Versuch nach failures Fehlschlägen (ohne Jitter)
+  static uint32_t backoffFor(uint8_t failures);
+
+  StationState getState() const { return state; }
+  StationLinkStats getStats(uint32_t nowMs) const;
+  static const char* stateName(StationState state);
+};
+
+#endif
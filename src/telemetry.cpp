@@ -0,0 +1,105 @@
+/**
+ * Telemetrie-Frames Implementierung
+ */
+
+#include "telemetry.h"
+
+static int16_t clamp16(int value) {
+  if (value > INT16_MAX) return INT16_MAX;
+  if (value < INT16_MIN) return INT16_MIN;
+  return (int16_t)value;
+}
+
+TelemetryFrame::TelemetryFrame(uint8_t* out, size_t size) {
+  buffer = out;
+  capacity = size;
+  length = 0;
+  records = 0;
+}
+
+void TelemetryFrame::put16(uint16_t value) {
+  buffer[length++] = value & 0xFF;
+  buffer[length++] = value >> 8;
+}
+
+void TelemetryFrame::put32(uint32_t value) {
+  put16(value & 0xFFFF);
+  put16(value >> 16);
+}
+
+bool TelemetryFrame::reserve(size_t size) {
+  if (length + size > capacity || records == UINT8_MAX) {
+    return false;
+  }
+  records++;
+  buffer[TELEMETRY_HEADER_SIZE - 1] = records;
+  return true;
+}
+
+void TelemetryFrame::begin(uint16_t sequence) {
+  length = 0;
+  records = 0;
+  if (capacity < TELEMETRY_HEADER_SIZE) {
+    capacity = 0;
+    return;
+  }
+  put8(TELEMETRY_MAGIC);
+  put8(TELEMETRY_VERSION);
+  put16(sequence);
+  put8(0);
+}
+
+bool TelemetryFrame::addStatus(uint8_t flags, uint8_t mouseType, uint32_t received, uint32_t dropped) {
+  if (!reserve(TELEMETRY_STATUS_SIZE)) {
+    return false;
+  }
+  put8(TELEMETRY_STATUS);
+  put8(flags);
+  put8(mouseType);
+  put32(received);
+  put32(dropped);
+  return true;
+}
+
+bool TelemetryFrame::addButton(uint8_t button, bool pressed, int x, int y, uint32_t timestampUs) {
+  if (!reserve(TELEMETRY_BUTTON_SIZE)) {
+    return false;
+  }
+  put8(TELEMETRY_BUTTON);
+  put8(button);
+  put8(pressed ? 1 : 0);
+  put16(clamp16(x));
+  put16(clamp16(y));
+  put32(timestampUs);
+  return true;
+}
+
+bool TelemetryFrame::addMotion(int x, int y, uint8_t buttons, float speed, uint32_t timestampUs,
+                               uint32_t coalesced) {
+  if (!reserve(TELEMETRY_MOTION_SIZE)) {
+    return false;
+  }
+  put8(TELEMETRY_MOTION);
+  put16(clamp16(x));
+  put16(clamp16(y));
+  put8(buttons);
+  put16(speed <= 0 ? 0 : (speed >= UINT16_MAX ? UINT16_MAX : (uint16_t)speed));
+  put32(timestampUs);
+  put16(coalesced > UINT16_MAX ? UINT16_MAX : coalesced);
+  return true;
+}
+
+bool TelemetryFrame::addLost(uint32_t count) {
+  if (!reserve(TELEMETRY_LOST_SIZE)) {
+    return false;
+  }
+  put8(TELEMETRY_LOST);
+  put32(count);
+  return true;
+}
+
+uint32_t TelemetryFrame::intervalForRate(uint32_t hz) {
+  if (hz == 0) hz = 1;
+  if (hz > TELEMETRY_MAX_HZ) hz = TELEMETRY_MAX_HZ;
+  return 1000000 / hz;
+}
@@ -0,0 +1,80 @@
+/**
+ * Binäres Telemetrie-Format für den Live-Kanal /ws/telemetry
+ *
+ * Frame (little-endian):
+ *   'T', Version, Sequenz (u16), Anzahl Einträge (u8)
+ * Einträge (Typ-Byte + Nutzdaten):
+ *   TELEMETRY_STATUS  Flags (u8), Maustyp (u8), Reports empfangen (u32),
+ *                     Reports verworfen (u32)
+ *   TELEMETRY_BUTTON  Taste (u8), gedrückt (u8), x (i16), y (i16), Zeit (u32 µs)
+ *   TELEMETRY_MOTION  x (i16), y (i16), Tasten (u8), Tempo (u16, px/s),
+ *                     Zeit (u32 µs), zusammengefasste Reports (u16)
+ *   TELEMETRY_LOST    Verlorene Tasten-Flanken vor den folgenden (u32)
+ * Ohne Arduino-Abhängigkeiten.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TELEMETRY_MAGIC 'T'
+#define TELEMETRY_VERSION 2
+#define TELEMETRY_HEADER_SIZE 5
+
+// Raten je Client (per Textnachricht "hz=<n>" einstellbar)
+#define TELEMETRY_MAX_HZ 100
+#define TELEMETRY_DEFAULT_HZ 30
+#define TELEMETRY_STATUS_INTERVAL_MS 1000  // Zähler auch ohne Änderung auffrischen
+
+// Eintragstypen
+enum TelemetryRecord {
+  TELEMETRY_STATUS = 1,
+  TELEMETRY_BUTTON = 2,
+  TELEMETRY_MOTION = 3,
+  TELEMETRY_LOST = 4    // Ringpuffer überschrieben, bevor der Client sie bekam
+};
+
+// Status-Flags
+#define TELEMETRY_FLAG_MOUSE 0x01
+#define TELEMETRY_FLAG_STATION 0x02
+#define TELEMETRY_FLAG_TRACE_REPLAY 0x04
+
+#define TELEMETRY_STATUS_SIZE 11
+#define TELEMETRY_BUTTON_SIZE 11
+#define TELEMETRY_MOTION_SIZE 14
+#define TELEMETRY_LOST_SIZE 5
+
+class TelemetryFrame {
+private:
+  uint8_t* buffer;
+  size_t capacity;
+  size_t length;
+  uint8_t records;
+
+  bool reserve(size_t size);
+  void put8(uint8_t value) { buffer[length++] = value; }
+  void put16(uint16_t value);
+  void put32(uint32_t value);
+
+public:
+  TelemetryFrame(uint8_t* buffer, size_t capacity);
+
+  void begin(uint16_t sequence);
+
+  // false, wenn der Eintrag nicht mehr passt
+  bool addStatus(uint8_t flags, uint8_t mouseType, uint32_t received, uint32_t dropped);
+  bool addButton(uint8_t button, bool pressed, int x, int y, uint32_t timestampUs);
+  bool addMotion(int x, int y, uint8_t buttons, float speed, uint32_t timestampUs,
+                 uint32_t coalesced);
+  bool addLost(uint32_t count);
+
+  bool isEmpty() const { return records == 0; }
+  size_t size() const { return length; }
+
+  // Abstand zwischen zwei Frames für eine Rate (begrenzt auf TELEMETRY_MAX_HZ)
+  static uint32_t intervalForRate(uint32_t hz);
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * Text-Cache Implementierung
+ */
+
+#include "text_cache.h"
+
+TextCache::TextCache(TFT_eSPI* display) {
+  tft = display;
+  useCounter = 0;
+  memset(&stats, 0, sizeof(stats));
+  for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+    entries[i].sprite = nullptr;
+  }
+}
+
+TextCacheEntry* TextCache::find(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor) {
+  for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+    TextCacheEntry& e = entries[i];
+    if (e.sprite != nullptr && e.size == size && e.fgColor == fgColor &&
+        e.bgColor == bgColor && strcmp(e.text, text) == 0) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+TextCacheEntry* TextCache::rasterize(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor) {
+  // Freien Eintrag suchen, sonst den am längsten ungenutzten verdrängen
+  TextCacheEntry* slot = nullptr;
+  for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+    if (entries[i].sprite == nullptr) {
+      slot = &entries[i];
+      break;
+    }
+    if (slot == nullptr || entries[i].lastUse < slot->lastUse) {
+      slot = &entries[i];
+    }
+  }
+  if (slot->sprite != nullptr) {
+    release(*slot);
+    stats.evictions++;
+  }
+  
+  TFT_eSprite* sprite = new TFT_eSprite(tft);
+  sprite->setColorDepth(16);
+  sprite->setTextSize(size);
+  int width = sprite->textWidth(text);
+  int height = sprite->fontHeight();
+  
+  if (width <= 0 || sprite->createSprite(width, height) == nullptr) {
+    delete sprite;
+    return nullptr;
+  }
+  
+  sprite->fillSprite(bgColor);
+  sprite->setTextColor(fgColor, bgColor);
+  sprite->setTextDatum(TL_DATUM);
+  sprite->drawString(text, 0, 0);
+  
+  strncpy(slot->text, text, TEXT_CACHE_MAX_LENGTH - 1);
+  slot->text[TEXT_CACHE_MAX_LENGTH - 1] = '\0';
+  slot->size = size;
+  slot->fgColor = fgColor;
+  slot->bgColor = bgColor;
+  slot->sprite = sprite;
+  
+  stats.glyphsRasterized += strlen(text);
+  stats.bytes += (uint32_t)width * height * 2;
+  return slot;
+}
+
+void TextCache::release(TextCacheEntry& entry) {
+  stats.bytes -= (uint32_t)entry.sprite->width() * entry.sprite->height() * 2;
+  entry.sprite->deleteSprite();
+  delete entry.sprite;
+  entry.sprite = nullptr;
+}
+
+TFT_eSprite* TextCache::get(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor) {
+  if (strlen(text) >= TEXT_CACHE_MAX_LENGTH) {
+    return nullptr;
+  }
+  
+  TextCacheEntry* entry = find(text, size, fgColor, bgColor);
+  if (entry != nullptr) {
+    stats.hits++;
+  } else {
+    stats.misses++;
+    entry = rasterize(text, size, fgColor, bgColor);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+  }
+  
+  entry->lastUse = ++useCounter;
+  return entry->sprite;
+}
+
+void TextCache::countDirect(const char* text) {
+  stats.glyphsRasterized += strlen(text);
+}
+
+void TextCache::clear() {
+  for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+    if (entries[i].sprite != nullptr) {
+      release(entries[i]);
+    }
+  }
+}
+
+TextCacheStats TextCache::getStats() {
+  return stats;
+}
@@ -0,0 +1,57 @@
+/**
+ * Cache für vorgerenderte Texte
+ * Rastert (Text, Größe, Farbe) einmal in ein Sprite (im PSRAM, falls
+ * vorhanden) - danach wird nur noch das fertige Bild übertragen.
+ */
+
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <TFT_eSPI.h>
+#include <Arduino.h>
+
+#define TEXT_CACHE_ENTRIES 12
+#define TEXT_CACHE_MAX_LENGTH 40  // Längere Texte werden direkt gezeichnet
+
+struct TextCacheEntry {
+  char text[TEXT_CACHE_MAX_LENGTH];
+  uint8_t size;
+  uint16_t fgColor;
+  uint16_t bgColor;
+  TFT_eSprite* sprite;   // nullptr = Eintrag frei
+  uint32_t lastUse;      // Für die Verdrängung (LRU)
+};
+
+struct TextCacheStats {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t glyphsRasterized;  // Gerasterte Zeichen (Cache-Fehlgriffe + direkt gezeichnet)
+  uint32_t evictions;
+  uint32_t bytes;             // Speicher aller Sprites
+};
+
+class TextCache {
+private:
+  TFT_eSPI* tft;
+  TextCacheEntry entries[TEXT_CACHE_ENTRIES];
+  uint32_t useCounter;
+  TextCacheStats stats;
+
+  TextCacheEntry* find(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor);
+  TextCacheEntry* rasterize(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor);
+  void release(TextCacheEntry& entry);
+
+public:
+  explicit TextCache(TFT_eSPI* tft);
+
+  // Fertiges Sprite für den Text (nullptr: nicht cachebar, direkt zeichnen)
+  TFT_eSprite* get(const char* text, uint8_t size, uint16_t fgColor, uint16_t bgColor);
+
+  // Direkt (ohne Cache) gezeichneten Text mitzählen
+  void countDirect(const char* text);
+
+  void clear();
+  TextCacheStats getStats();
+};
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * TFT-Backend Implementierung
+ */
+
+#include "tft_backend.h"
+
+TftBackend::TftBackend(TFT_eSPI* display, int16_t w, int16_t h) : DisplayBackend(w, h) {
+  tft = display;
+}
+
+void TftBackend::writeRect(int x, int y, int w, int h, uint16_t color) {
+  tft->fillRect(x, y, w, h, color);
+}
+
+void TftBackend::writeImage(int x, int y, int w, int h, const uint16_t* image, int stride) {
+  // Bilddaten liegen bereits in Bus-Reihenfolge vor
+  tft->startWrite();
+  tft->setAddrWindow(x, y, w, h);
+  for (int row = 0; row < h; row++) {
+    tft->pushPixels(&image[row * stride], w);
+  }
+  tft->endWrite();
+}
@@ -0,0 +1,23 @@
+/**
+ * Zeichen-Backend auf dem ST7789 (TFT_eSPI, blockierend)
+ */
+
+#ifndef TFT_BACKEND_H
+#define TFT_BACKEND_H
+
+#include <TFT_eSPI.h>
+#include "display_backend.h"
+
+class TftBackend : public DisplayBackend {
+private:
+  TFT_eSPI* tft;
+
+protected:
+  void writeRect(int x, int y, int w, int h, uint16_t color) override;
+  void writeImage(int x, int y, int w, int h, const uint16_t* image, int stride) override;
+
+public:
+  TftBackend(TFT_eSPI* tft, int16_t width, int16_t height);
+};
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Geschwindigkeitsschätzer Implementierung
+ *
+ * Alpha-Beta-Filter: Vorhersage x' = x + v*dt, Residuum r = z - x',
+ * Korrektur x = x' + a*r, v = v + b*r/dt. Die Zeitbasis sind die
+ * Mikrosekunden-Zeitstempel der Reports, nicht der loop()-Takt.
+ */
+
+#include "velocity_filter.h"
+#include <math.h>
+
+static const int64_t Q16_ONE = 65536;
+static const int64_t US_PER_SECOND = 1000000;
+
+VelocityFilter::VelocityFilter() {
+  reset();
+}
+
+void VelocityFilter::reset() {
+  posX = posY = 0;
+  velX = velY = 0;
+  lastX = lastY = 0;
+  lastSampleUs = 0;
+  idlePosX = idlePosY = 0;
+  idleVelX = idleVelY = 0;
+  idleFromUs = 0;
+  idleInjected = false;
+  initialized = false;
+}
+
+void VelocityFilter::step(int32_t x, int32_t y, uint32_t dtUs) {
+  if (dtUs < VELOCITY_MIN_DT_US) dtUs = VELOCITY_MIN_DT_US;
+  if (dtUs > VELOCITY_MAX_DT_US) dtUs = VELOCITY_MAX_DT_US;
+
+  // Vorhersage
+  int64_t predX = posX + velX * dtUs / US_PER_SECOND;
+  int64_t predY = posY + velY * dtUs / US_PER_SECOND;
+
+  // Residuum
+  int64_t resX = (int64_t)x * Q16_ONE - predX;
+  int64_t resY = (int64_t)y * Q16_ONE - predY;
+
+  // Korrektur
+  posX = predX + (resX * VELOCITY_ALPHA_Q8) / 256;
+  posY = predY + (resY * VELOCITY_ALPHA_Q8) / 256;
+  velX += (resX * VELOCITY_BETA_Q8 / 256) * US_PER_SECOND / dtUs;
+  velY += (resY * VELOCITY_BETA_Q8 / 256) * US_PER_SECOND / dtUs;
+}
+
+void VelocityFilter::addSample(int32_t x, int32_t y, uint32_t timestampUs) {
+  if (!initialized) {
+    posX = (int64_t)x * Q16_ONE;
+    posY = (int64_t)y * Q16_ONE;
+    velX = velY = 0;
+    lastSampleUs = timestampUs;
+    initialized = true;
+  } else {
+    // Nachzügler: vor dem von tick() eingespeisten Stillstand empfangen,
+    // aber erst danach verarbeitet. timestampUs - lastSampleUs liefe über
+    // (früher still auf MAX_DT begrenzt) - Stillstand zurücknehmen und
+    // ab dem letzten echten Report rechnen
+    if (idleInjected && (int32_t)(timestampUs - lastSampleUs) < 0) {
+      posX = idlePosX;
+      posY = idlePosY;
+      velX = idleVelX;
+      velY = idleVelY;
+      lastSampleUs = idleFromUs;
+    }
+
+    // Vertauschte Reports gelten als gebündelt (MIN_DT)
+    int32_t dtUs = (int32_t)(timestampUs - lastSampleUs);
+    step(x, y, dtUs > 0 ? (uint32_t)dtUs : 0);
+    if (dtUs > 0) {
+      lastSampleUs = timestampUs;
+    }
+  }
+
+  lastX = x;
+  lastY = y;
+  idleInjected = false;
+}
+
+void VelocityFilter::tick(uint32_t nowUs) {
+  if (!initialized) return;
+
+  // Mäuse senden bei Stillstand keine Reports - fehlende Reports
+  // bedeuten "keine Bewegung" und werden als solche eingespeist
+  if ((int32_t)(nowUs - lastSampleUs) >= VELOCITY_IDLE_US) {
+    // Zustand vor dem ersten Stillstand sichern, falls noch ein älterer
+    // Report nachkommt
+    if (!idleInjected) {
+      idlePosX = posX;
+      idlePosY = posY;
+      idleVelX = velX;
+      idleVelY = velY;
+      idleFromUs = lastSampleUs;
+      idleInjected = true;
+    }
+    step(lastX, lastY, nowUs - lastSampleUs);
+    lastSampleUs = nowUs;
+  }
+}
+
+float VelocityFilter::getVelocityX() const {
+  return (float)velX / Q16_ONE;
+}
+
+float VelocityFilter::getVelocityY() const {
+  return (float)velY / Q16_ONE;
+}
+
+float VelocityFilter::getSpeed() const {
+  float vx = getVelocityX();
+  float vy = getVelocityY();
+  return sqrtf(vx * vx + vy * vy);
+}
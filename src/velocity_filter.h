@@ -0,0 +1,51 @@
+/**
+ * Geschwindigkeitsschätzer (Alpha-Beta-Filter in Festkomma)
+ * Wird pro eingehendem Report mit dem Eingangszeitstempel gefüttert
+ */
+
+#ifndef VELOCITY_FILTER_H
+#define VELOCITY_FILTER_H
+
+#include <stdint.h>
+
+// Filter-Konfiguration
+#define VELOCITY_ALPHA_Q8 128        // Positionsgewicht 0.5 (Q8)
+#define VELOCITY_BETA_Q8 43          // Geschwindigkeitsgewicht ~0.17 (Q8)
+#define VELOCITY_MIN_DT_US 1000      // Gebündelte Reports: max. 1000 Hz annehmen
+#define VELOCITY_MAX_DT_US 100000    // Längere Pausen begrenzen
+#define VELOCITY_IDLE_US 20000       // Ohne Reports: Stillstand einspeisen
+
+class VelocityFilter {
+private:
+  // Zustand je Achse: Position in Q16 Pixel, Geschwindigkeit in Q16 Pixel/s
+  int64_t posX, posY;
+  int64_t velX, velY;
+  int32_t lastX, lastY;
+  uint32_t lastSampleUs;
+  // Zustand vor dem ersten eingespeisten Stillstand (für Nachzügler)
+  int64_t idlePosX, idlePosY;
+  int64_t idleVelX, idleVelY;
+  uint32_t idleFromUs;
+  bool idleInjected;
+  bool initialized;
+
+  void step(int32_t x, int32_t y, uint32_t dtUs);
+
+public:
+  VelocityFilter();
+
+  void reset();
+
+  // Neue Messung (aufsummierte Rohposition) zum Zeitpunkt timestampUs
+  void addSample(int32_t x, int32_t y, uint32_t timestampUs);
+
+  // Ohne neue Reports gegen 0 abklingen lassen (aus update() aufrufen)
+  void tick(uint32_t nowUs);
+
+  // Geschwindigkeit in Pixel/s
+  float getVelocityX() const;
+  float getVelocityY() const;
+  float getSpeed() const;
+};
+
+#endif
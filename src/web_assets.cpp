@@ -0,0 +1,27 @@
+/**
+ * Eingebettete Web-Assets Implementierung
+ */
+
+#include "web_assets.h"
+#include "web_assets_data.h"
+#include <string.h>
+
+const WebAsset* findWebAsset(const char* path) {
+  if (strcmp(path, "/") == 0) {
+    path = "/index.html";
+  }
+  for (int i = 0; i < WEB_ASSET_COUNT; i++) {
+    if (strcmp(WEB_ASSET_TABLE[i].path, path) == 0) {
+      return &WEB_ASSET_TABLE[i];
+    }
+  }
+  return nullptr;
+}
+
+int getWebAssetCount() {
+  return WEB_ASSET_COUNT;
+}
+
+const WebAsset* getWebAsset(int index) {
+  return (index >= 0 && index < WEB_ASSET_COUNT) ? &WEB_ASSET_TABLE[index] : nullptr;
+}
@@ -0,0 +1,26 @@
+/**
+ * Eingebettete Web-Assets (gzip-komprimiert im Flash)
+ * Erzeugt von tools/embed_assets.py aus data/ vor jedem Build
+ */
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+struct WebAsset {
+  const char* path;         // URL, z.B. "/index.html"
+  const char* contentType;
+  const uint8_t* data;      // gzip-Daten
+  size_t length;
+  const char* etag;         // Starker ETag (Hash des Inhalts, mit Anführungszeichen)
+};
+
+// Asset zur URL ("/" liefert /index.html), nullptr wenn unbekannt
+const WebAsset* findWebAsset(const char* path);
+
+int getWebAssetCount();
+const WebAsset* getWebAsset(int index);
+
+#endif
@@ -4,31 +4,143 @@
  */
 
 #include "webserver.h"
+#include <esp_heap_caps.h>
 
 WebServerManager::WebServerManager() {
   server = nullptr;
   mouseHandler = nullptr;
   networkManager = nullptr;
+  latencyMonitor = nullptr;
+  loopScheduler = nullptr;
+  displayManager = nullptr;
+  framePacer = nullptr;
+  frameGovernor = nullptr;
+  
+  screenMirror = nullptr;
+  mirrorSocket = nullptr;
+  memset(mirrorClients, 0, sizeof(mirrorClients));
+  mirrorLock = portMUX_INITIALIZER_UNLOCKED;
+  mirrorBuffer = nullptr;
+  memset(&mirrorStats, 0, sizeof(mirrorStats));
+  
+  telemetrySocket = nullptr;
+  memset(telemetryClients, 0, sizeof(telemetryClients));
+  telemetryLock = portMUX_INITIALIZER_UNLOCKED;
+  memset(&telemetryStats, 0, sizeof(telemetryStats));
+  
+  discoveryEvents = nullptr;
+  discoveryStreamSeq = 0;
+  discoveryStreaming = false;
+  
+  otaSessionName[0] = '\0';
+  restartAtMs = 0;
+  
+  buttonEventCursor = 0;
+  skippedButtonEvents = 0;
+  leftClicks = 0;
+  rightClicks = 0;
+}
+
+void WebServerManager::setLatencyMonitor(LatencyMonitor* monitor) {
+  latencyMonitor = monitor;
+}
+
+void WebServerManager::setLoopScheduler(LoopScheduler* scheduler) {
+  loopScheduler = scheduler;
+}
+
+void WebServerManager::setDisplayManager(DisplayManager* display) {
+  displayManager = display;
+}
+
+void WebServerManager::setFramePacer(FramePacer* pacer) {
+  framePacer = pacer;
+}
+
+void WebServerManager::setFrameGovernor(FrameGovernor* governor) {
+  frameGovernor = governor;
+}
+
+void WebServerManager::setScreenMirror(ScreenMirror* mirror) {
+  screenMirror = mirror;
 }
 
 bool WebServerManager::begin(MouseHandler* mouse, NetworkManager* network) {
   mouseHandler = mouse;
   networkManager = network;
+  buttonEventCursor = mouseHandler->getButtonEventSeq();
   
   server = new AsyncWebServer(80);
   
+  if (!responsePool.begin(JSON_RESPONSE_BUFFERS, JSON_RESPONSE_BUFFER_SIZE)) {
+    Serial.println("[WEBSERVER] Antwortpuffer nicht verfügbar - JSON wird gestreamt");
+  }
+  
   // ========== Routes ==========
   
-  // Hauptseite
+  // Webinterface aus data/ (gzip im Flash, siehe tools/embed_assets.py)
   server->on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
-    request->send(200, "text/html", getIndexHTML());
+    handleAsset(request, findWebAsset("/"));
   });
+  for (int i = 0; i < getWebAssetCount(); i++) {
+    const WebAsset* asset = getWebAsset(i);
+    server->on(asset->path, HTTP_GET, [this, asset](AsyncWebServerRequest* request) {
+      handleAsset(request, asset);
+    });
+  }
   
   // Status-API
   server->on("/api/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
     handleStatus(request);
   });
   
+  // Latenz-Histogramme (?reset=1 setzt zurück)
+  server->on("/api/latency", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    handleLatency(request);
+  });
+  
+  // Loop-Statistik je Aufgabe (?reset=1 setzt zurück)
+  server->on("/api/perf", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    handlePerf(request);
+  });
+  
+  // HID-Trace: Aufzeichnung, Wiedergabe und Download
+  server->on("/api/trace/start", HTTP_POST, [this](AsyncWebServerRequest* request) {
+    mouseHandler->startTraceRecording();
+    handleTraceStatus(request);
+  });
+  
+  server->on("/api/trace/stop", HTTP_POST, [this](AsyncWebServerRequest* request) {
+    mouseHandler->stopTraceRecording();
+    mouseHandler->stopTraceReplay();
+    handleTraceStatus(request);
+  });
+  
+  // ?speed=100 (Original, Prozent), 0 = maximal
+  server->on("/api/trace/replay", HTTP_POST, [this](AsyncWebServerRequest* request) {
+    uint16_t speed = HID_TRACE_SPEED_ORIGINAL;
+    if (request->hasParam("speed", true)) {
+      speed = request->getParam("speed", true)->value().toInt();
+    } else if (request->hasParam("speed")) {
+      speed = request->getParam("speed")->value().toInt();
+    }
+    mouseHandler->startTraceReplay(speed);
+    handleTraceStatus(request);
+  });
+  
+  server->on("/api/trace/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    handleTraceStatus(request);
+  });
+  
+  server->on("/api/trace", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    handleTraceDownload(request);
+  });
+  
+  // Bildschirminhalt als PPM (Framebuffer-Modus)
+  server->on("/api/screenshot", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    handleScreenshot(request);
+  });
+  
   // BLE-Scan
   server->on("/api/scan/ble", HTTP_GET, [this](AsyncWebServerRequest* request) {
     handleScanBLE(request);
@@ -64,26 +176,159 @@ bool WebServerManager::begin(MouseHandler* mouse, NetworkManager* network) {
     handleDisconnect(request);
   });
   
-  // OTA-Upload
+  // OTA-Upload (.bin oder .bin.lzs, optional ?sha256=<hex> für rohe Images)
   server->on("/api/ota", HTTP_POST,
-    [](AsyncWebServerRequest* request) {
-      request->send(200, "text/plain", Update.hasError() ? "FAIL" : "OK");
-      delay(100);
-      ESP.restart();
+    [this](AsyncWebServerRequest* request) {
+      handleOTAResult(request);
     },
     [this](AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final) {
       handleOTAUpload(request, filename, index, data, len, final);
     }
   );
   
+  // Fortsetzbarer OTA-Upload in Stücken:
+  //   POST /api/ota/begin?size=<n>&name=<datei>[&sha256=<hex>] -> Offset (0 oder Fortsetzung)
+  //   POST /api/ota/chunk?offset=<n> mit Rohdaten               -> neuer Offset
+  //   GET  /api/ota/status                                       -> Offset nach Abbruch
+  server->on("/api/ota/begin", HTTP_POST, [this](AsyncWebServerRequest* request) {
+    handleOTABegin(request);
+  });
+  
+  server->on("/api/ota/chunk", HTTP_POST,
+    [this](AsyncWebServerRequest* request) {
+      handleOTAChunkResult(request);
+    },
+    nullptr,
+    [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+      handleOTAChunkData(request, data, len, index);
+    }
+  );
+  
+  server->on("/api/ota/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    sendOTAState(request, 200);
+  });
+  
+  // BT-Gerätesuche: Snapshot beim Verbinden, danach Funde als Events
+  discoveryEvents = new AsyncEventSource("/api/scan/bt/events");
+  discoveryEvents->onConnect([this](AsyncEventSourceClient* client) {
+    handleDiscoveryConnect(client);
+  });
+  server->addHandler(discoveryEvents);
+  
+  // Live-Telemetrie (binäre Frames, siehe telemetry.h)
+  telemetrySocket = new AsyncWebSocket("/ws/telemetry");
+  telemetrySocket->onEvent([this](AsyncWebSocket* socket, AsyncWebSocketClient* client,
+                                  AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    handleTelemetryEvent(client, type, arg, data, len);
+  });
+  server->addHandler(telemetrySocket);
+  
+  // Bildschirm-Spiegelung (binäre Kachel-Nachrichten, siehe screen_mirror.h)
+  if (screenMirror != nullptr && displayManager != nullptr) {
+    mirrorBuffer = (uint8_t*)malloc(MIRROR_MESSAGE_MAX);
+    if (mirrorBuffer != nullptr) {
+      mirrorSocket = new AsyncWebSocket("/ws/screen");
+      mirrorSocket->onEvent([this](AsyncWebSocket* socket, AsyncWebSocketClient* client,
+                                   AwsEventType type, void* arg, uint8_t* data, size_t len) {
+        handleMirrorEvent(client, type);
+      });
+      server->addHandler(mirrorSocket);
+    }
+  }
+  
   server->begin();
   Serial.println("[WEBSERVER] Server gestartet auf Port 80");
   
   return true;
 }
 
+void WebServerManager::sendJson(AsyncWebServerRequest* request, const JsonDocument& doc, int code) {
+  // Abgeschnittenes Dokument nicht als gültige Antwort ausliefern
+  if (doc.overflowed()) {
+    Serial.printf("[WEBSERVER] JSON-Dokument zu klein für %s\n", request->url().c_str());
+    request->send(500, "text/plain", "JSON document overflow");
+    return;
+  }
+  
+  size_t length = measureJson(doc);
+  size_t capacity = responsePool.getBufferSize();
+  int slot = length < capacity ? responsePool.acquire() : -1;
+  
+  if (slot < 0) {
+    // Ausweichpfad: chunked in den Sendepuffer der Verbindung
+    if (capacity > 0 && length >= capacity) {
+      responsePool.countOversize();
+    }
+    AsyncResponseStream* stream = request->beginResponseStream("application/json");
+    stream->setCode(code);
+    serializeJson(doc, *stream);
+    request->send(stream);
+    return;
+  }
+  
+  const uint8_t* buffer = responsePool.getBuffer(slot);
+  serializeJson(doc, (char*)responsePool.getBuffer(slot), capacity);
+  
+  // Puffer gehört dem Request, bis die Verbindung geschlossen ist
+  ResponsePool* pool = &responsePool;
+  request->onDisconnect([pool, slot]() {
+    pool->release(slot);
+  });
+  
+  AsyncWebServerResponse* response = request->beginResponse(
+    "application/json", length,
+    [buffer, length](uint8_t* out, size_t maxLen, size_t index) -> size_t {
+      size_t chunk = min(maxLen, length - index);
+      memcpy(out, buffer + index, chunk);
+      return chunk;
+    }
+  );
+  response->setCode(code);
+  request->send(response);
+}
+
+void WebServerManager::handleAsset(AsyncWebServerRequest* request, const WebAsset* asset) {
+  // Unveränderter Inhalt: Browser-Cache bestätigen statt erneut senden
+  if (request->hasHeader("If-None-Match") &&
+      request->header("If-None-Match") == asset->etag) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", asset->etag);
+    request->send(response);
+    return;
+  }
+  
+  AsyncWebServerResponse* response = request->beginResponse_P(
+    200, asset->contentType, asset->data, asset->length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset->etag);
+  // Immer nachfragen - dank ETag meist nur ein 304 ohne Inhalt
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+static void formatIP(const IPAddress& ip, char* out) {
+  snprintf(out, 16, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+}
+
 void WebServerManager::handleStatus(AsyncWebServerRequest* request) {
-  StaticJsonDocument<512> doc;
+  StaticJsonDocument<1536> doc;
+  
+  // Tasten-Flanken seit dem letzten Aufruf einsammeln (die letzten
+  // MAX_STATUS_EVENTS werden mitgeschickt, gezählt werden alle)
+  ButtonEvent events[MAX_STATUS_EVENTS];
+  int eventCount = 0;
+  ButtonEvent event;
+  while (mouseHandler->pollButtonEvent(buttonEventCursor, event)) {
+    skippedButtonEvents += event.skipped;
+    if (event.pressed && event.button == MOUSE_BUTTON_LEFT) leftClicks++;
+    if (event.pressed && event.button == MOUSE_BUTTON_RIGHT) rightClicks++;
+    
+    if (eventCount == MAX_STATUS_EVENTS) {
+      memmove(&events[0], &events[1], sizeof(ButtonEvent) * (MAX_STATUS_EVENTS - 1));
+      eventCount--;
+    }
+    events[eventCount++] = event;
+  }
   
   // Maus-Status
   doc["mouseConnected"] = mouseHandler->isMouseConnected();
@@ -97,18 +342,522 @@ void WebServerManager::handleStatus(AsyncWebServerRequest* request) {
     doc["speed"] = data.speed;
   }
   
-  // Netzwerk-Status
+  doc["leftClicks"] = leftClicks;
+  doc["rightClicks"] = rightClicks;
+  doc["buttonEventsSkipped"] = skippedButtonEvents;
+  JsonArray buttonEvents = doc.createNestedArray("buttonEvents");
+  for (int i = 0; i < eventCount; i++) {
+    JsonObject ev = buttonEvents.createNestedObject();
+    ev["button"] = events[i].button;
+    ev["pressed"] = events[i].pressed;
+    ev["x"] = events[i].x;
+    ev["y"] = events[i].y;
+    ev["t"] = events[i].timestampUs;
+  }
+  
+  // Report-Queue (Überläufe zwischen HID-Callback und loop())
+  ReportQueueStats queueStats = mouseHandler->getQueueStats();
+  doc["reportsReceived"] = queueStats.pushed;
+  doc["reportsDropped"] = queueStats.dropped;
+  
+  // Netzwerk-Status (Adressen ohne String-Zwischenschritt)
+  char apIP[16];
+  char stationIP[16];
+  formatIP(networkManager->getAPIP(), apIP);
   doc["apSSID"] = networkManager->getAPSSID();
-  doc["apIP"] = networkManager->getAPIP().toString();
-  doc["stationConnected"] = networkManager->isStationConnected();
+  doc["apIP"] = (const char*)apIP;
+  
+  StationLinkStats station = networkManager->getStationStats();
+  doc["stationConnected"] = station.state == STATION_CONNECTED;
+  doc["stationState"] = StationLink::stateName(station.state);
+  
+  if (station.state == STATION_CONNECTED) {
+    formatIP(networkManager->getStationIP(), stationIP);
+    doc["stationIP"] = (const char*)stationIP;
+  } else if (station.state != STATION_IDLE) {
+    doc["stationAttempts"] = station.attempts;
+    doc["stationRetryMs"] = station.retryInMs;
+    doc["stationReason"] = networkManager->getLastDisconnectReason();
+  }
+  
+  sendJson(request, doc);
+}
+
+void WebServerManager::handleLatency(AsyncWebServerRequest* request) {
+  if (latencyMonitor == nullptr) {
+    request->send(503, "text/plain", "Latency monitor not available");
+    return;
+  }
+  
+  LatencyHistogram histograms[LATENCY_STAGE_COUNT];
+  latencyMonitor->snapshot(histograms);
+  
+  if (request->hasParam("reset")) {
+    latencyMonitor->reset();
+  }
+  
+  StaticJsonDocument<768> doc;
+  doc["unit"] = "us";
+  JsonObject stages = doc.createNestedObject("stages");
+  
+  for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    JsonObject stage = stages.createNestedObject(LatencyMonitor::stageName((LatencyStage)i));
+    stage["count"] = histograms[i].getCount();
+    stage["mean"] = histograms[i].getMean();
+    stage["p50"] = histograms[i].getPercentile(50);
+    stage["p99"] = histograms[i].getPercentile(99);
+    stage["max"] = histograms[i].getMax();
+  }
+  
+  sendJson(request, doc);
+}
+
+void WebServerManager::handlePerf(AsyncWebServerRequest* request) {
+  if (loopScheduler == nullptr) {
+    request->send(503, "text/plain", "Loop scheduler not available");
+    return;
+  }
+  
+  // Neue Felder: PERF_JSON_CAPACITY mitziehen (sonst 500 aus sendJson)
+  StaticJsonDocument<PERF_JSON_CAPACITY> doc;
+  uint32_t windowUs = loopScheduler->getStatsWindowUs();
+  doc["windowMs"] = windowUs / 1000;
+  doc["reports"] = mouseHandler->getQueueStats().popped;
+  // Anteil, den loop() schlafend verbracht hat
+  doc["idlePercent"] = windowUs ? (float)(loopScheduler->getIdleUs() * 100.0 / windowUs) : 0.0f;
+  
+  JsonObject tasks = doc.createNestedObject("tasks");
+  for (int i = 0; i < TASK_COUNT; i++) {
+    LoopTaskStats stats = loopScheduler->getStats((LoopTask)i);
+    JsonObject task = tasks.createNestedObject(LoopScheduler::taskName((LoopTask)i));
+    task["runs"] = stats.runs;
+    task["perSecond"] = windowUs ? (float)stats.runs * 1000000.0f / windowUs : 0.0f;
+    task["avgUs"] = stats.runs ? (uint32_t)(stats.totalUs / stats.runs) : 0;
+    task["maxUs"] = stats.maxUs;
+    task["lastUs"] = stats.lastUs;
+  }
+  
+  if (displayManager != nullptr) {
+    DisplayStats displayStats = displayManager->getStats();
+    JsonObject display = doc.createNestedObject("display");
+    display["frames"] = displayStats.frames;
+    display["lastFrameBytes"] = displayStats.lastFrameBytes;
+    display["lastFrameRects"] = displayStats.lastFrameRects;
+    display["lastFrameTransactions"] = displayStats.lastFrameTransactions;
+    display["avgFrameBytes"] = displayStats.frames ?
+      (uint32_t)(displayStats.totalBytes / displayStats.frames) : 0;
+    display["framebuffer"] = displayStats.framebuffer;
+    display["lastRenderUs"] = displayStats.lastRenderUs;
+    display["lastFlushUs"] = displayStats.lastFlushUs;
+    display["avgRenderUs"] = displayStats.frames ?
+      (uint32_t)(displayStats.totalRenderUs / displayStats.frames) : 0;
+    display["avgFlushUs"] = displayStats.frames ?
+      (uint32_t)(displayStats.totalFlushUs / displayStats.frames) : 0;
+    
+    AnimationStats animationStats = displayManager->getAnimationStats();
+    JsonObject animations = doc.createNestedObject("animations");
+    animations["active"] = animationStats.active;
+    animations["triggered"] = animationStats.triggered;
+    animations["coalesced"] = animationStats.coalesced;
+    animations["recycled"] = animationStats.recycled;
+    
+    TextCacheStats textStats = displayManager->getTextCacheStats();
+    JsonObject text = doc.createNestedObject("textCache");
+    text["hits"] = textStats.hits;
+    text["misses"] = textStats.misses;
+    text["glyphsRasterized"] = textStats.glyphsRasterized;
+    text["evictions"] = textStats.evictions;
+    text["bytes"] = textStats.bytes;
+  }
+  
+  if (framePacer != nullptr) {
+    FramePacerStats pacerStats = framePacer->getStats();
+    JsonObject frames = doc.createNestedObject("frames");
+    frames["rendered"] = pacerStats.rendered;
+    frames["skipped"] = pacerStats.skipped;
+    frames["maxFps"] = pacerStats.maxFps;
+    frames["idle"] = pacerStats.idle;
+  }
+  
+  if (frameGovernor != nullptr) {
+    FrameGovernorStats governorStats = frameGovernor->getStats();
+    JsonObject budget = doc.createNestedObject("budget");
+    budget["budgetUs"] = FRAME_BUDGET_US;
+    budget["quality"] = FrameGovernor::levelName(governorStats.level);
+    budget["frames"] = governorStats.frames;
+    budget["overruns"] = governorStats.overruns;
+    budget["stepDowns"] = governorStats.stepDowns;
+    budget["stepUps"] = governorStats.stepUps;
+    budget["lastUs"] = governorStats.lastUs;
+    budget["maxUs"] = governorStats.maxUs;
+  }
+  
+  JsonObject telemetry = doc.createNestedObject("telemetry");
+  telemetry["clients"] = telemetryStats.clients;
+  telemetry["frames"] = telemetryStats.frames;
+  telemetry["bytes"] = telemetryStats.bytes;
+  telemetry["skipped"] = telemetryStats.skipped;
+  telemetry["lostButtons"] = telemetryStats.lostButtons;
+  
+  if (mirrorSocket != nullptr) {
+    JsonObject mirror = doc.createNestedObject("mirror");
+    mirror["clients"] = mirrorStats.clients;
+    mirror["messages"] = mirrorStats.messages;
+    mirror["bytes"] = mirrorStats.bytes;
+    mirror["skipped"] = mirrorStats.skipped;
+  }
+  
+  // Station: Boot bis zur ersten Verbindung (mit/ohne NVS-Cache vergleichen)
+  StationTiming timing = networkManager->getStationTiming();
+  StationLinkStats station = networkManager->getStationStats();
+  JsonObject wifi = doc.createNestedObject("station");
+  wifi["state"] = StationLink::stateName(station.state);
+  wifi["cached"] = timing.cached;
+  wifi["bootConnectMs"] = timing.bootConnectMs;
+  wifi["bootFast"] = timing.bootFast;
+  wifi["lastConnectMs"] = station.lastConnectMs;
+  wifi["lastFast"] = timing.lastFast;
+  wifi["attempts"] = station.attempts;
+  
+  // Heap: freier Speicher und größter zusammenhängender Block (Fragmentierung)
+  JsonObject heap = doc.createNestedObject("heap");
+  heap["free"] = ESP.getFreeHeap();
+  heap["minFree"] = ESP.getMinFreeHeap();
+  heap["largestBlock"] = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  
+  ResponsePoolStats poolStats = responsePool.getStats();
+  JsonObject responses = doc.createNestedObject("responses");
+  responses["pooled"] = poolStats.acquired;
+  responses["exhausted"] = poolStats.exhausted;
+  responses["oversize"] = poolStats.oversize;
+  responses["inUse"] = poolStats.inUse;
+  responses["highWater"] = poolStats.highWater;
+  
+  if (request->hasParam("reset")) {
+    loopScheduler->resetStats();
+    if (framePacer != nullptr) {
+      framePacer->resetStats();
+    }
+    if (frameGovernor != nullptr) {
+      frameGovernor->resetStats();
+    }
+  }
+  
+  sendJson(request, doc);
+}
+
+void WebServerManager::handleTraceStatus(AsyncWebServerRequest* request) {
+  StaticJsonDocument<256> doc;
+  doc["recording"] = mouseHandler->isTraceRecording();
+  doc["replaying"] = mouseHandler->isTraceReplaying();
+  doc["reports"] = mouseHandler->getTraceRecordCount();
+  doc["bytes"] = mouseHandler->getTraceSize();
+  
+  sendJson(request, doc);
+}
+
+void WebServerManager::handleTraceDownload(AsyncWebServerRequest* request) {
+  // Export braucht einen stabilen Ring
+  mouseHandler->stopTraceRecording();
+  
+  AsyncWebServerResponse* response = request->beginResponse(
+    "application/octet-stream",
+    mouseHandler->getTraceSize(),
+    [this](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      return mouseHandler->readTrace(index, buffer, maxLen);
+    }
+  );
+  response->addHeader("Content-Disposition", "attachment; filename=\"mouse.hidtrace\"");
+  request->send(response);
+}
+
+void WebServerManager::handleScreenshot(AsyncWebServerRequest* request) {
+  if (displayManager == nullptr || displayManager->getScreenshotSize() == 0) {
+    request->send(503, "text/plain", "Framebuffer not available");
+    return;
+  }
+  
+  AsyncWebServerResponse* response = request->beginResponse(
+    "image/x-portable-pixmap",
+    displayManager->getScreenshotSize(),
+    [this](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      return displayManager->readScreenshot(index, buffer, maxLen);
+    }
+  );
+  response->addHeader("Content-Disposition", "attachment; filename=\"screen.ppm\"");
+  request->send(response);
+}
+
+// ========== Live-Telemetrie ==========
+
+void WebServerManager::handleTelemetryEvent(AsyncWebSocketClient* client, AwsEventType type,
+                                            void* arg, uint8_t* data, size_t len) {
+  // Läuft im Task des Async-Webservers - nur die Client-Tabelle anfassen
+  if (type == WS_EVT_CONNECT) {
+    bool accepted = false;
+    uint32_t eventSeq = mouseHandler->getButtonEventSeq();
+    portENTER_CRITICAL(&telemetryLock);
+    for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+      if (!telemetryClients[i].active) {
+        TelemetryClient& state = telemetryClients[i];
+        memset(&state, 0, sizeof(state));
+        state.active = true;
+        state.fresh = true;
+        state.buttonCursor = eventSeq;
+        state.id = client->id();
+        state.intervalUs = TelemetryFrame::intervalForRate(TELEMETRY_DEFAULT_HZ);
+        telemetryStats.clients++;
+        accepted = true;
+        break;
+      }
+    }
+    portEXIT_CRITICAL(&telemetryLock);
+    
+    if (!accepted) {
+      client->close();
+    }
+  } else if (type == WS_EVT_DISCONNECT) {
+    portENTER_CRITICAL(&telemetryLock);
+    for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+      if (telemetryClients[i].active && telemetryClients[i].id == client->id()) {
+        telemetryClients[i].active = false;
+        telemetryStats.clients--;
+      }
+    }
+    portEXIT_CRITICAL(&telemetryLock);
+  } else if (type == WS_EVT_DATA) {
+    // Rate einstellen: Textnachricht "hz=<n>" (1..TELEMETRY_MAX_HZ)
+    AwsFrameInfo* info = (AwsFrameInfo*)arg;
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_TEXT ||
+        len < 4 || len > 8 || memcmp(data, "hz=", 3) != 0) {
+      return;
+    }
+    char value[8];
+    memcpy(value, data + 3, len - 3);
+    value[len - 3] = '\0';
+    uint32_t interval = TelemetryFrame::intervalForRate(strtoul(value, nullptr, 10));
+    
+    portENTER_CRITICAL(&telemetryLock);
+    for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+      if (telemetryClients[i].active && telemetryClients[i].id == client->id()) {
+        telemetryClients[i].intervalUs = interval;
+      }
+    }
+    portEXIT_CRITICAL(&telemetryLock);
+  }
+}
+
+uint32_t WebServerManager::getTelemetryInterval() {
+  uint32_t interval = 0;
+  portENTER_CRITICAL(&telemetryLock);
+  for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+    if (telemetryClients[i].active &&
+        (interval == 0 || telemetryClients[i].intervalUs < interval)) {
+      interval = telemetryClients[i].intervalUs;
+    }
+  }
+  portEXIT_CRITICAL(&telemetryLock);
+  return interval / 1000;
+}
+
+size_t WebServerManager::buildTelemetryFrame(TelemetryClient& state, const MouseData& data,
+                                             uint8_t flags, uint32_t now) {
+  TelemetryFrame frame(telemetryBuffer, sizeof(telemetryBuffer));
+  frame.begin(state.sequence);
   
-  if (networkManager->isStationConnected()) {
-    doc["stationIP"] = networkManager->getStationIP().toString();
+  ReportQueueStats queueStats = mouseHandler->getQueueStats();
+  
+  // Verbindungsänderungen sofort, Zähler sonst einmal pro Sekunde
+  if (state.fresh || flags != state.lastFlags ||
+      now - state.lastStatusUs >= TELEMETRY_STATUS_INTERVAL_MS * 1000) {
+    frame.addStatus(flags, data.type, queueStats.pushed, queueStats.dropped);
+    state.lastFlags = flags;
+    state.lastStatusUs = now;
+  }
+  
+  // Alle Tasten-Flanken seit dem letzten Frame (neue Clients ohne Historie).
+  // Staute sich die Sendewarteschlange zu lange, hat der Ring die ältesten
+  // überschrieben - der Client erfährt wie viele, vor den erhaltenen
+  ButtonEvent event;
+  while (mouseHandler->pollButtonEvent(state.buttonCursor, event)) {
+    if (state.fresh) {
+      continue;
+    }
+    if (event.skipped > 0) {
+      frame.addLost(event.skipped);
+      telemetryStats.lostButtons += event.skipped;
+    }
+    frame.addButton(event.button, event.pressed, event.x, event.y, event.timestampUs);
+  }
+  
+  // Bewegung seit dem letzten Frame als eine Position
+  uint8_t buttons = data.buttons & 0xFF;
+  if (state.fresh || data.x != state.lastX || data.y != state.lastY || buttons != state.lastButtons) {
+    frame.addMotion(data.x, data.y, buttons, data.speed, data.ingressUs,
+                    queueStats.popped - state.lastReports);
+    state.lastX = data.x;
+    state.lastY = data.y;
+    state.lastButtons = buttons;
+  }
+  state.lastReports = queueStats.popped;
+  state.fresh = false;
+  
+  return frame.isEmpty() ? 0 : frame.size();
+}
+
+void WebServerManager::updateTelemetry() {
+  if (telemetrySocket == nullptr) {
+    return;
+  }
+  telemetrySocket->cleanupClients(TELEMETRY_MAX_CLIENTS);
+  
+  uint32_t now = micros();
+  MouseData data = mouseHandler->getMouseData();
+  uint8_t flags = 0;
+  if (mouseHandler->isMouseConnected()) flags |= TELEMETRY_FLAG_MOUSE;
+  if (networkManager->isStationConnected()) flags |= TELEMETRY_FLAG_STATION;
+  if (mouseHandler->isTraceReplaying()) flags |= TELEMETRY_FLAG_TRACE_REPLAY;
+  
+  for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+    portENTER_CRITICAL(&telemetryLock);
+    TelemetryClient state = telemetryClients[i];
+    portEXIT_CRITICAL(&telemetryLock);
+    
+    // Rate-Limit je Client
+    if (!state.active || (!state.fresh && now - state.lastSendUs < state.intervalUs)) {
+      continue;
+    }
+    
+    AsyncWebSocketClient* client = telemetrySocket->client(state.id);
+    if (client == nullptr) {
+      continue;
+    }
+    if (client->queueIsFull()) {
+      // Stand bleibt erhalten - der nächste Frame fasst alles zusammen
+      telemetryStats.skipped++;
+      continue;
+    }
+    
+    size_t length = buildTelemetryFrame(state, data, flags, now);
+    state.lastSendUs = now;
+    if (length > 0) {
+      client->binary(telemetryBuffer, length);
+      state.sequence++;
+      telemetryStats.frames++;
+      telemetryStats.bytes += length;
+    }
+    
+    // Rate kann sich inzwischen geändert haben
+    portENTER_CRITICAL(&telemetryLock);
+    if (telemetryClients[i].active && telemetryClients[i].id == state.id) {
+      state.intervalUs = telemetryClients[i].intervalUs;
+      telemetryClients[i] = state;
+    }
+    portEXIT_CRITICAL(&telemetryLock);
+  }
+}
+
+// ========== Bildschirm-Spiegelung ==========
+
+void WebServerManager::handleMirrorEvent(AsyncWebSocketClient* client, AwsEventType type) {
+  // Läuft im Task des Async-Webservers - nur die Client-Tabelle anfassen
+  if (type == WS_EVT_CONNECT) {
+    if (displayManager->getFrontBuffer() == nullptr) {
+      client->text("unavailable");
+      client->close();
+      return;
+    }
+    
+    int slot = -1;
+    portENTER_CRITICAL(&mirrorLock);
+    for (int i = 0; i < MIRROR_MAX_CLIENTS; i++) {
+      if (!mirrorClients[i].active) {
+        slot = i;
+        mirrorClients[i].active = true;
+        mirrorClients[i].id = client->id();
+        // Neuer Client braucht zuerst das ganze Bild
+        screenMirror->fillAll(mirrorClients[i].pending);
+        mirrorStats.clients++;
+        break;
+      }
+    }
+    portEXIT_CRITICAL(&mirrorLock);
+    
+    if (slot < 0) {
+      client->text("busy");
+      client->close();
+      return;
+    }
+    Serial.printf("[MIRROR] Client %u verbunden\n", client->id());
+  } else if (type == WS_EVT_DISCONNECT) {
+    portENTER_CRITICAL(&mirrorLock);
+    for (int i = 0; i < MIRROR_MAX_CLIENTS; i++) {
+      if (mirrorClients[i].active && mirrorClients[i].id == client->id()) {
+        mirrorClients[i].active = false;
+        mirrorStats.clients--;
+      }
+    }
+    portEXIT_CRITICAL(&mirrorLock);
+  }
+}
+
+void WebServerManager::updateMirror() {
+  if (mirrorSocket == nullptr) {
+    return;
+  }
+  mirrorSocket->cleanupClients(MIRROR_MAX_CLIENTS);
+  
+  const MemoryBackend* front = displayManager->getFrontBuffer();
+  TileSet changed;
+  screenMirror->takeChanged(changed);
+  if (front == nullptr) {
+    return;
   }
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  for (int i = 0; i < MIRROR_MAX_CLIENTS; i++) {
+    // Ausstehende Kacheln dieses Clients übernehmen
+    portENTER_CRITICAL(&mirrorLock);
+    bool active = mirrorClients[i].active;
+    uint32_t id = mirrorClients[i].id;
+    if (active) {
+      mirrorClients[i].pending.merge(changed);
+    }
+    TileSet pending = mirrorClients[i].pending;
+    portEXIT_CRITICAL(&mirrorLock);
+    
+    if (!active || !pending.any()) {
+      continue;
+    }
+    
+    AsyncWebSocketClient* client = mirrorSocket->client(id);
+    if (client == nullptr) {
+      continue;
+    }
+    
+    // Volle Warteschlange: Kacheln bleiben ausstehend und gehen später
+    // mit dem dann aktuellen Inhalt raus
+    int sent = 0;
+    while (pending.any() && sent < MIRROR_MESSAGES_PER_UPDATE) {
+      if (client->queueIsFull()) {
+        mirrorStats.skipped++;
+        break;
+      }
+      size_t length = screenMirror->encode(*front, pending, mirrorBuffer, MIRROR_MESSAGE_MAX);
+      if (length == 0) {
+        break;
+      }
+      client->binary(mirrorBuffer, length);
+      mirrorStats.messages++;
+      mirrorStats.bytes += length;
+      sent++;
+    }
+    
+    portENTER_CRITICAL(&mirrorLock);
+    if (mirrorClients[i].active && mirrorClients[i].id == id) {
+      mirrorClients[i].pending = pending;
+    }
+    portEXIT_CRITICAL(&mirrorLock);
+  }
 }
 
 void WebServerManager::handleScanBLE(AsyncWebServerRequest* request) {
@@ -122,25 +871,103 @@ void WebServerManager::handleScanBLE(AsyncWebServerRequest* request) {
     dev["rssi"] = device.rssi;
   });
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
+}
+
+// Ein BT-Gerät als JSON (ArduinoJson kopiert die char-Puffer)
+static void fillBTDevice(JsonObject dev, const BtDevice& device, uint32_t now) {
+  char address[18];
+  BtDeviceTable::formatAddress(device.address, address);
+  dev["address"] = address;
+  dev["name"] = (char*)device.name;
+  if (device.lastRssi != BT_RSSI_NONE) {
+    dev["rssi"] = device.rssi;
+    dev["lastRssi"] = device.lastRssi;
+  }
+  dev["ageMs"] = now - device.lastSeenMs;
+  dev["sightings"] = device.sightings;
 }
 
 void WebServerManager::handleScanBT(AsyncWebServerRequest* request) {
-  StaticJsonDocument<2048> doc;
-  JsonArray devices = doc.createNestedArray("devices");
+  // Kehrt sofort zurück: startet die Suche oder hängt sich an die laufende.
+  // ?job=<id> fragt nur den Stand ab; laufend streamt /api/scan/bt/events.
+  uint32_t job = request->hasParam("job") ?
+    request->getParam("job")->value().toInt() : mouseHandler->startBTDiscovery();
   
-  mouseHandler->scanBTClassicMice([&devices](BTClassicDevice device) {
-    JsonObject dev = devices.createNestedObject();
-    dev["name"] = device.name;
-    dev["address"] = device.address;
-    dev["rssi"] = device.rssi;
-  });
+  BtDevice devices[BT_DISCOVERY_MAX_DEVICES];
+  uint32_t seq;
+  int n = mouseHandler->getBTDevices(devices, BT_DISCOVERY_MAX_DEVICES, 0, seq);
+  uint32_t now = millis();
+  
+  StaticJsonDocument<3072> doc;
+  doc["job"] = job;
+  doc["state"] = mouseHandler->isBTDiscoveryRunning() ? "running" : "done";
+  doc["seq"] = seq;
+  
+  JsonArray list = doc.createNestedArray("devices");
+  for (int i = 0; i < n; i++) {
+    fillBTDevice(list.createNestedObject(), devices[i], now);
+  }
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
+}
+
+void WebServerManager::handleDiscoveryConnect(AsyncEventSourceClient* client) {
+  // Läuft im async_tcp-Task: bisherige Funde einzeln nachliefern, neue
+  // kommen über updateDiscovery() an alle Clients
+  uint32_t job = mouseHandler->startBTDiscovery();
+  
+  BtDevice devices[BT_DISCOVERY_MAX_DEVICES];
+  uint32_t seq;
+  int n = mouseHandler->getBTDevices(devices, BT_DISCOVERY_MAX_DEVICES, 0, seq);
+  uint32_t now = millis();
+  char buffer[DISCOVERY_EVENT_MAX];
+  
+  StaticJsonDocument<64> state;
+  state["job"] = job;
+  state["running"] = mouseHandler->isBTDiscoveryRunning();
+  serializeJson(state, buffer, sizeof(buffer));
+  client->send(buffer, "job", seq);
+  
+  for (int i = 0; i < n; i++) {
+    StaticJsonDocument<DISCOVERY_EVENT_MAX> doc;
+    fillBTDevice(doc.to<JsonObject>(), devices[i], now);
+    serializeJson(doc, buffer, sizeof(buffer));
+    client->send(buffer, "device", devices[i].seq);
+  }
+}
+
+void WebServerManager::updateDiscovery() {
+  if (discoveryEvents == nullptr) {
+    return;
+  }
+  
+  bool running = mouseHandler->isBTDiscoveryRunning();
+  if (!running && !discoveryStreaming) {
+    return;
+  }
+  
+  // Nur Einträge, die seit dem letzten Lauf neu oder aktualisiert sind
+  BtDevice devices[BT_DISCOVERY_MAX_DEVICES];
+  uint32_t seq;
+  int n = mouseHandler->getBTDevices(devices, BT_DISCOVERY_MAX_DEVICES, discoveryStreamSeq, seq);
+  discoveryStreamSeq = seq;
+  
+  if (discoveryEvents->count() > 0) {
+    uint32_t now = millis();
+    char buffer[DISCOVERY_EVENT_MAX];
+    for (int i = 0; i < n; i++) {
+      StaticJsonDocument<DISCOVERY_EVENT_MAX> doc;
+      fillBTDevice(doc.to<JsonObject>(), devices[i], now);
+      serializeJson(doc, buffer, sizeof(buffer));
+      discoveryEvents->send(buffer, "device", devices[i].seq);
+    }
+    if (!running) {
+      discoveryEvents->send("{}", "done", seq);
+    }
+  }
+  
+  discoveryStreaming = running;
 }
 
 void WebServerManager::handleScanUSB(AsyncWebServerRequest* request) {
@@ -154,27 +981,39 @@ void WebServerManager::handleScanUSB(AsyncWebServerRequest* request) {
     dev["productId"] = device.productId;
   });
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
 }
 
 void WebServerManager::handleScanWiFi(AsyncWebServerRequest* request) {
-  StaticJsonDocument<2048> doc;
-  JsonArray networks = doc.createNestedArray("networks");
+  // Kehrt sofort zurück: Cache, oder Job-ID mit bisherigen Ergebnissen.
+  // ?job=<id> fragt nur den Stand ab, ?refresh=1 erzwingt einen neuen Scan.
+  if (!request->hasParam("job")) {
+    networkManager->requestScan(request->hasParam("refresh"));
+  }
+  
+  WiFiNetwork results[WIFI_SCAN_MAX_RESULTS];
+  WiFiScanStatus status;
+  int n = networkManager->getScanResults(results, WIFI_SCAN_MAX_RESULTS, status);
   
-  int n = networkManager->scanNetworks();
+  StaticJsonDocument<2560> doc;
+  doc["job"] = status.jobId;
+  doc["state"] = status.running ? "running" : "done";
+  doc["channel"] = status.channel;
+  doc["channels"] = WIFI_SCAN_CHANNELS;
+  if (!status.running) {
+    doc["ageMs"] = status.ageMs;
+  }
   
+  JsonArray networks = doc.createNestedArray("networks");
   for (int i = 0; i < n; i++) {
     JsonObject net = networks.createNestedObject();
-    net["ssid"] = networkManager->getScannedSSID(i);
-    net["rssi"] = networkManager->getScannedRSSI(i);
-    net["encrypted"] = networkManager->getScannedEncryption(i);
+    net["ssid"] = (const char*)results[i].ssid;
+    net["rssi"] = results[i].rssi;
+    net["channel"] = results[i].channel;
+    net["encrypted"] = results[i].encrypted;
   }
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
 }
 
 void WebServerManager::handleConnectMouse(AsyncWebServerRequest* request) {
@@ -183,16 +1022,18 @@ void WebServerManager::handleConnectMouse(AsyncWebServerRequest* request) {
     return;
   }
   
+  // type=bt: Adresse aus der BT-Classic-Suche, sonst BLE
   String address = request->getParam("address", true)->value();
-  bool success = mouseHandler->connectBLEMouse(address.c_str());
+  bool classic = request->hasParam("type", true) &&
+                 request->getParam("type", true)->value() == "bt";
+  bool success = classic ? mouseHandler->connectBTClassicMouse(address.c_str()) :
+                           mouseHandler->connectBLEMouse(address.c_str());
   
   StaticJsonDocument<128> doc;
   doc["success"] = success;
   doc["message"] = success ? "Verbunden" : "Verbindung fehlgeschlagen";
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
 }
 
 void WebServerManager::handleConnectWiFi(AsyncWebServerRequest* request) {
@@ -204,15 +1045,14 @@ void WebServerManager::handleConnectWiFi(AsyncWebServerRequest* request) {
   String ssid = request->getParam("ssid", true)->value();
   String password = request->getParam("password", true)->value();
   
+  // Kehrt sofort zurück; den Verlauf zeigt /api/status (stationState)
   bool success = networkManager->connectToWiFi(ssid.c_str(), password.c_str());
   
   StaticJsonDocument<128> doc;
   doc["success"] = success;
-  doc["message"] = success ? "Verbunden" : "Verbindung fehlgeschlagen";
+  doc["message"] = success ? "Verbindung wird aufgebaut" : "Ungültige SSID";
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
 }
 
 void WebServerManager::handleDisconnect(AsyncWebServerRequest* request) {
@@ -222,196 +1062,181 @@ void WebServerManager::handleDisconnect(AsyncWebServerRequest* request) {
   doc["success"] = true;
   doc["message"] = "Getrennt";
   
-  String response;
-  serializeJson(doc, response);
-  request->send(200, "application/json", response);
+  sendJson(request, doc);
 }
 
 void WebServerManager::handleOTAUpload(AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final) {
   if (!index) {
-    Serial.printf("[OTA] Update Start: %s\n", filename.c_str());
-    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
-      Update.printError(Serial);
+    // Schreibt gerade ein anderer Upload, wird dieser komplett verworfen
+    // (Antwort 409 in handleOTAResult)
+    if (otaUpdater.isClaimed()) {
+      Serial.printf("[OTA] Upload %s abgewiesen - anderer Upload läuft\n", filename.c_str());
+      return;
     }
+    Serial.printf("[OTA] Update Start: %s\n", filename.c_str());
+    const char* sha256 = request->hasParam("sha256") ?
+      request->getParam("sha256")->value().c_str() : nullptr;
+    // Content-Length enthält den Multipart-Rahmen - genügt für die Anzeige
+    otaUpdater.begin(sha256, request->contentLength());
+    otaUpdater.claim(request, 0);
+    otaSessionName[0] = '\0';
+    request->onDisconnect([this, request]() {
+      otaUpdater.release(request);
+    });
+  }
+  
+  if (!otaUpdater.isWriter(request)) {
+    return;
   }
   
   if (len) {
-    if (Update.write(data, len) != len) {
-      Update.printError(Serial);
-    }
+    otaUpdater.process(data, len);
   }
   
   if (final) {
-    if (Update.end(true)) {
-      Serial.printf("[OTA] Update erfolgreich: %u bytes\n", index + len);
-    } else {
-      Update.printError(Serial);
-    }
-  }
-}
-
-const char* WebServerManager::getIndexHTML() {
-  return R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-<meta charset="UTF-8">
-<meta name="viewport" content="width=device-width, initial-scale=1.0">
-<title>LilyGoMaus Control</title>
-<style>
-body{font-family:Arial,sans-serif;max-width:800px;margin:20px auto;padding:20px;background:#1a1a1a;color:#fff}
-h1,h2{color:#4CAF50}
-button{background:#4CAF50;color:#fff;border:none;padding:10px 20px;margin:5px;cursor:pointer;border-radius:4px}
-button:hover{background:#45a049}
-button:disabled{background:#666;cursor:not-allowed}
-.status{background:#2a2a2a;padding:15px;border-radius:8px;margin:10px 0}
-.device-list{background:#333;padding:10px;border-radius:4px;max-height:300px;overflow-y:auto}
-.device-item{padding:8px;margin:5px 0;background:#444;border-radius:4px;display:flex;justify-content:space-between;align-items:center}
-input{padding:8px;margin:5px;border:1px solid #666;border-radius:4px;background:#2a2a2a;color:#fff;min-width:200px}
-.error{color:#f44336}
-.success{color:#4CAF50}
-#mouseStatus{font-size:18px;font-weight:bold}
-</style>
-</head>
-<body>
-<h1>🖱️ LilyGoMaus Control</h1>
-
-<div class="status">
-  <h2>Status</h2>
-  <div id="mouseStatus">Maus: Nicht verbunden</div>
-  <div>AP: <span id="apInfo">-</span></div>
-  <div>Station: <span id="stationInfo">Nicht verbunden</span></div>
-</div>
-
-<h2>🔍 BLE-Mäuse scannen</h2>
-<button onclick="scanBLE()">Scan starten</button>
-<div id="bleDevices" class="device-list"></div>
-
-<h2>📶 WiFi-Netzwerke</h2>
-<button onclick="scanWiFi()">Scan starten</button>
-<div id="wifiNetworks" class="device-list"></div>
-
-<h2>🔌 Maus trennen</h2>
-<button onclick="disconnect()">Trennen</button>
-
-<h2>📦 Firmware-Update (OTA)</h2>
-<input type="file" id="otaFile" accept=".bin">
-<button onclick="uploadOTA()">Upload</button>
-<div id="otaStatus"></div>
-
-<script>
-let statusInterval;
-
-async function updateStatus(){
-  try{
-    const res=await fetch('/api/status');
-    const data=await res.json();
-    
-    document.getElementById('mouseStatus').innerHTML=
-      'Maus: '+(data.mouseConnected?
-        '<span class="success">Verbunden ('+data.mouseX+','+data.mouseY+')</span>':
-        '<span class="error">Nicht verbunden</span>');
-    
-    document.getElementById('apInfo').textContent=data.apSSID+' ('+data.apIP+')';
-    document.getElementById('stationInfo').textContent=
-      data.stationConnected?'Verbunden ('+data.stationIP+')':'Nicht verbunden';
-  }catch(e){console.error(e)}
-}
-
-async function scanBLE(){
-  document.getElementById('bleDevices').innerHTML='<div>Scanne...</div>';
-  try{
-    const res=await fetch('/api/scan/ble');
-    const data=await res.json();
-    let html='';
-    data.devices.forEach(d=>{
-      html+=`<div class="device-item">
-        <span>${d.name} (${d.address}) RSSI:${d.rssi}</span>
-        <button onclick="connectMouse('${d.address}')">Verbinden</button>
-      </div>`;
-    });
-    document.getElementById('bleDevices').innerHTML=html||'<div>Keine Geräte gefunden</div>';
-  }catch(e){
-    document.getElementById('bleDevices').innerHTML='<div class="error">Fehler beim Scan</div>';
-  }
-}
-
-async function scanWiFi(){
-  document.getElementById('wifiNetworks').innerHTML='<div>Scanne...</div>';
-  try{
-    const res=await fetch('/api/scan/wifi');
-    const data=await res.json();
-    let html='';
-    data.networks.forEach(n=>{
-      html+=`<div class="device-item">
-        <span>${n.ssid} (RSSI:${n.rssi}) ${n.encrypted?'🔒':''}</span>
-        <button onclick="connectWiFi('${n.ssid}')">Verbinden</button>
-      </div>`;
+    otaUpdater.finish();
+  }
+}
+
+void WebServerManager::handleOTAResult(AsyncWebServerRequest* request) {
+  if (!otaUpdater.release(request)) {
+    StaticJsonDocument<128> doc;
+    doc["success"] = false;
+    doc["message"] = "Anderer Upload läuft";
+    sendJson(request, doc, 409);
+    return;
+  }
+  
+  OtaStats stats = otaUpdater.getStats();
+  bool success = stats.success && !otaUpdater.hasError();
+  uint32_t ms = stats.durationMs ? stats.durationMs : 1;
+  
+  StaticJsonDocument<384> doc;
+  doc["success"] = success;
+  doc["message"] = success ? "Update erfolgreich" :
+    (otaUpdater.hasError() ? otaUpdater.getError() : "Upload unvollständig");
+  doc["compressed"] = stats.compressed;
+  doc["received"] = stats.received;
+  doc["written"] = stats.written;
+  doc["durationMs"] = stats.durationMs;
+  // Effektiv = Image-Bytes pro Sekunde (mit roher .bin identisch mit Übertragung)
+  doc["transferKBps"] = stats.received / ms;
+  doc["effectiveKBps"] = stats.written / ms;
+  sendJson(request, doc);
+  
+  if (success) {
+    restartAtMs = millis() + OTA_RESTART_DELAY_MS;
+  }
+}
+
+void WebServerManager::handleOTABegin(AsyncWebServerRequest* request) {
+  if (!request->hasParam("size") || !request->hasParam("name")) {
+    request->send(400, "text/plain", "Missing size or name parameter");
+    return;
+  }
+  
+  uint32_t size = request->getParam("size")->value().toInt();
+  const String& name = request->getParam("name")->value();
+  
+  // Gleiche Datei, Sitzung noch offen: am bisherigen Offset fortsetzen
+  OtaStats stats = otaUpdater.getStats();
+  if (otaUpdater.isActive() && !otaUpdater.hasError() && !otaUpdater.isClaimed() &&
+      stats.uploadSize == size && strncmp(otaSessionName, name.c_str(), OTA_SESSION_NAME_MAX - 1) == 0) {
+    Serial.printf("[OTA] Setze %s bei %u/%u Bytes fort\n", otaSessionName, stats.received, size);
+    sendOTAState(request, 200);
+    return;
+  }
+  if (otaUpdater.isClaimed()) {
+    sendOTAState(request, 409);  // Anderer Upload schreibt gerade
+    return;
+  }
+  
+  strncpy(otaSessionName, name.c_str(), OTA_SESSION_NAME_MAX - 1);
+  otaSessionName[OTA_SESSION_NAME_MAX - 1] = '\0';
+  Serial.printf("[OTA] Update Start: %s (%u Bytes, in Stücken)\n", otaSessionName, size);
+  
+  const char* sha256 = request->hasParam("sha256") ?
+    request->getParam("sha256")->value().c_str() : nullptr;
+  otaUpdater.begin(sha256, size);
+  sendOTAState(request, 200);
+}
+
+void WebServerManager::handleOTAChunkData(AsyncWebServerRequest* request, uint8_t* data,
+                                          size_t len, size_t index) {
+  if (index == 0) {
+    // Nur ein Stück genau am aktuellen Offset wird angenommen
+    if (!request->hasParam("offset") ||
+        !otaUpdater.claim(request, request->getParam("offset")->value().toInt())) {
+      return;
+    }
+    // Abbruch mitten im Stück: Offset bleibt bei den bereits geschriebenen Bytes
+    request->onDisconnect([this, request]() {
+      otaUpdater.release(request);
     });
-    document.getElementById('wifiNetworks').innerHTML=html||'<div>Keine Netzwerke gefunden</div>';
-  }catch(e){
-    document.getElementById('wifiNetworks').innerHTML='<div class="error">Fehler beim Scan</div>';
-  }
-}
-
-async function connectMouse(addr){
-  try{
-    const form=new FormData();
-    form.append('address',addr);
-    const res=await fetch('/api/connect/mouse',{method:'POST',body:form});
-    const data=await res.json();
-    alert(data.message);
-    updateStatus();
-  }catch(e){alert('Fehler: '+e)}
-}
-
-async function connectWiFi(ssid){
-  const pass=prompt('Passwort für '+ssid+':');
-  if(!pass)return;
-  try{
-    const form=new FormData();
-    form.append('ssid',ssid);
-    form.append('password',pass);
-    const res=await fetch('/api/connect/wifi',{method:'POST',body:form});
-    const data=await res.json();
-    alert(data.message);
-    updateStatus();
-  }catch(e){alert('Fehler: '+e)}
-}
-
-async function disconnect(){
-  try{
-    const res=await fetch('/api/disconnect',{method:'POST'});
-    const data=await res.json();
-    alert(data.message);
-    updateStatus();
-  }catch(e){alert('Fehler: '+e)}
-}
-
-async function uploadOTA(){
-  const file=document.getElementById('otaFile').files[0];
-  if(!file){alert('Keine Datei ausgewählt');return;}
-  
-  const form=new FormData();
-  form.append('file',file);
-  
-  document.getElementById('otaStatus').innerHTML='<div>Uploading...</div>';
-  
-  try{
-    const res=await fetch('/api/ota',{method:'POST',body:form});
-    const text=await res.text();
-    document.getElementById('otaStatus').innerHTML=
-      text==='OK'?'<div class="success">Update erfolgreich! ESP startet neu...</div>':
-      '<div class="error">Update fehlgeschlagen</div>';
-  }catch(e){
-    document.getElementById('otaStatus').innerHTML='<div class="error">Fehler: '+e+'</div>';
-  }
-}
-
-updateStatus();
-statusInterval=setInterval(updateStatus,2000);
-</script>
-</body>
-</html>
-)rawliteral";
+  }
+  
+  if (!otaUpdater.isWriter(request)) {
+    return;
+  }
+  
+  otaUpdater.process(data, len);
+  if (otaUpdater.isComplete() && !otaUpdater.hasError()) {
+    otaUpdater.finish();
+  }
+}
+
+void WebServerManager::handleOTAChunkResult(AsyncWebServerRequest* request) {
+  // Nur der schreibende Request gibt die Sperre frei - ein abgewiesener
+  // (Offset falsch, Stück schon vergeben) darf sie nicht lösen
+  bool accepted = otaUpdater.release(request);
+  
+  if (otaUpdater.hasError()) {
+    sendOTAState(request, 500);
+    return;
+  }
+  if (!accepted) {
+    sendOTAState(request, 409);  // Falscher Offset - Client liest "offset" und setzt dort fort
+    return;
+  }
+  
+  sendOTAState(request, 200);
+  if (otaUpdater.getStats().success) {
+    restartAtMs = millis() + OTA_RESTART_DELAY_MS;
+  }
+}
+
+OtaStats WebServerManager::getOtaStats() {
+  return otaUpdater.getStats();
+}
+
+const char* WebServerManager::getOtaError() {
+  return otaUpdater.getError();
+}
+
+bool WebServerManager::isRestartDue() {
+  return restartAtMs != 0 && (int32_t)(millis() - restartAtMs) >= 0;
+}
+
+void WebServerManager::sendOTAState(AsyncWebServerRequest* request, int code) {
+  OtaStats stats = otaUpdater.getStats();
+  uint32_t ms = stats.durationMs ? stats.durationMs : 1;
+  
+  StaticJsonDocument<384> doc;
+  doc["active"] = stats.active;
+  doc["success"] = stats.success;
+  doc["offset"] = stats.received;
+  doc["size"] = stats.uploadSize;
+  doc["name"] = (const char*)otaSessionName;
+  doc["compressed"] = stats.compressed;
+  if (otaUpdater.hasError()) {
+    doc["message"] = otaUpdater.getError();
+  }
+  if (stats.success) {
+    doc["written"] = stats.written;
+    doc["durationMs"] = stats.durationMs;
+    doc["transferKBps"] = stats.received / ms;
+    doc["effectiveKBps"] = stats.written / ms;
+  }
+  
+  sendJson(request, doc, code);
 }
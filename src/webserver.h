@@ -11,19 +11,143 @@
 #include <Update.h>
 #include "mouse_handler.h"
 #include "network.h"
+#include "latency_stats.h"
+#include "loop_scheduler.h"
+#include "display.h"
+#include "frame_pacer.h"
+#include "frame_governor.h"
+#include "screen_mirror.h"
+#include "telemetry.h"
+#include "web_assets.h"
+#include "response_pool.h"
+#include "ota_update.h"
+
+// JSON-Antworten: feste Puffer statt String je Request (einer pro AP-Client)
+#define JSON_RESPONSE_BUFFERS AP_MAX_CONNECTIONS
+#define JSON_RESPONSE_BUFFER_SIZE 2048
+
+// /api/perf: Schlüssel und Strings sind Literale (nur Zeiger), der Bedarf
+// ergibt sich allein aus der Zahl der Einträge je Objekt
+#define PERF_JSON_CAPACITY ( \
+  JSON_OBJECT_SIZE(14) +                                       /* Wurzel */ \
+  JSON_OBJECT_SIZE(TASK_COUNT) + TASK_COUNT * JSON_OBJECT_SIZE(5) + /* tasks */ \
+  JSON_OBJECT_SIZE(10) + JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(5) + /* display, animations, textCache */ \
+  JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(8) +                  /* frames, budget */ \
+  JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(4) +                  /* telemetry, mirror */ \
+  JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(5)) /* station, heap, responses */
+
+// Neustart nach erfolgreichem OTA erst, wenn die Antwort raus ist (aus loop())
+#define OTA_RESTART_DELAY_MS 500
+#define OTA_SESSION_NAME_MAX 32
+
+// Bildschirm-Spiegelung über WebSocket /ws/screen
+#define MIRROR_MAX_CLIENTS AP_MAX_CONNECTIONS
+#define MIRROR_MESSAGE_MAX 4096
+#define MIRROR_MESSAGES_PER_UPDATE 4
+
+// Je Client eigene ausstehende Kacheln: ein langsamer Browser bekommt
+// übersprungene Frames zusammengefasst, statt loop() aufzuhalten
+struct MirrorClient {
+  bool active;
+  uint32_t id;
+  TileSet pending;
+};
+
+// Live-Telemetrie über WebSocket /ws/telemetry (Format siehe telemetry.h)
+#define TELEMETRY_MAX_CLIENTS AP_MAX_CONNECTIONS
+#define TELEMETRY_FRAME_MAX (TELEMETRY_HEADER_SIZE + TELEMETRY_STATUS_SIZE + TELEMETRY_LOST_SIZE + \
+                             BUTTON_EVENT_CAPACITY * TELEMETRY_BUTTON_SIZE + TELEMETRY_MOTION_SIZE)
+
+// Je Client eigene Rate und eigener Stand: Bewegung zwischen zwei Frames
+// wird zur letzten Position zusammengefasst, Tasten-Flanken gehen alle raus
+// (überschriebene meldet ein TELEMETRY_LOST-Eintrag)
+struct TelemetryClient {
+  bool active;
+  bool fresh;  // Noch kein Frame gesendet
+  uint32_t id;
+  uint32_t intervalUs;
+  uint32_t lastSendUs;
+  uint32_t lastStatusUs;
+  uint32_t buttonCursor;
+  uint32_t lastReports;
+  int lastX, lastY;
+  uint8_t lastButtons;
+  uint8_t lastFlags;
+  uint16_t sequence;
+};
+
+// Bluetooth-Gerätesuche: Funde als SSE-Events auf /api/scan/bt/events
+#define DISCOVERY_EVENT_MAX 192
+
+struct TelemetryStats {
+  uint8_t clients;
+  uint32_t frames;
+  uint64_t bytes;
+  uint32_t skipped;  // Frames wegen voller Sendewarteschlange ausgelassen
+  uint32_t lostButtons;  // Tasten-Flanken, die ein Client nie bekam
+};
+
+struct MirrorStats {
+  uint8_t clients;
+  uint32_t messages;
+  uint64_t bytes;
+  uint32_t skipped;  // Aktualisierungen wegen voller Sendewarteschlange ausgelassen
+};
 
 class WebServerManager {
 private:
   AsyncWebServer* server;
   MouseHandler* mouseHandler;
   NetworkManager* networkManager;
+  LatencyMonitor* latencyMonitor;
+  LoopScheduler* loopScheduler;
+  DisplayManager* displayManager;
+  FramePacer* framePacer;
+  FrameGovernor* frameGovernor;
+  
+  // Bildschirm-Spiegelung
+  ScreenMirror* screenMirror;
+  AsyncWebSocket* mirrorSocket;
+  MirrorClient mirrorClients[MIRROR_MAX_CLIENTS];
+  portMUX_TYPE mirrorLock;
+  uint8_t* mirrorBuffer;
+  MirrorStats mirrorStats;
+  
+  // Live-Telemetrie
+  AsyncWebSocket* telemetrySocket;
+  TelemetryClient telemetryClients[TELEMETRY_MAX_CLIENTS];
+  portMUX_TYPE telemetryLock;
+  uint8_t telemetryBuffer[TELEMETRY_FRAME_MAX];
+  TelemetryStats telemetryStats;
+  
+  // Bluetooth-Gerätesuche (Stream an alle SSE-Clients)
+  AsyncEventSource* discoveryEvents;
+  uint32_t discoveryStreamSeq;  // Zuletzt gestreamte Änderung
+  bool discoveryStreaming;      // Job lief beim letzten update
+  
+  ResponsePool responsePool;
+  OtaUpdater otaUpdater;
+  char otaSessionName[OTA_SESSION_NAME_MAX];  // Fortsetzbarer Upload (Dateiname)
+  uint32_t restartAtMs;                        // 0 = kein Neustart geplant
   
-  // HTML-Interface (inline)
-  const char* getIndexHTML();
+  // Tasten-Flanken für /api/status
+  static const int MAX_STATUS_EVENTS = 8;
+  uint32_t buttonEventCursor;
+  uint32_t leftClicks;
+  uint32_t rightClicks;
+  uint32_t skippedButtonEvents;  // Wegen Überlauf verpasste Flanken
+  
+  // JSON direkt in einen Pool-Puffer serialisieren und senden
+  void sendJson(AsyncWebServerRequest* request, const JsonDocument& doc, int code = 200);
   
   // Request-Handler
-  void handleRoot(AsyncWebServerRequest* request);
+  void handleAsset(AsyncWebServerRequest* request, const WebAsset* asset);
   void handleStatus(AsyncWebServerRequest* request);
+  void handleLatency(AsyncWebServerRequest* request);
+  void handlePerf(AsyncWebServerRequest* request);
+  void handleTraceStatus(AsyncWebServerRequest* request);
+  void handleTraceDownload(AsyncWebServerRequest* request);
+  void handleScreenshot(AsyncWebServerRequest* request);
   void handleScanBLE(AsyncWebServerRequest* request);
   void handleScanBT(AsyncWebServerRequest* request);
   void handleScanUSB(AsyncWebServerRequest* request);
@@ -32,11 +156,46 @@ private:
   void handleConnectWiFi(AsyncWebServerRequest* request);
   void handleDisconnect(AsyncWebServerRequest* request);
   void handleOTAUpload(AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final);
+  void handleOTAResult(AsyncWebServerRequest* request);
+  void handleOTABegin(AsyncWebServerRequest* request);
+  void handleOTAChunkData(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index);
+  void handleOTAChunkResult(AsyncWebServerRequest* request);
+  void sendOTAState(AsyncWebServerRequest* request, int code);
+  void handleDiscoveryConnect(AsyncEventSourceClient* client);
+  void handleMirrorEvent(AsyncWebSocketClient* client, AwsEventType type);
+  void handleTelemetryEvent(AsyncWebSocketClient* client, AwsEventType type,
+                            void* arg, uint8_t* data, size_t len);
+  size_t buildTelemetryFrame(TelemetryClient& state, const MouseData& data,
+                             uint8_t flags, uint32_t now);
 
 public:
   WebServerManager();
   
   bool begin(MouseHandler* mouseHandler, NetworkManager* networkManager);
+  
+  // Optionale Module (vor begin() setzen)
+  void setLatencyMonitor(LatencyMonitor* monitor);
+  void setLoopScheduler(LoopScheduler* scheduler);
+  void setDisplayManager(DisplayManager* display);
+  void setFramePacer(FramePacer* pacer);
+  void setFrameGovernor(FrameGovernor* governor);
+  void setScreenMirror(ScreenMirror* mirror);
+  
+  // Geänderte Kacheln an die Spiegel-Clients senden (aus loop())
+  void updateMirror();
+  
+  // Web-OTA für die Anzeige in loop() (Fortschritt, Fehler, Neustart)
+  OtaStats getOtaStats();
+  const char* getOtaError();
+  bool isRestartDue();
+  
+  // Telemetrie-Frames an fällige Clients senden (aus loop()); Intervall in
+  // ms für den Loop-Scheduler, 0 ohne verbundene Clients
+  void updateTelemetry();
+  uint32_t getTelemetryInterval();
+  
+  // Neue BT-Funde an die SSE-Clients streamen (aus loop())
+  void updateDiscovery();
 };
 
 #endif
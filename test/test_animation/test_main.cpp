@@ -0,0 +1,79 @@
+/**
+ * Host-Tests: AnimationEngine (Easing, Ablauf, Zusammenfassen, Pool)
+ */
+
+#include <unity.h>
+#include "animation.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_easing_curves() {
+  TEST_ASSERT_EQUAL_UINT16(0, AnimationEngine::ease(EASE_OUT_QUAD, 0));
+  TEST_ASSERT_EQUAL_UINT16(ANIMATION_PROGRESS_MAX, AnimationEngine::ease(EASE_OUT_QUAD, ANIMATION_PROGRESS_MAX));
+  TEST_ASSERT_EQUAL_UINT16(512, AnimationEngine::ease(EASE_LINEAR, 512));
+  TEST_ASSERT_EQUAL_UINT16(768, AnimationEngine::ease(EASE_OUT_QUAD, 512));
+  TEST_ASSERT_EQUAL_UINT16(896, AnimationEngine::ease(EASE_OUT_CUBIC, 512));
+
+  // Über das Ende hinaus bleibt der Fortschritt beim Maximum
+  TEST_ASSERT_EQUAL_UINT16(ANIMATION_PROGRESS_MAX, AnimationEngine::ease(EASE_LINEAR, 5000));
+}
+
+void test_effect_runs_for_its_duration() {
+  AnimationEngine engine;
+  AnimationEffect& effect = engine.trigger(50, 50, 1, 1000, EASE_LINEAR);
+
+  TEST_ASSERT_TRUE(engine.advance(effect, 1000 + ANIMATION_DURATION_US / 4));
+  TEST_ASSERT_EQUAL_UINT16(ANIMATION_PROGRESS_MAX / 4, effect.progress);
+  TEST_ASSERT_TRUE(engine.advance(effect, 1000 + ANIMATION_DURATION_US - 1));
+  TEST_ASSERT_FALSE(engine.advance(effect, 1000 + ANIMATION_DURATION_US));
+  TEST_ASSERT_FALSE(effect.active);
+  TEST_ASSERT_EQUAL_UINT8(0, engine.getStats().active);
+}
+
+void test_repeated_trigger_coalesces() {
+  AnimationEngine engine;
+  AnimationEffect& first = engine.trigger(50, 50, 1, 0);
+  engine.advance(first, 100000);
+
+  // Gleiche Art in der Nähe: derselbe Effekt startet neu
+  AnimationEffect& again = engine.trigger(53, 52, 1, 120000);
+  TEST_ASSERT_EQUAL_PTR(&first, &again);
+  TEST_ASSERT_EQUAL_UINT32(120000, again.startUs);
+  TEST_ASSERT_EQUAL_UINT16(0, again.progress);
+
+  // Andere Art an derselben Stelle: eigener Effekt
+  AnimationEffect& other = engine.trigger(50, 50, 2, 130000);
+  TEST_ASSERT_TRUE(&other != &first);
+
+  AnimationStats stats = engine.getStats();
+  TEST_ASSERT_EQUAL_UINT32(3, stats.triggered);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.coalesced);
+  TEST_ASSERT_EQUAL_UINT8(2, stats.active);
+}
+
+void test_full_pool_recycles_oldest() {
+  AnimationEngine engine;
+  for (int i = 0; i < ANIMATION_POOL_SIZE; i++) {
+    AnimationEffect& effect = engine.trigger(i * 30, 10, 1, 1000 + i * 10);
+    effect.footprint = Rect::make(i * 30, 0, 20, 20);
+  }
+
+  AnimationEffect& recycled = engine.trigger(100, 100, 1, 5000);
+  TEST_ASSERT_EQUAL_PTR(&engine.get(0), &recycled);
+
+  // Footprint des ersetzten Effekts bleibt zum Löschen erhalten
+  TEST_ASSERT_EQUAL_INT(0, recycled.footprint.x);
+  TEST_ASSERT_EQUAL_INT(20, recycled.footprint.w);
+  TEST_ASSERT_EQUAL_INT(100, recycled.x);
+  TEST_ASSERT_EQUAL_UINT32(1, engine.getStats().recycled);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_easing_curves);
+  RUN_TEST(test_effect_runs_for_its_duration);
+  RUN_TEST(test_repeated_trigger_coalesces);
+  RUN_TEST(test_full_pool_recycles_oldest);
+  return UNITY_END();
+}
@@ -0,0 +1,254 @@
+/**
+ * Benchmark: Pixel und SPI-Transaktionen je Klick-Effekt
+ * Über den ganzen Effektverlauf (Wachstum 0..ANIMATION_GROWTH) auf einem
+ * MemoryBackend, vorher gegen nachher:
+ *   vorher  - drawCircle/drawLine/fillCircle wie zuvor über TFT_eSPI
+ *             (sin/cos in double, Kreis Pixel für Pixel wie in der alten
+ *             SPI-Schätzung, Linien in Läufen wie TFT_eSPI::drawLine)
+ *   nachher - effect_raster aus den Compile-Zeit-Tabellen
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <chrono>
+#include "display_backend.h"
+#include "effect_raster.h"
+
+#define BENCH_WIDTH 240
+#define BENCH_HEIGHT 135
+#define BENCH_CENTER_X 120
+#define BENCH_CENTER_Y 67
+#define BENCH_GROWTH 30      // ANIMATION_GROWTH
+#define BENCH_CURSOR_SIZE 5  // CURSOR_SIZE
+#define BENCH_REPEAT 2000
+
+#define RING_COLOR 0x07FF
+#define RAY_COLOR 0xF81F
+
+struct EffectCost {
+  uint32_t transactions;
+  uint64_t bytes;
+  uint64_t pixels;
+  double nsPerFrame;
+};
+
+// ========== Vorher (Nachbau der alten Zeichenaufrufe) ==========
+
+static void legacyCircle(DisplayBackend& target, int x0, int y0, int r, uint16_t color) {
+  // Mittelpunkt-Algorithmus, ein Fenster pro Pixel
+  int f = 1 - r;
+  int ddFx = 1;
+  int ddFy = -2 * r;
+  int x = 0;
+  int y = r;
+  target.drawPixel(x0, y0 + r, color);
+  target.drawPixel(x0, y0 - r, color);
+  target.drawPixel(x0 + r, y0, color);
+  target.drawPixel(x0 - r, y0, color);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    target.drawPixel(x0 + x, y0 + y, color);
+    target.drawPixel(x0 - x, y0 + y, color);
+    target.drawPixel(x0 + x, y0 - y, color);
+    target.drawPixel(x0 - x, y0 - y, color);
+    target.drawPixel(x0 + y, y0 + x, color);
+    target.drawPixel(x0 - y, y0 + x, color);
+    target.drawPixel(x0 + y, y0 - x, color);
+    target.drawPixel(x0 - y, y0 - x, color);
+  }
+}
+
+static void legacyLine(DisplayBackend& target, int x0, int y0, int x1, int y1, uint16_t color) {
+  // Bresenham, Läufe entlang der Hauptachse als ein Fenster
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    int t = x0; x0 = y0; y0 = t;
+    t = x1; x1 = y1; y1 = t;
+  }
+  if (x0 > x1) {
+    int t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+  }
+  int dx = x1 - x0;
+  int dy = abs(y1 - y0);
+  int err = dx >> 1;
+  int ystep = y0 < y1 ? 1 : -1;
+  int runStart = x0;
+  for (int x = x0; x <= x1; x++) {
+    err -= dy;
+    if (err < 0 || x == x1) {
+      int len = x - runStart + 1;
+      if (steep) {
+        target.drawVLine(y0, runStart, len, color);
+      } else {
+        target.drawHLine(runStart, y0, len, color);
+      }
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+      runStart = x + 1;
+    }
+  }
+}
+
+static void legacyFillCircle(DisplayBackend& target, int x0, int y0, int r, uint16_t color) {
+  int x = 0;
+  int dx = 1;
+  int dy = r + r;
+  int p = -(r >> 1);
+  target.drawHLine(x0 - r, y0, dy + 1, color);
+  while (x < r) {
+    if (p >= 0) {
+      target.drawHLine(x0 - x, y0 + r, 2 * x + 1, color);
+      target.drawHLine(x0 - x, y0 - r, 2 * x + 1, color);
+      dy -= 2;
+      p -= dy;
+      r--;
+    }
+    dx += 2;
+    p += dx;
+    x++;
+    target.drawHLine(x0 - r, y0 + x, 2 * r + 1, color);
+    target.drawHLine(x0 - r, y0 - x, 2 * r + 1, color);
+  }
+}
+
+static void legacyRings(DisplayBackend& target, int growth) {
+  for (int i = 0; i < 3; i++) {
+    int radius = growth + i * 10;
+    if (radius < 50) {
+      legacyCircle(target, BENCH_CENTER_X, BENCH_CENTER_Y, radius, RING_COLOR);
+    }
+  }
+}
+
+static void legacyRays(DisplayBackend& target, int growth) {
+  int length = 10 + growth;
+  if (length > 30) length = 30;
+  for (int angle = 0; angle < 360; angle += 45) {
+    double rad = angle * M_PI / 180.0;
+    int x2 = BENCH_CENTER_X + (int)(cos(rad) * length);
+    int y2 = BENCH_CENTER_Y + (int)(sin(rad) * length);
+    legacyLine(target, BENCH_CENTER_X, BENCH_CENTER_Y, x2, y2, RAY_COLOR);
+  }
+}
+
+static void legacyCursor(DisplayBackend& target, int) {
+  legacyFillCircle(target, BENCH_CENTER_X, BENCH_CENTER_Y, BENCH_CURSOR_SIZE, 0xFFFF);
+}
+
+// ========== Nachher (wie DisplayManager bei voller Qualität) ==========
+
+static void tableRings(DisplayBackend& target, int growth) {
+  for (int i = 0; i < 3; i++) {
+    int radius = growth + i * 10;
+    if (radius <= EFFECT_MAX_RING_RADIUS) {
+      rasterRing(target, BENCH_CENTER_X, BENCH_CENTER_Y, radius, RING_COLOR);
+    }
+  }
+}
+
+static void tableRays(DisplayBackend& target, int growth) {
+  int length = 10 + growth;
+  if (length > EFFECT_MAX_RAY_LENGTH) length = EFFECT_MAX_RAY_LENGTH;
+  rasterRays(target, BENCH_CENTER_X, BENCH_CENTER_Y, length, true, RAY_COLOR);
+}
+
+static void tableCursor(DisplayBackend& target, int) {
+  rasterFilledCircle(target, BENCH_CENTER_X, BENCH_CENTER_Y, BENCH_CURSOR_SIZE, 0xFFFF);
+}
+
+// ========== Messung ==========
+
+typedef void (*EffectDraw)(DisplayBackend& target, int growth);
+
+static uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Einmal den ganzen Effektverlauf zählen, dann für die Zeit wiederholen
+static EffectCost measure(EffectDraw draw, MemoryBackend& backend) {
+  EffectCost cost;
+  backend.fillRect(0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0);
+  backend.resetBusStats();
+  for (int growth = 0; growth <= BENCH_GROWTH; growth++) {
+    draw(backend, growth);
+  }
+  DisplayBusStats bus = backend.getBusStats();
+  cost.transactions = bus.transactions;
+  cost.bytes = bus.bytes;
+  cost.pixels = (bus.bytes - (uint64_t)bus.transactions * SPI_WINDOW_OVERHEAD) / 2;
+
+  uint64_t start = wallNs();
+  for (int n = 0; n < BENCH_REPEAT; n++) {
+    draw(backend, n % (BENCH_GROWTH + 1));
+  }
+  cost.nsPerFrame = (double)(wallNs() - start) / BENCH_REPEAT;
+  return cost;
+}
+
+static void compare(const char* label, EffectDraw before, EffectDraw after,
+                    EffectCost& costBefore, EffectCost& costAfter) {
+  MemoryBackend backend(BENCH_WIDTH, BENCH_HEIGHT);
+  TEST_ASSERT_TRUE(backend.begin(false));
+  costBefore = measure(before, backend);
+  costAfter = measure(after, backend);
+
+  const int frames = BENCH_GROWTH + 1;
+  char line[200];
+  snprintf(line, sizeof(line),
+           "%s vorher:  %6.1f Transaktionen/Frame, %6.1f Pixel/Frame, %7.1f Bytes/Frame, %6.0f ns/Frame",
+           label, (double)costBefore.transactions / frames, (double)costBefore.pixels / frames,
+           (double)costBefore.bytes / frames, costBefore.nsPerFrame);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line),
+           "%s nachher: %6.1f Transaktionen/Frame, %6.1f Pixel/Frame, %7.1f Bytes/Frame, %6.0f ns/Frame",
+           label, (double)costAfter.transactions / frames, (double)costAfter.pixels / frames,
+           (double)costAfter.bytes / frames, costAfter.nsPerFrame);
+  TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_bench_rings() {
+  EffectCost before, after;
+  compare("Ringe", legacyRings, tableRings, before, after);
+
+  // Gleiche Kreislinie, aber Strecken statt einzelner Pixel
+  TEST_ASSERT_UINT32_WITHIN(before.pixels / 10, before.pixels, after.pixels);
+  TEST_ASSERT_LESS_THAN_UINT32(before.transactions / 2, after.transactions);
+  TEST_ASSERT_LESS_THAN(before.bytes / 2, after.bytes);
+}
+
+void test_bench_rays() {
+  EffectCost before, after;
+  compare("Strahlen", legacyRays, tableRays, before, after);
+
+  // Kreuz als zwei Linien statt vier, Mittelpunkt nur einmal
+  TEST_ASSERT_LESS_THAN_UINT32(before.transactions, after.transactions);
+  TEST_ASSERT_LESS_THAN(before.pixels, after.pixels);
+}
+
+void test_bench_cursor() {
+  EffectCost before, after;
+  compare("Cursor", legacyCursor, tableCursor, before, after);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(before.transactions, after.transactions);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_rings);
+  RUN_TEST(test_bench_rays);
+  RUN_TEST(test_bench_cursor);
+  return UNITY_END();
+}
@@ -0,0 +1,108 @@
+/**
+ * Benchmark: hidDecodeReport-Durchsatz je Extraktionsplan
+ * Boot-Protokoll (int8), 16-Bit-Achsen und Kombi-Gerät mit Report-ID,
+ * Wheel und AC Pan. Gemeldet werden Reports/s und ns pro Report (Host).
+ */
+
+#include <unity.h>
+#include <chrono>
+#include "hid_descriptor.h"
+
+#define BENCH_REPORTS 4000000
+#define BENCH_MIN_REPORTS_PER_S 1000000.0  // Weit über 8 kHz Polling
+
+// 5 Tasten, int16 X/Y, int8 Wheel (ohne Report-ID)
+static const uint8_t MOUSE_16BIT[] = {
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x05, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x05, 0x75, 0x01, 0x81, 0x02,
+  0x95, 0x01, 0x75, 0x03, 0x81, 0x01,
+  0x05, 0x01, 0x16, 0x01, 0x80, 0x26, 0xFF, 0x7F, 0x75, 0x10, 0x95, 0x02,
+  0x09, 0x30, 0x09, 0x31, 0x81, 0x06,
+  0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x01, 0x09, 0x38, 0x81, 0x06,
+  0xC0, 0xC0
+};
+
+// Tastatur (Report-ID 1) + Maus (Report-ID 2) mit 12-Bit-Achsen und AC Pan
+static const uint8_t COMPOSITE[] = {
+  0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x85, 0x01,
+  0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01,
+  0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+  0xC0,
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x85, 0x02, 0x09, 0x01, 0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x10, 0x75, 0x01, 0x81, 0x02,
+  0x05, 0x01, 0x16, 0x01, 0xF8, 0x26, 0xFF, 0x07, 0x75, 0x0C, 0x95, 0x02,
+  0x09, 0x30, 0x09, 0x31, 0x81, 0x06,
+  0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x01, 0x09, 0x38, 0x81, 0x06,
+  0x05, 0x0C, 0x0A, 0x38, 0x02, 0x95, 0x01, 0x81, 0x06,
+  0xC0, 0xC0
+};
+
+void setUp() {}
+void tearDown() {}
+
+static uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void runDecode(const char* label, const HidExtractionPlan& plan) {
+  // Wechselnde Reports, damit nichts konstant gefaltet wird
+  uint8_t reports[256][HID_MAX_REPORT_SIZE];
+  for (int i = 0; i < 256; i++) {
+    for (int b = 0; b < HID_MAX_REPORT_SIZE; b++) {
+      reports[i][b] = (uint8_t)(i * 31 + b * 7);
+    }
+  }
+
+  int64_t checksum = 0;
+  uint32_t decoded = 0;
+  HidMouseReport report;
+  uint64_t start = wallNs();
+  for (uint32_t i = 0; i < BENCH_REPORTS; i++) {
+    if (hidDecodeReport(plan, reports[i & 255], plan.reportLength, report)) {
+      checksum += report.dx - report.dy + report.wheel + report.pan + report.buttons;
+      decoded++;
+    }
+  }
+  uint64_t elapsedNs = wallNs() - start;
+
+  double perSecond = BENCH_REPORTS / (elapsedNs / 1e9);
+  char line[160];
+  snprintf(line, sizeof(line), "%s: %u Bytes/Report, %.1f Mio. Reports/s, %.1f ns/Report (Prüfsumme %lld)",
+           label, plan.reportLength, perSecond / 1e6, (double)elapsedNs / BENCH_REPORTS,
+           (long long)checksum);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_EQUAL_UINT32(BENCH_REPORTS, decoded);
+  TEST_ASSERT_TRUE(perSecond > BENCH_MIN_REPORTS_PER_S);
+}
+
+void test_bench_boot() {
+  HidExtractionPlan plan;
+  HidDescriptorParser::bootProtocolPlan(plan);
+  runDecode("Boot", plan);
+}
+
+void test_bench_16bit() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(MOUSE_16BIT, sizeof(MOUSE_16BIT), plan));
+  runDecode("16 Bit", plan);
+}
+
+void test_bench_composite() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(COMPOSITE, sizeof(COMPOSITE), plan));
+  TEST_ASSERT_EQUAL_UINT8(2, plan.reportId);
+  TEST_ASSERT_EQUAL_UINT8(8, plan.fields[HID_FIELD_PAN].bitSize);
+  runDecode("Kombi", plan);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_boot);
+  RUN_TEST(test_bench_16bit);
+  RUN_TEST(test_bench_composite);
+  return UNITY_END();
+}
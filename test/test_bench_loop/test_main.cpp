@@ -0,0 +1,231 @@
+/**
+ * Benchmark: Eingang bis Display wie in loop(), auf der virtuellen Uhr
+ * Simulierte Maus (1000 Hz, Kreisbewegung, Klicks) über den Ersatz-HID-Host
+ * -> MouseHandler -> DisplayManager, getaktet von LoopScheduler und
+ * FramePacer. Gemeldet werden Reports/s, Frames/s und CPU-Zeit pro Frame
+ * (Host), dazu der Faktor gegenüber Echtzeit.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_hidh.h>
+#include <chrono>
+#include "mouse_handler.h"
+#include "display.h"
+#include "loop_scheduler.h"
+#include "frame_pacer.h"
+#include "frame_governor.h"
+
+#define BENCH_DURATION_MS 10000
+#define BENCH_REPORT_INTERVAL_US 1000
+#define BENCH_LEFT_CLICK_MS 300
+#define BENCH_RIGHT_CLICK_MS 900
+#define BENCH_CLICK_HOLD_MS 40
+
+struct LoopBenchResult {
+  uint32_t reports;
+  uint32_t clicks;  // Drück-Flanken
+  uint32_t skippedEvents;
+  uint32_t frames;
+  uint64_t frameBytes;
+  uint64_t updateNs;
+  uint64_t renderNs;
+  uint64_t maxRenderNs;
+  uint64_t wallNs;
+  ReportQueueStats queue;
+  AnimationStats animations;
+};
+
+static uint32_t benchClock() {
+  return micros();
+}
+
+static uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Boot-Protokoll-Report der simulierten Maus zum Zeitpunkt nowMs
+static void sendReport(uint32_t nowMs, uint32_t index, uint32_t& clicks) {
+  bool left = nowMs % BENCH_LEFT_CLICK_MS < BENCH_CLICK_HOLD_MS;
+  bool right = nowMs % BENCH_RIGHT_CLICK_MS < BENCH_CLICK_HOLD_MS;
+  // Drück-Flanken (beide Tasten gleichzeitig = zwei Flanken)
+  clicks += (nowMs % BENCH_LEFT_CLICK_MS == 0) + (nowMs % BENCH_RIGHT_CLICK_MS == 0);
+
+  // Kreis mit ~2 s Umlauf
+  float phase = index * 0.0031416f;
+  uint8_t report[4] = {
+    (uint8_t)((left ? MOUSE_BUTTON_LEFT : 0) | (right ? MOUSE_BUTTON_RIGHT : 0)),
+    (uint8_t)(int8_t)lroundf(cosf(phase) * 3.0f),
+    (uint8_t)(int8_t)lroundf(sinf(phase) * 3.0f),
+    0
+  };
+  hostHidhInput(0, report, sizeof(report));
+}
+
+static void handleButtonEvent(DisplayManager& display, const ButtonEvent& event) {
+  // Wie main.cpp: nur das Drücken löst einen Effekt aus
+  if (!event.pressed) {
+    return;
+  }
+  bool left = event.buttons & MOUSE_BUTTON_LEFT;
+  bool right = event.buttons & MOUSE_BUTTON_RIGHT;
+  if (left && right) {
+    display.drawClickAnimation(event.x, event.y, CLICK_BOTH);
+  } else if (event.button == MOUSE_BUTTON_LEFT) {
+    display.drawClickAnimation(event.x, event.y, CLICK_LEFT);
+  } else if (event.button == MOUSE_BUTTON_RIGHT) {
+    display.drawClickAnimation(event.x, event.y, CLICK_RIGHT);
+  }
+}
+
+static LoopBenchResult runLoop(uint32_t durationMs) {
+  LoopBenchResult result;
+  memset(&result, 0, sizeof(result));
+
+  DisplayManager display;
+  MouseHandler mouse;
+  LoopScheduler scheduler(benchClock);
+  FramePacer framePacer(benchClock);
+  FrameGovernor frameGovernor;
+
+  display.begin();
+  mouse.begin();
+  mouse.setInputNotifyTask(&mouse);
+  hostHidhSetReportMap(nullptr, 0);
+  TEST_ASSERT_TRUE(mouse.connectBTClassicMouse("11:22:33:44:55:66"));
+  hostHidhOpen();
+
+  scheduler.setInterval(TASK_MOUSE, 10);
+  scheduler.setInterval(TASK_DISPLAY, 0);
+  scheduler.start();
+  framePacer.start();
+  frameGovernor.setBudget(FRAME_BUDGET_US, 240);
+
+  uint32_t buttonEventCursor = mouse.getButtonEventSeq();
+  uint32_t notifications = hostTaskNotifications;
+  uint32_t startUs = micros();
+  uint32_t nextReportUs = startUs;
+  uint64_t wallStart = wallNs();
+
+  while (micros() - startUs < durationMs * 1000) {
+    // Eingang: fällige Reports wie aus dem HID-Task
+    if ((int32_t)(micros() - nextReportUs) >= 0) {
+      sendReport((nextReportUs - startUs) / 1000, result.reports, result.clicks);
+      result.reports++;
+      nextReportUs += BENCH_REPORT_INTERVAL_US;
+    }
+
+    bool inputSignaled = hostTaskNotifications != notifications;
+    notifications = hostTaskNotifications;
+
+    if (scheduler.isDue(TASK_MOUSE) || inputSignaled) {
+      uint64_t t0 = wallNs();
+      mouse.update();
+      result.updateNs += wallNs() - t0;
+    }
+
+    MouseData data = mouse.getMouseData();
+    display.drawCursor(data.x, data.y, data.speed);
+    ButtonEvent event;
+    while (mouse.pollButtonEvent(buttonEventCursor, event)) {
+      result.skippedEvents += event.skipped;
+      handleButtonEvent(display, event);
+    }
+    display.showMouseStatus("Maus verbunden");
+    display.updateAnimations();
+
+    if (display.hasPendingChanges()) {
+      framePacer.markChanged();
+    }
+    if (framePacer.beginFrame()) {
+      uint64_t t0 = wallNs();
+      display.renderFrame();
+      uint64_t renderNs = wallNs() - t0;
+      result.renderNs += renderNs;
+      if (renderNs > result.maxRenderNs) {
+        result.maxRenderNs = renderNs;
+      }
+      result.frameBytes += display.getStats().lastFrameBytes;
+
+      // Host-Zeit als Zyklen bei 240 MHz
+      display.setQuality(frameGovernor.recordFrame((uint32_t)(renderNs * 240 / 1000)));
+    }
+
+    // Schlafen bis zur nächsten Aufgabe, zum nächsten Frame oder Report
+    uint32_t waitUs = min(scheduler.timeUntilNextTask(), framePacer.timeUntilNextFrame());
+    waitUs = min(waitUs, nextReportUs - micros());
+    hostAdvanceMicros(waitUs > 0 ? waitUs : 1);
+  }
+
+  result.wallNs = wallNs() - wallStart;
+  result.frames = display.getStats().frames;
+  result.queue = mouse.getQueueStats();
+  result.animations = display.getAnimationStats();
+  return result;
+}
+
+static void report(const char* label, const LoopBenchResult& r, uint32_t durationMs) {
+  char line[160];
+  double wallS = r.wallNs / 1e9;
+
+  snprintf(line, sizeof(line), "%s: %u Reports, %.0f Reports/s (update %.2f us/Report)",
+           label, r.reports, r.reports / wallS, r.updateNs / 1000.0 / r.reports);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "%s: %u Frames, %.1f fps virtuell, %.0f fps Host",
+           label, r.frames, r.frames * 1000.0 / durationMs, r.frames / (r.renderNs / 1e9));
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "%s: CPU/Frame %.1f us (max %.1f us), %llu Bytes/Frame, %.0fx Echtzeit",
+           label, r.renderNs / 1000.0 / r.frames, r.maxRenderNs / 1000.0,
+           (unsigned long long)(r.frameBytes / r.frames), durationMs / 1000.0 / wallS);
+  TEST_MESSAGE(line);
+}
+
+static void checkResult(const LoopBenchResult& r, uint32_t durationMs) {
+  // Jeder Report verarbeitet, keiner verworfen
+  TEST_ASSERT_EQUAL_UINT32(r.reports, r.queue.pushed);
+  TEST_ASSERT_EQUAL_UINT32(r.reports, r.queue.popped);
+  TEST_ASSERT_EQUAL_UINT32(0, r.queue.dropped);
+
+  // Jede Drück-Flanke löst genau einen Effekt aus
+  TEST_ASSERT_GREATER_THAN_UINT32(0, r.clicks);
+  TEST_ASSERT_EQUAL_UINT32(0, r.skippedEvents);
+  TEST_ASSERT_EQUAL_UINT32(r.clicks, r.animations.triggered);
+
+  // Ständige Bewegung: Frames an der Obergrenze, nie darüber
+  uint32_t maxFrames = DISPLAY_MAX_FPS * durationMs / 1000 + 1;
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(maxFrames, r.frames);
+  TEST_ASSERT_GREATER_THAN_UINT32(maxFrames * 9 / 10, r.frames);
+
+  // Schneller als Echtzeit
+  TEST_ASSERT_LESS_THAN(durationMs * 1000000ULL, r.wallNs);
+}
+
+void setUp() {
+  hostSetMicros(1000);
+  hostDmaAvailable = true;
+  hostPsramAvailable = true;
+}
+
+void tearDown() {}
+
+void test_bench_framebuffer_mode() {
+  LoopBenchResult r = runLoop(BENCH_DURATION_MS);
+  report("Framebuffer", r, BENCH_DURATION_MS);
+  checkResult(r, BENCH_DURATION_MS);
+}
+
+void test_bench_direct_mode() {
+  // Ohne PSRAM geht jedes Primitive einzeln über den Bus
+  hostPsramAvailable = false;
+  LoopBenchResult r = runLoop(BENCH_DURATION_MS);
+  report("Direkt", r, BENCH_DURATION_MS);
+  checkResult(r, BENCH_DURATION_MS);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_framebuffer_mode);
+  RUN_TEST(test_bench_direct_mode);
+  return UNITY_END();
+}
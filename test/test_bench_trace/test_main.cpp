@@ -0,0 +1,185 @@
+/**
+ * Benchmark: HID-Trace-Wiedergabe durch MouseHandler und DisplayManager
+ * Ein synthetischer 1000-Hz-Mitschnitt (Kreisbewegung, Klicks) wird über
+ * den Ersatz-HID-Host aufgezeichnet und dann wiedergegeben - einmal so
+ * schnell wie möglich (Durchsatz der ganzen Eingangskette), einmal in
+ * Originalzeit mit 60-fps-Frames (CPU und Bytes pro Frame).
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_hidh.h>
+#include <chrono>
+#include "mouse_handler.h"
+#include "display.h"
+
+#define BENCH_TRACE_MS 10000
+#define BENCH_CLICK_MS 250
+#define BENCH_CLICK_HOLD_MS 30
+#define BENCH_FRAME_US 16667
+
+struct TraceBenchResult {
+  uint32_t edges;
+  uint32_t presses;
+  uint32_t frames;
+  uint32_t loops;
+  uint64_t frameBytes;
+  uint64_t wallNs;
+};
+
+static uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void connectMouse(MouseHandler& mouse) {
+  mouse.begin();
+  hostHidhSetReportMap(nullptr, 0);
+  TEST_ASSERT_TRUE(mouse.connectBTClassicMouse("11:22:33:44:55:66"));
+  hostHidhOpen();
+}
+
+// Mitschnitt erzeugen; liefert die Zahl der Drück-Flanken
+static uint32_t recordTrace(MouseHandler& mouse) {
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+
+  uint32_t presses = 0;
+  for (uint32_t ms = 0; ms < BENCH_TRACE_MS; ms++) {
+    bool left = ms % BENCH_CLICK_MS < BENCH_CLICK_HOLD_MS;
+    presses += ms % BENCH_CLICK_MS == 0;
+    float phase = ms * 0.0031416f;
+    uint8_t report[4] = {
+      (uint8_t)(left ? MOUSE_BUTTON_LEFT : 0),
+      (uint8_t)(int8_t)lroundf(cosf(phase) * 3.0f),
+      (uint8_t)(int8_t)lroundf(sinf(phase) * 3.0f),
+      0
+    };
+    hostHidhInput(0, report, sizeof(report));
+    mouse.update();
+    hostAdvanceMicros(1000);
+  }
+
+  mouse.stopTraceRecording();
+  TEST_ASSERT_EQUAL_UINT32(BENCH_TRACE_MS, mouse.getTraceRecordCount());
+  return presses;
+}
+
+// Ein Durchlauf wie loop(): Eingang, Szene, ggf. Frame
+static void runFrame(MouseHandler& mouse, DisplayManager& display, uint32_t& cursor,
+                     TraceBenchResult& result, bool render) {
+  mouse.update();
+  MouseData data = mouse.getMouseData();
+  display.drawCursor(data.x, data.y, data.speed);
+
+  ButtonEvent event;
+  while (mouse.pollButtonEvent(cursor, event)) {
+    result.edges++;
+    if (event.pressed) {
+      result.presses++;
+      display.drawClickAnimation(event.x, event.y, CLICK_LEFT);
+    }
+  }
+  display.updateAnimations();
+
+  if (render && display.hasPendingChanges()) {
+    display.renderFrame();
+    result.frameBytes += display.getStats().lastFrameBytes;
+  }
+  result.loops++;
+}
+
+static TraceBenchResult replay(uint16_t speedPercent) {
+  TraceBenchResult result;
+  memset(&result, 0, sizeof(result));
+
+  DisplayManager display;
+  MouseHandler mouse;
+  display.begin();
+  connectMouse(mouse);
+  uint32_t recordedPresses = recordTrace(mouse);
+
+  uint32_t cursor = mouse.getButtonEventSeq();
+  TEST_ASSERT_TRUE(mouse.startTraceReplay(speedPercent));
+
+  uint64_t wallStart = wallNs();
+  if (speedPercent == HID_TRACE_SPEED_MAX) {
+    // Eine Queue-Füllung pro update(), Frame bei jedem Durchlauf
+    while (mouse.isTraceReplaying()) {
+      runFrame(mouse, display, cursor, result, true);
+    }
+  } else {
+    // Eingang jede Millisekunde, Frames im 60-fps-Raster
+    uint32_t nextFrameUs = micros();
+    while (mouse.isTraceReplaying()) {
+      bool frameDue = (int32_t)(micros() - nextFrameUs) >= 0;
+      if (frameDue) {
+        nextFrameUs += BENCH_FRAME_US;
+      }
+      runFrame(mouse, display, cursor, result, frameDue);
+      hostAdvanceMicros(1000);
+    }
+  }
+  result.wallNs = wallNs() - wallStart;
+  result.frames = display.getStats().frames;
+
+  TEST_ASSERT_EQUAL_UINT32(recordedPresses, result.presses);
+  TEST_ASSERT_EQUAL_UINT32(recordedPresses * 2, result.edges);
+  return result;
+}
+
+static void report(const char* label, const TraceBenchResult& r) {
+  char line[160];
+  double wallS = r.wallNs / 1e9;
+  snprintf(line, sizeof(line), "%s: %u Reports in %.1f ms, %.0f Reports/s, %u Durchläufe",
+           label, BENCH_TRACE_MS, wallS * 1000, BENCH_TRACE_MS / wallS, r.loops);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "%s: %u Frames, %.1f us/Frame (Host), %llu Bytes/Frame",
+           label, r.frames, r.wallNs / 1000.0 / (r.frames ? r.frames : 1),
+           (unsigned long long)(r.frameBytes / (r.frames ? r.frames : 1)));
+  TEST_MESSAGE(line);
+}
+
+void setUp() {
+  hostSetMicros(1000);
+  hostDmaAvailable = true;
+  hostPsramAvailable = true;
+}
+
+void tearDown() {
+  hostHidhClose();
+}
+
+void test_bench_replay_max_speed() {
+  TraceBenchResult r = replay(HID_TRACE_SPEED_MAX);
+  report("Maximal", r);
+
+  // Bis zu einer Queue-Füllung pro Durchlauf
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(BENCH_TRACE_MS / REPORT_QUEUE_CAPACITY + 2, r.loops);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, r.frames);
+}
+
+void test_bench_replay_original_speed() {
+  TraceBenchResult r = replay(HID_TRACE_SPEED_ORIGINAL);
+  report("Original", r);
+
+  // Ständige Bewegung: ein Frame je 60-fps-Slot, schneller als Echtzeit
+  uint32_t slots = BENCH_TRACE_MS * 1000 / BENCH_FRAME_US;
+  TEST_ASSERT_UINT32_WITHIN(2, slots, r.frames);
+  TEST_ASSERT_LESS_THAN(BENCH_TRACE_MS * 1000000ULL, r.wallNs);
+}
+
+void test_bench_replay_direct_mode() {
+  // Ohne PSRAM: jedes Primitive einzeln über den Bus
+  hostPsramAvailable = false;
+  TraceBenchResult r = replay(HID_TRACE_SPEED_ORIGINAL);
+  report("Direkt", r);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, r.frames);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_replay_max_speed);
+  RUN_TEST(test_bench_replay_original_speed);
+  RUN_TEST(test_bench_replay_direct_mode);
+  return UNITY_END();
+}
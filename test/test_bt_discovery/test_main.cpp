@@ -0,0 +1,212 @@
+/**
+ * Host-Tests: BT-Geräte-Tabelle der Gerätesuche
+ * Zusammenführen gleicher Adressen, Ersetzen des am längsten nicht
+ * gesehenen Eintrags bei voller Tabelle, RSSI-Glättung und Funde ohne
+ * RSSI - direkt an BtDeviceTable und über den GAP-Callback des MouseHandler.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_gap_bt_api.h>
+#include "bt_discovery.h"
+#include "mouse_handler.h"
+
+static void makeAddress(uint8_t* address, uint8_t last) {
+  const uint8_t base[6] = {0xAC, 0x12, 0x34, 0x56, 0x78, 0x00};
+  memcpy(address, base, 6);
+  address[5] = last;
+}
+
+void setUp() {
+  hostSetMicros(1000);
+}
+
+void tearDown() {}
+
+void test_same_address_merges() {
+  BtDeviceTable table;
+  uint8_t a[6], b[6];
+  makeAddress(a, 1);
+  makeAddress(b, 2);
+
+  table.update(a, nullptr, -60, 0x2580, 100);
+  table.update(b, "Andere", -70, 0x2580, 150);
+  const BtDevice& device = table.update(a, "Maus", -60, 0, 200);
+
+  TEST_ASSERT_EQUAL_INT(2, table.getCount());
+  TEST_ASSERT_EQUAL_INT(0, table.find(a));
+  TEST_ASSERT_EQUAL_UINT16(2, device.sightings);
+  TEST_ASSERT_EQUAL_UINT32(100, device.firstSeenMs);
+  TEST_ASSERT_EQUAL_UINT32(200, device.lastSeenMs);
+  TEST_ASSERT_EQUAL_UINT32(3, device.seq);
+  TEST_ASSERT_EQUAL_UINT32(3, table.getSeq());
+
+  // Name und CoD kommen nach, leere Angaben überschreiben sie nicht
+  TEST_ASSERT_EQUAL_STRING("Maus", device.name);
+  TEST_ASSERT_EQUAL_HEX32(0x2580, device.classOfDevice);
+  table.update(a, "", -60, 0, 250);
+  table.update(a, nullptr, -60, 0, 300);
+  TEST_ASSERT_EQUAL_STRING("Maus", table.get(0).name);
+  TEST_ASSERT_EQUAL_HEX32(0x2580, table.get(0).classOfDevice);
+  TEST_ASSERT_EQUAL_UINT16(4, table.get(0).sightings);
+}
+
+void test_full_table_replaces_least_recently_seen() {
+  BtDeviceTable table;
+  uint8_t address[6];
+  // lastSeenMs über den millis()-Überlauf hinweg
+  uint32_t start = 0xFFFFFF00;
+  for (int i = 0; i < BT_DISCOVERY_MAX_DEVICES; i++) {
+    makeAddress(address, i);
+    table.update(address, nullptr, -50, 0, start + i * 20);
+  }
+  TEST_ASSERT_EQUAL_INT(BT_DISCOVERY_MAX_DEVICES, table.getCount());
+
+  // Gerät 0 erneut gesehen: jetzt ist Gerät 1 das älteste
+  makeAddress(address, 0);
+  table.update(address, nullptr, -50, 0, start + 1000);
+
+  uint8_t newcomer[6];
+  makeAddress(newcomer, 0xF0);
+  const BtDevice& device = table.update(newcomer, "Neu", -40, 0, start + 1100);
+
+  TEST_ASSERT_EQUAL_INT(BT_DISCOVERY_MAX_DEVICES, table.getCount());
+  makeAddress(address, 1);
+  TEST_ASSERT_EQUAL_INT(-1, table.find(address));
+  TEST_ASSERT_EQUAL_INT(1, table.find(newcomer));
+  makeAddress(address, 0);
+  TEST_ASSERT_EQUAL_INT(0, table.find(address));
+
+  // Ersetzter Platz beginnt ohne Reste des alten Eintrags
+  TEST_ASSERT_EQUAL_UINT16(1, device.sightings);
+  TEST_ASSERT_EQUAL_UINT32(start + 1100, device.firstSeenMs);
+  TEST_ASSERT_EQUAL_INT8(-40, device.rssi);
+  TEST_ASSERT_EQUAL_STRING("Neu", device.name);
+
+  // Nächster Neuling verdrängt Gerät 2
+  uint8_t second[6];
+  makeAddress(second, 0xF1);
+  table.update(second, nullptr, -40, 0, start + 1200);
+  makeAddress(address, 2);
+  TEST_ASSERT_EQUAL_INT(-1, table.find(address));
+  TEST_ASSERT_EQUAL_INT(2, table.find(second));
+}
+
+void test_rssi_smoothing() {
+  BtDeviceTable table;
+  uint8_t address[6];
+  makeAddress(address, 7);
+
+  // Erste Messung gilt sofort
+  const BtDevice& device = table.update(address, nullptr, -80, 0, 0);
+  TEST_ASSERT_EQUAL_INT8(-80, device.rssi);
+  TEST_ASSERT_EQUAL_INT8(-80, device.lastRssi);
+
+  // Sprung auf -40: neuer Wert zählt 1/4 (-80 + 40/4 = -70)
+  table.update(address, nullptr, -40, 0, 10);
+  TEST_ASSERT_EQUAL_INT8(-70, device.rssi);
+  TEST_ASSERT_EQUAL_INT8(-40, device.lastRssi);
+  table.update(address, nullptr, -40, 0, 20);
+  TEST_ASSERT_EQUAL_INT8(-63, device.rssi);  // -62,5 gerundet
+
+  // Konvergiert gegen den neuen Pegel, ohne ihn zu überschreiten
+  int8_t previous = device.rssi;
+  for (int i = 0; i < 30; i++) {
+    table.update(address, nullptr, -40, 0, 30 + i);
+    TEST_ASSERT_TRUE(device.rssi >= previous);
+    TEST_ASSERT_TRUE(device.rssi <= -40);
+    previous = device.rssi;
+  }
+  TEST_ASSERT_INT_WITHIN(1, -40, device.rssi);
+
+  // Einzelner Ausreißer bewegt den Wert nur um ein Viertel
+  table.update(address, nullptr, -90, 0, 100);
+  TEST_ASSERT_INT_WITHIN(1, -52, device.rssi);
+}
+
+void test_missing_rssi_keeps_values() {
+  BtDeviceTable table;
+  uint8_t address[6];
+  makeAddress(address, 9);
+
+  // Erster Fund ohne RSSI: kein Pegel erfunden
+  const BtDevice& device = table.update(address, nullptr, BT_RSSI_NONE, 0x2580, 0);
+  TEST_ASSERT_EQUAL_INT8(BT_RSSI_NONE, device.rssi);
+  TEST_ASSERT_EQUAL_INT8(BT_RSSI_NONE, device.lastRssi);
+
+  // Erste echte Messung wird übernommen, nicht mit 0 gemittelt
+  table.update(address, nullptr, -75, 0, 10);
+  TEST_ASSERT_EQUAL_INT8(-75, device.rssi);
+
+  // Späterer Fund nur mit Name: Pegel unverändert, Fund zählt trotzdem
+  uint32_t seq = device.seq;
+  table.update(address, "Maus", BT_RSSI_NONE, 0, 20);
+  TEST_ASSERT_EQUAL_INT8(-75, device.rssi);
+  TEST_ASSERT_EQUAL_INT8(-75, device.lastRssi);
+  TEST_ASSERT_EQUAL_UINT32(20, device.lastSeenMs);
+  TEST_ASSERT_EQUAL_UINT16(3, device.sightings);
+  TEST_ASSERT_GREATER_THAN_UINT32(seq, device.seq);
+
+  // Glättung setzt danach ohne Sprung fort
+  table.update(address, nullptr, -55, 0, 30);
+  TEST_ASSERT_EQUAL_INT8(-70, device.rssi);
+}
+
+// DISC_RES wie vom BT-Stack: CoD, Name und RSSI jeweils optional
+static void fireResult(const uint8_t* address, uint32_t* cod, const char* name, int8_t* rssi) {
+  esp_bt_gap_dev_prop_t props[3];
+  int count = 0;
+  if (cod != nullptr) {
+    props[count++] = {ESP_BT_GAP_DEV_PROP_COD, 4, cod};
+  }
+  if (name != nullptr) {
+    props[count++] = {ESP_BT_GAP_DEV_PROP_BDNAME, (int)strlen(name), (void*)name};
+  }
+  if (rssi != nullptr) {
+    props[count++] = {ESP_BT_GAP_DEV_PROP_RSSI, 1, rssi};
+  }
+  esp_bt_gap_cb_param_t param;
+  memcpy(param.disc_res.bda, address, 6);
+  param.disc_res.num_prop = count;
+  param.disc_res.prop = props;
+  hostGapCallback(ESP_BT_GAP_DISC_RES_EVT, &param);
+}
+
+void test_gap_result_without_rssi() {
+  MouseHandler mouse;
+  mouse.begin();
+  TEST_ASSERT_GREATER_THAN_UINT32(0, mouse.startBTDiscovery());
+  TEST_ASSERT_NOT_NULL(hostGapCallback);
+
+  uint8_t address[6];
+  makeAddress(address, 0x42);
+  uint32_t cod = 0x2580;  // Peripheral, Pointing device
+  int8_t rssi = -66;
+  fireResult(address, &cod, nullptr, &rssi);
+  fireResult(address, nullptr, "BT-Maus", nullptr);
+
+  BtDevice devices[BT_DISCOVERY_MAX_DEVICES];
+  uint32_t seq;
+  TEST_ASSERT_EQUAL_INT(1, mouse.getBTDevices(devices, BT_DISCOVERY_MAX_DEVICES, 0, seq));
+  TEST_ASSERT_EQUAL_STRING("BT-Maus", devices[0].name);
+  TEST_ASSERT_EQUAL_INT8(-66, devices[0].rssi);
+  TEST_ASSERT_EQUAL_INT8(-66, devices[0].lastRssi);
+  TEST_ASSERT_EQUAL_UINT16(2, devices[0].sightings);
+
+  // Andere Geräteklasse wird nicht aufgenommen
+  uint8_t keyboard[6];
+  makeAddress(keyboard, 0x43);
+  uint32_t keyboardCod = 0x2540;
+  fireResult(keyboard, &keyboardCod, "Tastatur", &rssi);
+  TEST_ASSERT_EQUAL_INT(1, mouse.getBTDevices(devices, BT_DISCOVERY_MAX_DEVICES, 0, seq));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_same_address_merges);
+  RUN_TEST(test_full_table_replaces_least_recently_seen);
+  RUN_TEST(test_rssi_smoothing);
+  RUN_TEST(test_missing_rssi_keeps_values);
+  RUN_TEST(test_gap_result_without_rssi);
+  return UNITY_END();
+}
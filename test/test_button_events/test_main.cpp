@@ -0,0 +1,141 @@
+/**
+ * Host-Tests: Tasten-Flanken des MouseHandlers
+ * Klicks kürzer als ein Display-Frame (live und per Trace-Wiedergabe),
+ * Start-Cursor und sichtbarer Überlauf des Ringpuffers.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_hidh.h>
+#include "mouse_handler.h"
+
+static void sendButtons(uint8_t buttons) {
+  uint8_t report[4] = {buttons, 0, 0, 0};
+  hostHidhInput(0, report, sizeof(report));
+}
+
+static void connectMouse(MouseHandler& mouse) {
+  mouse.begin();
+  hostHidhSetReportMap(nullptr, 0);
+  TEST_ASSERT_TRUE(mouse.connectBTClassicMouse("11:22:33:44:55:66"));
+  hostHidhOpen();
+}
+
+// Linksklick mit 2 ms Haltezeit, danach ein Frame später update()
+static void shortClick() {
+  sendButtons(MOUSE_BUTTON_LEFT);
+  hostAdvanceMicros(2000);
+  sendButtons(0);
+  hostAdvanceMicros(14000);
+}
+
+void setUp() {
+  hostSetMicros(1000);
+}
+
+void tearDown() {
+  hostHidhClose();
+}
+
+void test_sub_frame_click_live() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  uint32_t cursor = mouse.getButtonEventSeq();
+
+  shortClick();
+  mouse.update();
+
+  // Der Zustand zeigt die Taste nicht mehr, die Flanken sind beide da
+  TEST_ASSERT_FALSE(mouse.getMouseData().leftButton);
+  ButtonEvent event;
+  TEST_ASSERT_TRUE(mouse.pollButtonEvent(cursor, event));
+  TEST_ASSERT_TRUE(event.pressed);
+  TEST_ASSERT_EQUAL_UINT8(MOUSE_BUTTON_LEFT, event.button);
+  TEST_ASSERT_EQUAL_UINT32(0, event.skipped);
+  uint32_t pressedAt = event.timestampUs;
+  TEST_ASSERT_TRUE(mouse.pollButtonEvent(cursor, event));
+  TEST_ASSERT_FALSE(event.pressed);
+  TEST_ASSERT_EQUAL_UINT32(2000, event.timestampUs - pressedAt);
+  TEST_ASSERT_FALSE(mouse.pollButtonEvent(cursor, event));
+}
+
+void test_sub_frame_click_replay() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  shortClick();
+  sendButtons(MOUSE_BUTTON_RIGHT);
+  hostAdvanceMicros(1000);
+  sendButtons(0);
+  mouse.update();
+  mouse.stopTraceRecording();
+
+  // Wiedergabe in Echtzeit, update() nur alle 16 ms wie ein Frame
+  uint32_t cursor = mouse.getButtonEventSeq();
+  TEST_ASSERT_TRUE(mouse.startTraceReplay(100));
+  uint8_t edges[4];
+  int count = 0;
+  for (int frame = 0; frame < 10 && (frame == 0 || mouse.isTraceReplaying()); frame++) {
+    hostAdvanceMicros(16000);
+    mouse.update();
+    ButtonEvent event;
+    while (mouse.pollButtonEvent(cursor, event)) {
+      TEST_ASSERT_LESS_THAN(4, count);
+      edges[count++] = event.button | (event.pressed ? 0x80 : 0);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_INT(4, count);
+  TEST_ASSERT_EQUAL_HEX8(0x80 | MOUSE_BUTTON_LEFT, edges[0]);
+  TEST_ASSERT_EQUAL_HEX8(MOUSE_BUTTON_LEFT, edges[1]);
+  TEST_ASSERT_EQUAL_HEX8(0x80 | MOUSE_BUTTON_RIGHT, edges[2]);
+  TEST_ASSERT_EQUAL_HEX8(MOUSE_BUTTON_RIGHT, edges[3]);
+}
+
+void test_cursor_starts_at_current_seq() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  shortClick();
+  mouse.update();
+
+  // Ein später startender Konsument sieht keine alten Flanken
+  uint32_t cursor = mouse.getButtonEventSeq();
+  TEST_ASSERT_EQUAL_UINT32(2, cursor);
+  ButtonEvent event;
+  TEST_ASSERT_FALSE(mouse.pollButtonEvent(cursor, event));
+}
+
+void test_overrun_reports_skipped_edges() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  uint32_t cursor = mouse.getButtonEventSeq();
+
+  // 20 Klicks = 40 Flanken ohne Konsument, Puffer fasst 32
+  for (int i = 0; i < 20; i++) {
+    shortClick();
+  }
+  mouse.update();
+
+  ButtonEvent event;
+  TEST_ASSERT_TRUE(mouse.pollButtonEvent(cursor, event));
+  TEST_ASSERT_EQUAL_UINT32(40 - BUTTON_EVENT_CAPACITY, event.skipped);
+  TEST_ASSERT_TRUE(event.pressed);
+
+  uint32_t received = 1;
+  while (mouse.pollButtonEvent(cursor, event)) {
+    TEST_ASSERT_EQUAL_UINT32(0, event.skipped);
+    received++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(BUTTON_EVENT_CAPACITY, received);
+  TEST_ASSERT_EQUAL_UINT32(mouse.getButtonEventSeq(), cursor);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sub_frame_click_live);
+  RUN_TEST(test_sub_frame_click_replay);
+  RUN_TEST(test_cursor_starts_at_current_seq);
+  RUN_TEST(test_overrun_reports_skipped_edges);
+  return UNITY_END();
+}
@@ -0,0 +1,97 @@
+/**
+ * Host-Tests: Rect und DirtyRegion (Clipping, Zusammenfassen, volle Liste)
+ */
+
+#include <unity.h>
+#include "dirty_rect.h"
+
+static bool contains(const Rect& outer, const Rect& inner) {
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.w <= outer.x + outer.w &&
+         inner.y + inner.h <= outer.y + outer.h;
+}
+
+static bool covered(const DirtyRegion& region, const Rect& rect) {
+  for (int i = 0; i < region.getCount(); i++) {
+    if (contains(region.get(i), rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_rect_geometry() {
+  Rect a = Rect::make(0, 0, 10, 10);
+  Rect b = Rect::make(5, 5, 10, 10);
+
+  TEST_ASSERT_TRUE(a.intersects(b));
+  Rect i = a.intersect(b);
+  TEST_ASSERT_EQUAL_INT(5, i.x);
+  TEST_ASSERT_EQUAL_INT(5, i.w);
+  Rect u = a.unite(b);
+  TEST_ASSERT_EQUAL_INT(15, u.w);
+  TEST_ASSERT_EQUAL_INT(15, u.h);
+
+  // Aneinandergrenzend ist nicht überlappend
+  TEST_ASSERT_FALSE(a.intersects(Rect::make(10, 0, 5, 5)));
+  TEST_ASSERT_TRUE(a.intersect(Rect::make(10, 0, 5, 5)).isEmpty());
+
+  Rect around = Rect::around(20, 30, 5);
+  TEST_ASSERT_EQUAL_INT(15, around.x);
+  TEST_ASSERT_EQUAL_INT(25, around.y);
+  TEST_ASSERT_EQUAL_INT(11, around.w);
+}
+
+void test_region_clips_to_screen() {
+  DirtyRegion region(240, 135);
+  region.add(Rect::make(-10, -10, 20, 20));
+  region.add(Rect::make(300, 0, 10, 10));  // Komplett außerhalb
+
+  TEST_ASSERT_EQUAL_INT(1, region.getCount());
+  TEST_ASSERT_EQUAL_INT(0, region.get(0).x);
+  TEST_ASSERT_EQUAL_INT(10, region.get(0).w);
+  TEST_ASSERT_EQUAL_INT32(100, region.getArea());
+}
+
+void test_region_merges_overlapping_and_near() {
+  DirtyRegion region(240, 135);
+  region.add(Rect::make(0, 0, 10, 10));
+  region.add(Rect::make(5, 5, 10, 10));
+  TEST_ASSERT_EQUAL_INT(1, region.getCount());
+
+  // Eine Spalte Abstand: Vereinigung kostet weniger als DIRTY_MERGE_SLACK
+  region.add(Rect::make(16, 0, 10, 15));
+  TEST_ASSERT_EQUAL_INT(1, region.getCount());
+
+  // Weit entfernt bleibt getrennt
+  region.add(Rect::make(200, 100, 5, 5));
+  TEST_ASSERT_EQUAL_INT(2, region.getCount());
+}
+
+void test_region_full_list_keeps_coverage() {
+  DirtyRegion region(240, 135);
+  Rect added[MAX_DIRTY_RECTS + 4];
+
+  for (int i = 0; i < MAX_DIRTY_RECTS + 4; i++) {
+    added[i] = Rect::make((i % 6) * 40, (i / 6) * 60, 4, 4);
+    region.add(added[i]);
+    TEST_ASSERT_LESS_OR_EQUAL(MAX_DIRTY_RECTS, region.getCount());
+  }
+
+  // Zusammengefasst, aber nichts verloren
+  for (int i = 0; i < MAX_DIRTY_RECTS + 4; i++) {
+    TEST_ASSERT_TRUE(covered(region, added[i]));
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_rect_geometry);
+  RUN_TEST(test_region_clips_to_screen);
+  RUN_TEST(test_region_merges_overlapping_and_near);
+  RUN_TEST(test_region_full_list_keeps_coverage);
+  return UNITY_END();
+}
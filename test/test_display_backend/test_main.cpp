@@ -0,0 +1,107 @@
+/**
+ * Host-Tests: DisplayBackend / MemoryBackend (Clipping, SPI-Bilanz,
+ * Bus-Reihenfolge, PPM-Export)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "display_backend.h"
+
+#define WIDTH 16
+#define HEIGHT 8
+
+void setUp() {}
+void tearDown() {}
+
+void test_fill_rect_counts_one_window() {
+  MemoryBackend backend(WIDTH, HEIGHT);
+  TEST_ASSERT_TRUE(backend.begin(false));
+
+  backend.fillRect(2, 1, 4, 3, 0xF800);
+  DisplayBusStats bus = backend.getBusStats();
+  TEST_ASSERT_EQUAL_UINT32(1, bus.transactions);
+  TEST_ASSERT_EQUAL_UINT64(DisplayBackend::windowBytes(12), bus.bytes);
+  TEST_ASSERT_EQUAL_UINT64(12 * 2 + SPI_WINDOW_OVERHEAD, bus.bytes);
+
+  TEST_ASSERT_EQUAL_HEX16(0xF800, backend.getPixel(2, 1));
+  TEST_ASSERT_EQUAL_HEX16(0xF800, backend.getPixel(5, 3));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.getPixel(6, 3));
+
+  // Speicher in Bus-Reihenfolge (big-endian), direkt per DMA übertragbar
+  TEST_ASSERT_EQUAL_HEX16(0x00F8, backend.getBuffer()[1 * WIDTH + 2]);
+}
+
+void test_clip_limits_writes_and_bytes() {
+  MemoryBackend backend(WIDTH, HEIGHT);
+  backend.begin(false);
+
+  backend.setClip(Rect::make(0, 0, 4, 4));
+  backend.fillRect(2, 2, 10, 10, 0xFFFF);
+  backend.drawPixel(10, 1, 0xFFFF);  // Komplett außerhalb: kein Fenster
+  backend.resetClip();
+
+  DisplayBusStats bus = backend.getBusStats();
+  TEST_ASSERT_EQUAL_UINT32(1, bus.transactions);
+  TEST_ASSERT_EQUAL_UINT64(DisplayBackend::windowBytes(4), bus.bytes);
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, backend.getPixel(3, 3));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.getPixel(4, 3));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, backend.getPixel(10, 1));
+
+  backend.resetBusStats();
+  TEST_ASSERT_EQUAL_UINT32(0, backend.getBusStats().transactions);
+}
+
+void test_push_image_clipped_at_edge() {
+  MemoryBackend backend(WIDTH, HEIGHT);
+  backend.begin(false);
+
+  uint16_t image[3 * 2];
+  for (int i = 0; i < 6; i++) {
+    image[i] = DisplayBackend::toBusOrder((uint16_t)(i + 1));
+  }
+
+  // Linke Spalte liegt außerhalb des Bildes
+  backend.pushImage(-1, 0, 3, 2, image);
+  TEST_ASSERT_EQUAL_HEX16(2, backend.getPixel(0, 0));
+  TEST_ASSERT_EQUAL_HEX16(3, backend.getPixel(1, 0));
+  TEST_ASSERT_EQUAL_HEX16(5, backend.getPixel(0, 1));
+  TEST_ASSERT_EQUAL_HEX16(6, backend.getPixel(1, 1));
+  TEST_ASSERT_EQUAL_UINT64(DisplayBackend::windowBytes(4), backend.getBusStats().bytes);
+}
+
+void test_ppm_export_in_chunks() {
+  MemoryBackend backend(WIDTH, HEIGHT);
+  backend.begin(false);
+  backend.fillRect(0, 0, 1, 1, 0xF800);
+
+  const char* header = "P6\n16 8\n255\n";
+  size_t size = backend.getPPMSize();
+  TEST_ASSERT_EQUAL_UINT32(strlen(header) + WIDTH * HEIGHT * 3, size);
+
+  static uint8_t whole[1024];
+  static uint8_t pieces[1024];
+  TEST_ASSERT_EQUAL_UINT32(size, backend.readPPM(0, whole, sizeof(whole)));
+
+  // Stückweise wie bei einer Streaming-Antwort
+  size_t offset = 0;
+  while (offset < size) {
+    offset += backend.readPPM(offset, pieces + offset, 7);
+  }
+  TEST_ASSERT_EQUAL_MEMORY(whole, pieces, size);
+
+  TEST_ASSERT_EQUAL_MEMORY(header, whole, strlen(header));
+  const uint8_t* pixel = whole + strlen(header);
+  TEST_ASSERT_EQUAL_UINT8(255, pixel[0]);
+  TEST_ASSERT_EQUAL_UINT8(0, pixel[1]);
+  TEST_ASSERT_EQUAL_UINT8(0, pixel[2]);
+  TEST_ASSERT_EQUAL_UINT8(0, pixel[3]);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fill_rect_counts_one_window);
+  RUN_TEST(test_clip_limits_writes_and_bytes);
+  RUN_TEST(test_push_image_clipped_at_edge);
+  RUN_TEST(test_ppm_export_in_chunks);
+  return UNITY_END();
+}
@@ -0,0 +1,86 @@
+/**
+ * Host-Tests: FrameGovernor (Qualitätsstufen nach Frame-Budget)
+ */
+
+#include <unity.h>
+#include "frame_governor.h"
+
+#define CPU_MHZ 240
+
+static uint32_t cyclesFor(uint32_t us) {
+  return us * CPU_MHZ;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_steps_down_after_repeated_overruns() {
+  FrameGovernor governor;
+  governor.setBudget(FRAME_BUDGET_US, CPU_MHZ);
+
+  TEST_ASSERT_EQUAL(QUALITY_FULL, governor.recordFrame(cyclesFor(20000)));
+  TEST_ASSERT_EQUAL(QUALITY_REDUCED, governor.recordFrame(cyclesFor(20000)));
+
+  // Neue Stufe: Verlauf beginnt von vorn
+  TEST_ASSERT_EQUAL(QUALITY_REDUCED, governor.recordFrame(cyclesFor(20000)));
+  TEST_ASSERT_EQUAL(QUALITY_MINIMAL, governor.recordFrame(cyclesFor(20000)));
+
+  // Unterste Stufe bleibt
+  governor.recordFrame(cyclesFor(20000));
+  TEST_ASSERT_EQUAL(QUALITY_MINIMAL, governor.recordFrame(cyclesFor(20000)));
+
+  FrameGovernorStats stats = governor.getStats();
+  TEST_ASSERT_EQUAL_UINT32(6, stats.overruns);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.stepDowns);
+  TEST_ASSERT_EQUAL_UINT32(20000, stats.maxUs);
+}
+
+void test_isolated_overruns_are_tolerated() {
+  FrameGovernor governor;
+  governor.setBudget(FRAME_BUDGET_US, CPU_MHZ);
+
+  // Eine Überschreitung pro GOVERNOR_HISTORY Frames senkt die Stufe nie
+  for (int round = 0; round < 4; round++) {
+    TEST_ASSERT_EQUAL(QUALITY_FULL, governor.recordFrame(cyclesFor(20000)));
+    for (int i = 0; i < GOVERNOR_HISTORY; i++) {
+      TEST_ASSERT_EQUAL(QUALITY_FULL, governor.recordFrame(cyclesFor(12000)));
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, governor.getStats().stepDowns);
+}
+
+void test_steps_up_after_calm_frames() {
+  FrameGovernor governor;
+  governor.setBudget(FRAME_BUDGET_US, CPU_MHZ);
+  governor.recordFrame(cyclesFor(20000));
+  governor.recordFrame(cyclesFor(20000));
+  TEST_ASSERT_EQUAL(QUALITY_REDUCED, governor.getLevel());
+
+  uint32_t calm = cyclesFor(FRAME_BUDGET_US * GOVERNOR_HEADROOM_PERCENT / 100 - 1000);
+  for (int i = 0; i < GOVERNOR_STEP_UP_FRAMES - 1; i++) {
+    TEST_ASSERT_EQUAL(QUALITY_REDUCED, governor.recordFrame(calm));
+  }
+
+  // Ein Frame knapp im Budget (ohne Reserve) setzt den Zähler zurück
+  governor.recordFrame(cyclesFor(FRAME_BUDGET_US - 100));
+  for (int i = 0; i < GOVERNOR_STEP_UP_FRAMES - 1; i++) {
+    TEST_ASSERT_EQUAL(QUALITY_REDUCED, governor.recordFrame(calm));
+  }
+  TEST_ASSERT_EQUAL(QUALITY_FULL, governor.recordFrame(calm));
+  TEST_ASSERT_EQUAL_UINT32(1, governor.getStats().stepUps);
+}
+
+void test_level_names() {
+  TEST_ASSERT_EQUAL_STRING("full", FrameGovernor::levelName(QUALITY_FULL));
+  TEST_ASSERT_EQUAL_STRING("reduced", FrameGovernor::levelName(QUALITY_REDUCED));
+  TEST_ASSERT_EQUAL_STRING("minimal", FrameGovernor::levelName(QUALITY_MINIMAL));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_steps_down_after_repeated_overruns);
+  RUN_TEST(test_isolated_overruns_are_tolerated);
+  RUN_TEST(test_steps_up_after_calm_frames);
+  RUN_TEST(test_level_names);
+  return UNITY_END();
+}
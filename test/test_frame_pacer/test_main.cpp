@@ -0,0 +1,102 @@
+/**
+ * Host-Tests: FramePacer (Rendern nur nach Änderungen, Obergrenze, Leerlauf)
+ */
+
+#include <unity.h>
+#include "frame_pacer.h"
+
+static uint32_t clockUs = 0;
+
+static uint32_t testClock() {
+  return clockUs;
+}
+
+void setUp() {
+  clockUs = 0;
+}
+
+void tearDown() {}
+
+void test_renders_only_after_change() {
+  FramePacer pacer(testClock);
+  pacer.start();
+
+  TEST_ASSERT_FALSE(pacer.beginFrame());
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, pacer.timeUntilNextFrame());
+
+  pacer.markChanged();
+  TEST_ASSERT_EQUAL_UINT32(0, pacer.timeUntilNextFrame());
+  TEST_ASSERT_TRUE(pacer.beginFrame());
+  TEST_ASSERT_FALSE(pacer.beginFrame());
+}
+
+void test_frame_rate_cap() {
+  FramePacer pacer(testClock);
+  pacer.start();
+
+  // Jede Millisekunde eine Änderung: höchstens DISPLAY_MAX_FPS Frames pro Sekunde
+  uint32_t frames = 0;
+  for (clockUs = 0; clockUs < 1000000; clockUs += 1000) {
+    pacer.markChanged();
+    if (pacer.beginFrame()) {
+      frames++;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(DISPLAY_MAX_FPS, frames);
+}
+
+void test_time_until_next_frame() {
+  FramePacer pacer(testClock);
+  pacer.start();
+  pacer.markChanged();
+  TEST_ASSERT_TRUE(pacer.beginFrame());
+
+  clockUs += 5000;
+  pacer.markChanged();
+  TEST_ASSERT_EQUAL_UINT32(1000000 / DISPLAY_MAX_FPS - 5000, pacer.timeUntilNextFrame());
+  TEST_ASSERT_FALSE(pacer.beginFrame());
+}
+
+void test_idle_after_timeout() {
+  FramePacer pacer(testClock);
+  pacer.start();
+  pacer.markChanged();
+  TEST_ASSERT_TRUE(pacer.beginFrame());
+  TEST_ASSERT_FALSE(pacer.isIdle());
+
+  clockUs += DISPLAY_IDLE_TIMEOUT_MS * 1000 - 1;
+  TEST_ASSERT_FALSE(pacer.isIdle());
+  clockUs += 1;
+  TEST_ASSERT_TRUE(pacer.isIdle());
+
+  // Eine Änderung beendet den Leerlauf, der Frame kommt sofort
+  pacer.markChanged();
+  TEST_ASSERT_FALSE(pacer.isIdle());
+  TEST_ASSERT_TRUE(pacer.beginFrame());
+}
+
+void test_stats_count_skipped_slots() {
+  FramePacer pacer(testClock);
+  pacer.start();
+
+  for (int i = 0; i < 10; i++) {
+    pacer.markChanged();
+    TEST_ASSERT_TRUE(pacer.beginFrame());
+    clockUs += 100000;
+  }
+
+  FramePacerStats stats = pacer.getStats();
+  TEST_ASSERT_EQUAL_UINT32(10, stats.rendered);
+  TEST_ASSERT_EQUAL_UINT32(DISPLAY_MAX_FPS - 10, stats.skipped);
+  TEST_ASSERT_EQUAL_UINT16(DISPLAY_MAX_FPS, stats.maxFps);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_renders_only_after_change);
+  RUN_TEST(test_frame_rate_cap);
+  RUN_TEST(test_time_until_next_frame);
+  RUN_TEST(test_idle_after_timeout);
+  RUN_TEST(test_stats_count_skipped_slots);
+  return UNITY_END();
+}
@@ -0,0 +1,192 @@
+/**
+ * Golden-Frame-Tests: Eingabe-Trace -> MouseHandler -> DisplayManager
+ * Ein fester Mitschnitt (Bewegung, Links-, Rechts- und Doppelklick) wird
+ * im 60-fps-Raster wiedergegeben. Geprüft werden FNV-1a-Hashes des
+ * vorderen Framebuffers an festen Frames und die Bus-Bytes pro Frame
+ * (Performance-Gate). Bei Abweichung wird der Frame als PPM abgelegt.
+ *
+ * Nach einer gewollten Änderung am Rendering: Test laufen lassen, die
+ * gemeldeten Werte prüfen (PPM ansehen) und unten eintragen.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_hidh.h>
+#include "mouse_handler.h"
+#include "display.h"
+
+#define TRACE_MS 2000
+#define FRAME_US 16667
+
+struct GoldenFrame {
+  uint32_t frame;       // Index des gerenderten Frames
+  uint32_t hash;        // FNV-1a über den vorderen Puffer
+  uint32_t frameBytes;  // DisplayStats::lastFrameBytes
+};
+
+static const GoldenFrame GOLDEN[] = {
+  {1, 0x800856C5, 10582},   // Erster Frame: ganzer Bildschirm
+  {10, 0x61EE8FE9, 161},    // Nur Cursor
+  {25, 0x6862317D, 8952},   // Linksklick (Ringe)
+  {45, 0xA7C4F016, 7952},   // Rechtsklick (Strahlen)
+  {70, 0x3EE6ABB1, 6061},   // Beide Tasten
+  {90, 0x5F2DAA9D, 191},    // Effekte ausgelaufen
+};
+
+// Summe aller Bus-Bytes über den Trace (Framebuffer- und direkter Modus)
+static const uint64_t GOLDEN_TOTAL_BYTES_FRAMEBUFFER = 439098;
+static const uint64_t GOLDEN_TOTAL_BYTES_DIRECT = 606894;
+
+static uint32_t fnv1a(const uint16_t* pixels, size_t count) {
+  uint32_t hash = 2166136261u;
+  const uint8_t* bytes = (const uint8_t*)pixels;
+  for (size_t i = 0; i < count * 2; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static void dumpPPM(const MemoryBackend* buffer, uint32_t frame) {
+  char path[64];
+  snprintf(path, sizeof(path), "golden_frame_%u.ppm", frame);
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  uint8_t chunk[512];
+  size_t size = buffer->getPPMSize();
+  for (size_t offset = 0; offset < size;) {
+    size_t n = buffer->readPPM(offset, chunk, sizeof(chunk));
+    fwrite(chunk, 1, n, file);
+    offset += n;
+  }
+  fclose(file);
+}
+
+static void recordTrace(MouseHandler& mouse) {
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  for (uint32_t ms = 0; ms < TRACE_MS; ms += 4) {
+    bool left = (ms >= 300 && ms < 340) || (ms >= 1200 && ms < 1260);
+    bool right = (ms >= 700 && ms < 740) || (ms >= 1200 && ms < 1260);
+    bool moving = ms < 1600;
+    float phase = ms * 0.01f;  // Umlauf ~630 ms, Radius ~25 px
+    uint8_t report[4] = {
+      (uint8_t)((left ? MOUSE_BUTTON_LEFT : 0) | (right ? MOUSE_BUTTON_RIGHT : 0)),
+      (uint8_t)(int8_t)(moving ? lroundf(cosf(phase)) : 0),
+      (uint8_t)(int8_t)(moving ? lroundf(sinf(phase)) : 0),
+      0
+    };
+    hostHidhInput(0, report, sizeof(report));
+    mouse.update();
+    hostAdvanceMicros(4000);
+  }
+  mouse.stopTraceRecording();
+}
+
+static void handleButtonEvent(DisplayManager& display, const ButtonEvent& event) {
+  // Wie main.cpp
+  if (!event.pressed) {
+    return;
+  }
+  bool left = event.buttons & MOUSE_BUTTON_LEFT;
+  bool right = event.buttons & MOUSE_BUTTON_RIGHT;
+  if (left && right) {
+    display.drawClickAnimation(event.x, event.y, CLICK_BOTH);
+  } else if (event.button == MOUSE_BUTTON_LEFT) {
+    display.drawClickAnimation(event.x, event.y, CLICK_LEFT);
+  } else if (event.button == MOUSE_BUTTON_RIGHT) {
+    display.drawClickAnimation(event.x, event.y, CLICK_RIGHT);
+  }
+}
+
+// Trace wiedergeben; prüft die Golden-Frames (nur mit Framebuffer)
+static uint64_t replay(bool checkFrames) {
+  DisplayManager display;
+  MouseHandler mouse;
+  display.begin();
+  mouse.begin();
+  hostHidhSetReportMap(nullptr, 0);
+  TEST_ASSERT_TRUE(mouse.connectBTClassicMouse("11:22:33:44:55:66"));
+  hostHidhOpen();
+  recordTrace(mouse);
+  TEST_ASSERT_EQUAL(checkFrames, display.isFramebufferActive());
+
+  uint32_t cursor = mouse.getButtonEventSeq();
+  TEST_ASSERT_TRUE(mouse.startTraceReplay(HID_TRACE_SPEED_ORIGINAL));
+
+  uint64_t totalBytes = 0;
+  size_t nextGolden = 0;
+  uint32_t startUs = micros();
+  // Nach dem Trace weiter, bis alle Effekte ausgelaufen sind
+  while (micros() - startUs < (TRACE_MS + 1500) * 1000) {
+    hostAdvanceMicros(FRAME_US);
+    mouse.update();
+    MouseData data = mouse.getMouseData();
+    display.drawCursor(data.x, data.y, data.speed);
+    ButtonEvent event;
+    while (mouse.pollButtonEvent(cursor, event)) {
+      handleButtonEvent(display, event);
+    }
+    display.showMouseStatus("Maus verbunden");
+    display.updateAnimations();
+    if (!display.hasPendingChanges()) {
+      continue;
+    }
+
+    display.renderFrame();
+    DisplayStats stats = display.getStats();
+    totalBytes += stats.lastFrameBytes;
+
+    if (checkFrames && nextGolden < sizeof(GOLDEN) / sizeof(GOLDEN[0]) &&
+        stats.frames == GOLDEN[nextGolden].frame) {
+      const MemoryBackend* front = display.getFrontBuffer();
+      uint32_t hash = fnv1a(front->getBuffer(), (size_t)front->getWidth() * front->getHeight());
+      char line[120];
+      snprintf(line, sizeof(line), "Frame %u: Hash 0x%08X, %u Bytes", stats.frames, hash,
+               stats.lastFrameBytes);
+      TEST_MESSAGE(line);
+      if (hash != GOLDEN[nextGolden].hash) {
+        dumpPPM(front, stats.frames);
+      }
+      TEST_ASSERT_EQUAL_HEX32(GOLDEN[nextGolden].hash, hash);
+      TEST_ASSERT_EQUAL_UINT32(GOLDEN[nextGolden].frameBytes, stats.lastFrameBytes);
+      nextGolden++;
+    }
+  }
+
+  if (checkFrames) {
+    TEST_ASSERT_EQUAL_UINT32(sizeof(GOLDEN) / sizeof(GOLDEN[0]), nextGolden);
+  }
+  char line[80];
+  snprintf(line, sizeof(line), "%u Frames, %llu Bytes gesamt", display.getStats().frames,
+           (unsigned long long)totalBytes);
+  TEST_MESSAGE(line);
+  hostHidhClose();
+  return totalBytes;
+}
+
+void setUp() {
+  hostSetMicros(1000);
+  hostDmaAvailable = true;
+  hostPsramAvailable = true;
+}
+
+void tearDown() {}
+
+void test_golden_frames_framebuffer() {
+  uint64_t totalBytes = replay(true);
+  TEST_ASSERT_EQUAL_UINT64(GOLDEN_TOTAL_BYTES_FRAMEBUFFER, totalBytes);
+}
+
+void test_bus_bytes_direct_mode() {
+  hostPsramAvailable = false;
+  uint64_t totalBytes = replay(false);
+  TEST_ASSERT_EQUAL_UINT64(GOLDEN_TOTAL_BYTES_DIRECT, totalBytes);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_golden_frames_framebuffer);
+  RUN_TEST(test_bus_bytes_direct_mode);
+  return UNITY_END();
+}
@@ -0,0 +1,195 @@
+/**
+ * Host-Tests: HID-Deskriptor-Parser und hidDecodeReport
+ * (Report-IDs, vorzeichenbehaftete/-lose Felder, 12- und 16-Bit-Achsen)
+ */
+
+#include <unity.h>
+#include "hid_descriptor.h"
+
+// Boot-ähnliche Maus: 3 Tasten, 5 Bit Padding, int8 X/Y/Wheel
+static const uint8_t MOUSE_8BIT[] = {
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x03, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x03, 0x75, 0x01, 0x81, 0x02,
+  0x95, 0x01, 0x75, 0x05, 0x81, 0x01,
+  0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x09, 0x38, 0x15, 0x81, 0x25, 0x7F,
+  0x75, 0x08, 0x95, 0x03, 0x81, 0x06,
+  0xC0, 0xC0
+};
+
+// Kombi-Gerät: Tastatur (Report-ID 1) vor der Maus (Report-ID 2) mit
+// 5 Tasten, int16 X/Y, int8 Wheel und AC Pan (Consumer-Page)
+static const uint8_t COMPOSITE_16BIT[] = {
+  0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x85, 0x01,
+  0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01,
+  0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+  0x95, 0x06, 0x75, 0x08, 0x15, 0x00, 0x25, 0x65, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00,
+  0xC0,
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x85, 0x02, 0x09, 0x01, 0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x05, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x05, 0x75, 0x01, 0x81, 0x02,
+  0x95, 0x01, 0x75, 0x03, 0x81, 0x01,
+  0x05, 0x01, 0x16, 0x01, 0x80, 0x26, 0xFF, 0x7F, 0x75, 0x10, 0x95, 0x02,
+  0x09, 0x30, 0x09, 0x31, 0x81, 0x06,
+  0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x01, 0x09, 0x38, 0x81, 0x06,
+  0x05, 0x0C, 0x0A, 0x38, 0x02, 0x95, 0x01, 0x81, 0x06,
+  0xC0, 0xC0
+};
+
+// Gepackte 12-Bit-Achsen hinter 16 Tasten (nicht Byte-ausgerichtet)
+static const uint8_t MOUSE_12BIT[] = {
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x10, 0x75, 0x01, 0x81, 0x02,
+  0x05, 0x01, 0x16, 0x01, 0xF8, 0x26, 0xFF, 0x07, 0x75, 0x0C, 0x95, 0x02,
+  0x09, 0x30, 0x09, 0x31, 0x81, 0x06,
+  0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x01, 0x09, 0x38, 0x81, 0x06,
+  0xC0, 0xC0
+};
+
+// Push/Pop: vorzeichenloses Wheel zwischen gesichertem und
+// wiederhergestelltem (vorzeichenbehaftetem) Zustand
+static const uint8_t MOUSE_PUSH_POP[] = {
+  0x05, 0x01, 0x09, 0x02, 0xA1, 0x01,
+  0x05, 0x09, 0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x25, 0x01,
+  0x95, 0x08, 0x75, 0x01, 0x81, 0x02,
+  0x05, 0x01, 0x15, 0x81, 0x25, 0x7F, 0x75, 0x08,
+  0xA4,
+  0x15, 0x00, 0x26, 0xFF, 0x00, 0x95, 0x01, 0x09, 0x38, 0x81, 0x02,
+  0xB4,
+  0x95, 0x02, 0x09, 0x30, 0x09, 0x31, 0x81, 0x06,
+  0xC0
+};
+
+// Nur Tastatur: kein Report mit X und Y
+static const uint8_t KEYBOARD_ONLY[] = {
+  0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,
+  0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01,
+  0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+  0xC0
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_8bit_mouse_matches_boot_layout() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(MOUSE_8BIT, sizeof(MOUSE_8BIT), plan));
+  TEST_ASSERT_EQUAL_UINT8(0, plan.reportId);
+  TEST_ASSERT_EQUAL_UINT8(4, plan.reportLength);
+  TEST_ASSERT_EQUAL_UINT8(3, plan.minLength);
+  TEST_ASSERT_EQUAL_UINT8(3, plan.fields[HID_FIELD_BUTTONS].bitSize);
+  TEST_ASSERT_EQUAL_UINT8(0, plan.fields[HID_FIELD_PAN].bitSize);
+
+  const uint8_t data[] = {0x05, 0xFE, 0x7F, 0x81};
+  HidMouseReport report;
+  TEST_ASSERT_TRUE(hidDecodeReport(plan, data, sizeof(data), report));
+  TEST_ASSERT_EQUAL_HEX32(0x05, report.buttons);
+  TEST_ASSERT_EQUAL_INT32(-2, report.dx);
+  TEST_ASSERT_EQUAL_INT32(127, report.dy);
+  TEST_ASSERT_EQUAL_INT32(-127, report.wheel);
+
+  // Boot-Plan dekodiert denselben Report gleich
+  HidExtractionPlan boot;
+  HidMouseReport bootReport;
+  HidDescriptorParser::bootProtocolPlan(boot);
+  TEST_ASSERT_TRUE(hidDecodeReport(boot, data, sizeof(data), bootReport));
+  TEST_ASSERT_EQUAL_INT32(report.dx, bootReport.dx);
+  TEST_ASSERT_EQUAL_INT32(report.dy, bootReport.dy);
+  TEST_ASSERT_EQUAL_INT32(report.wheel, bootReport.wheel);
+}
+
+void test_composite_selects_mouse_report_id() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(COMPOSITE_16BIT, sizeof(COMPOSITE_16BIT), plan));
+  TEST_ASSERT_EQUAL_UINT8(2, plan.reportId);
+  TEST_ASSERT_EQUAL_UINT8(7, plan.reportLength);
+  TEST_ASSERT_EQUAL_UINT8(5, plan.minLength);
+  TEST_ASSERT_EQUAL_UINT8(5, plan.fields[HID_FIELD_BUTTONS].bitSize);
+  TEST_ASSERT_EQUAL_UINT8(16, plan.fields[HID_FIELD_X].bitSize);
+  TEST_ASSERT_EQUAL_UINT8(1, plan.fields[HID_FIELD_X].byteOffset);
+  TEST_ASSERT_EQUAL_UINT8(3, plan.fields[HID_FIELD_Y].byteOffset);
+  TEST_ASSERT_EQUAL_UINT8(6, plan.fields[HID_FIELD_PAN].byteOffset);
+}
+
+void test_signed_16bit_fields() {
+  HidExtractionPlan plan;
+  HidDescriptorParser::parse(COMPOSITE_16BIT, sizeof(COMPOSITE_16BIT), plan);
+
+  // Tasten 1+5, X = -300, Y = +1000, Wheel = -1, Pan = +2 (ohne Report-ID-Byte)
+  const uint8_t data[] = {0x11, 0xD4, 0xFE, 0xE8, 0x03, 0xFF, 0x02};
+  HidMouseReport report;
+  TEST_ASSERT_TRUE(hidDecodeReport(plan, data, sizeof(data), report));
+  TEST_ASSERT_EQUAL_HEX32(0x11, report.buttons);
+  TEST_ASSERT_EQUAL_INT32(-300, report.dx);
+  TEST_ASSERT_EQUAL_INT32(1000, report.dy);
+  TEST_ASSERT_EQUAL_INT32(-1, report.wheel);
+  TEST_ASSERT_EQUAL_INT32(2, report.pan);
+
+  // Extremwerte
+  const uint8_t limits[] = {0x00, 0x01, 0x80, 0xFF, 0x7F};
+  TEST_ASSERT_TRUE(hidDecodeReport(plan, limits, sizeof(limits), report));
+  TEST_ASSERT_EQUAL_INT32(-32767, report.dx);
+  TEST_ASSERT_EQUAL_INT32(32767, report.dy);
+  TEST_ASSERT_EQUAL_INT32(0, report.wheel);  // Fehlende Bytes lesen sich als 0
+}
+
+void test_packed_12bit_fields() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(MOUSE_12BIT, sizeof(MOUSE_12BIT), plan));
+  TEST_ASSERT_EQUAL_UINT8(16, plan.fields[HID_FIELD_BUTTONS].bitSize);
+  TEST_ASSERT_EQUAL_UINT8(12, plan.fields[HID_FIELD_X].bitSize);
+  TEST_ASSERT_EQUAL_UINT8(4, plan.fields[HID_FIELD_Y].shift);
+
+  // X = -5 (0xFFB), Y = 300 (0x12C), Wheel = 3, Taste 16
+  const uint8_t data[] = {0x00, 0x80, 0xFB, 0xCF, 0x12, 0x03};
+  HidMouseReport report;
+  TEST_ASSERT_TRUE(hidDecodeReport(plan, data, sizeof(data), report));
+  TEST_ASSERT_EQUAL_HEX32(0x8000, report.buttons);
+  TEST_ASSERT_EQUAL_INT32(-5, report.dx);
+  TEST_ASSERT_EQUAL_INT32(300, report.dy);
+  TEST_ASSERT_EQUAL_INT32(3, report.wheel);
+}
+
+void test_push_pop_restores_signedness() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_TRUE(HidDescriptorParser::parse(MOUSE_PUSH_POP, sizeof(MOUSE_PUSH_POP), plan));
+  TEST_ASSERT_EQUAL_UINT8(0, plan.fields[HID_FIELD_WHEEL].signShift);
+  TEST_ASSERT_EQUAL_UINT8(56, plan.fields[HID_FIELD_X].signShift);
+
+  const uint8_t data[] = {0x00, 0xFF, 0xFE, 0x02};
+  HidMouseReport report;
+  TEST_ASSERT_TRUE(hidDecodeReport(plan, data, sizeof(data), report));
+  TEST_ASSERT_EQUAL_INT32(255, report.wheel);  // Vorzeichenlos
+  TEST_ASSERT_EQUAL_INT32(-2, report.dx);
+  TEST_ASSERT_EQUAL_INT32(2, report.dy);
+}
+
+void test_short_report_rejected() {
+  HidExtractionPlan plan;
+  HidDescriptorParser::parse(COMPOSITE_16BIT, sizeof(COMPOSITE_16BIT), plan);
+
+  const uint8_t data[] = {0x01, 0x10, 0x00, 0x20};
+  HidMouseReport report;
+  TEST_ASSERT_FALSE(hidDecodeReport(plan, data, sizeof(data), report));
+}
+
+void test_descriptor_without_pointer_rejected() {
+  HidExtractionPlan plan;
+  TEST_ASSERT_FALSE(HidDescriptorParser::parse(KEYBOARD_ONLY, sizeof(KEYBOARD_ONLY), plan));
+
+  // Abgeschnittener Deskriptor: kein Lesen über das Ende hinaus
+  TEST_ASSERT_FALSE(HidDescriptorParser::parse(MOUSE_8BIT, 30, plan));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_8bit_mouse_matches_boot_layout);
+  RUN_TEST(test_composite_selects_mouse_report_id);
+  RUN_TEST(test_signed_16bit_fields);
+  RUN_TEST(test_packed_12bit_fields);
+  RUN_TEST(test_push_pop_restores_signedness);
+  RUN_TEST(test_short_report_rejected);
+  RUN_TEST(test_descriptor_without_pointer_rejected);
+  return UNITY_END();
+}
@@ -0,0 +1,106 @@
+/**
+ * Host-Tests: HID-Trace im MouseHandler
+ * Aufzeichnung/Export-Stream, Wiedergabe und das Zusammenspiel beider
+ * (Aufzeichnen beendet die Wiedergabe, Export beendet die Aufzeichnung).
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <esp_hidh.h>
+#include "mouse_handler.h"
+
+static void connectMouse(MouseHandler& mouse) {
+  mouse.begin();
+  hostHidhSetReportMap(nullptr, 0);
+  TEST_ASSERT_TRUE(mouse.connectBTClassicMouse("11:22:33:44:55:66"));
+  hostHidhOpen();
+}
+
+static void sendMotion(MouseHandler& mouse, int count) {
+  for (int i = 0; i < count; i++) {
+    uint8_t report[4] = {0, 1, 0, 0};
+    hostHidhInput(0, report, sizeof(report));
+    hostAdvanceMicros(1000);
+  }
+  mouse.update();
+}
+
+void setUp() {
+  hostSetMicros(1000);
+}
+
+void tearDown() {
+  hostHidhClose();
+}
+
+void test_export_stream_roundtrip() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  sendMotion(mouse, 20);
+  mouse.stopTraceRecording();
+
+  // Stream in kleinen Stücken lesen und wieder abspielen
+  size_t size = mouse.getTraceSize();
+  uint8_t stream[512];
+  TEST_ASSERT_LESS_OR_EQUAL(sizeof(stream), size);
+  size_t offset = 0;
+  while (offset < size) {
+    offset += mouse.readTrace(offset, stream + offset, 7);
+  }
+  TEST_ASSERT_EQUAL_MEMORY(HID_TRACE_MAGIC, stream, 4);
+
+  HidTracePlayer player;
+  TEST_ASSERT_TRUE(player.beginStream(stream, size, 0, HID_TRACE_SPEED_MAX));
+  HidTraceRecord record;
+  uint32_t played = 0;
+  while (player.next(0, record)) {
+    TEST_ASSERT_EQUAL_UINT8(1, record.data[1]);
+    played++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(20, played);
+}
+
+void test_recording_stops_replay() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  sendMotion(mouse, 20);
+  TEST_ASSERT_TRUE(mouse.startTraceReplay(HID_TRACE_SPEED_ORIGINAL));
+  TEST_ASSERT_TRUE(mouse.isTraceReplaying());
+
+  // Neue Aufzeichnung leert den Puffer, aus dem die Wiedergabe liest
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  TEST_ASSERT_FALSE(mouse.isTraceReplaying());
+  TEST_ASSERT_EQUAL_UINT32(0, mouse.getTraceRecordCount());
+
+  int x = mouse.getMouseData().x;
+  hostAdvanceMicros(100000);
+  mouse.update();
+  TEST_ASSERT_EQUAL_INT(x, mouse.getMouseData().x);
+}
+
+void test_export_stops_recording() {
+  MouseHandler mouse;
+  connectMouse(mouse);
+  TEST_ASSERT_TRUE(mouse.startTraceRecording());
+  sendMotion(mouse, 10);
+
+  uint8_t chunk[16];
+  TEST_ASSERT_EQUAL_UINT32(sizeof(chunk), mouse.readTrace(0, chunk, sizeof(chunk)));
+  TEST_ASSERT_FALSE(mouse.isTraceRecording());
+
+  // Weitere Reports ändern den laufenden Export nicht mehr
+  size_t size = mouse.getTraceSize();
+  sendMotion(mouse, 10);
+  TEST_ASSERT_EQUAL_UINT32(size, mouse.getTraceSize());
+  TEST_ASSERT_EQUAL_UINT32(10, mouse.getTraceRecordCount());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_export_stream_roundtrip);
+  RUN_TEST(test_recording_stops_replay);
+  RUN_TEST(test_export_stops_recording);
+  return UNITY_END();
+}
@@ -0,0 +1,107 @@
+/**
+ * Host-Tests: LoopScheduler mit virtueller Uhr
+ */
+
+#include <unity.h>
+#include "loop_scheduler.h"
+
+static uint32_t clockUs = 0;
+
+static uint32_t testClock() {
+  return clockUs;
+}
+
+void setUp() {
+  clockUs = 0;
+}
+
+void tearDown() {}
+
+void test_task_due_after_interval() {
+  LoopScheduler scheduler(testClock);
+  scheduler.setInterval(TASK_MOUSE, 10);
+  scheduler.start();
+
+  TEST_ASSERT_FALSE(scheduler.isDue(TASK_MOUSE));
+  clockUs += 9999;
+  TEST_ASSERT_FALSE(scheduler.isDue(TASK_MOUSE));
+  clockUs += 1;
+  TEST_ASSERT_TRUE(scheduler.isDue(TASK_MOUSE));
+  TEST_ASSERT_FALSE(scheduler.isDue(TASK_MOUSE));  // Lauf wurde gemerkt
+}
+
+void test_zero_interval_is_event_driven() {
+  LoopScheduler scheduler(testClock);
+  scheduler.setInterval(TASK_DISPLAY, 0);
+  scheduler.start();
+
+  clockUs += 1000000;
+  TEST_ASSERT_FALSE(scheduler.isDue(TASK_DISPLAY));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, scheduler.timeUntilNextTask());
+}
+
+void test_time_until_next_task() {
+  LoopScheduler scheduler(testClock);
+  scheduler.setInterval(TASK_MOUSE, 10);
+  scheduler.setInterval(TASK_NETWORK, 250);
+  scheduler.start();
+
+  clockUs += 4000;
+  TEST_ASSERT_EQUAL_UINT32(6000, scheduler.timeUntilNextTask());
+  clockUs += 7000;
+  TEST_ASSERT_EQUAL_UINT32(0, scheduler.timeUntilNextTask());
+
+  // Nach dem Lauf der Maus-Aufgabe bestimmt sie wieder den Takt
+  TEST_ASSERT_TRUE(scheduler.isDue(TASK_MOUSE));
+  TEST_ASSERT_EQUAL_UINT32(10000, scheduler.timeUntilNextTask());
+}
+
+void test_task_runtime_stats() {
+  LoopScheduler scheduler(testClock);
+  scheduler.start();
+
+  scheduler.beginTask(TASK_MOUSE);
+  clockUs += 300;
+  scheduler.endTask(TASK_MOUSE);
+  scheduler.beginTask(TASK_MOUSE);
+  clockUs += 100;
+  scheduler.endTask(TASK_MOUSE);
+  scheduler.addIdleTime(500);
+  clockUs += 500;
+
+  LoopTaskStats stats = scheduler.getStats(TASK_MOUSE);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.runs);
+  TEST_ASSERT_EQUAL_UINT32(100, stats.lastUs);
+  TEST_ASSERT_EQUAL_UINT32(300, stats.maxUs);
+  TEST_ASSERT_EQUAL_UINT64(400, stats.totalUs);
+  TEST_ASSERT_EQUAL_UINT64(500, scheduler.getIdleUs());
+  TEST_ASSERT_EQUAL_UINT32(900, scheduler.getStatsWindowUs());
+
+  scheduler.resetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats(TASK_MOUSE).runs);
+  TEST_ASSERT_EQUAL_UINT64(0, scheduler.getIdleUs());
+}
+
+void test_clock_wraparound() {
+  // micros() läuft nach ~71 Minuten über
+  clockUs = 0xFFFFF000;
+  LoopScheduler scheduler(testClock);
+  scheduler.setInterval(TASK_NETWORK, 250);
+  scheduler.start();
+
+  clockUs += 249999;
+  TEST_ASSERT_FALSE(scheduler.isDue(TASK_NETWORK));
+  TEST_ASSERT_EQUAL_UINT32(1, scheduler.timeUntilNextTask());
+  clockUs += 1;
+  TEST_ASSERT_TRUE(scheduler.isDue(TASK_NETWORK));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_task_due_after_interval);
+  RUN_TEST(test_zero_interval_is_event_driven);
+  RUN_TEST(test_time_until_next_task);
+  RUN_TEST(test_task_runtime_stats);
+  RUN_TEST(test_clock_wraparound);
+  return UNITY_END();
+}
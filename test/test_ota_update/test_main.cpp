@@ -0,0 +1,368 @@
+/**
+ * Host-Tests: fortsetzbarer OTA-Upload über OtaUpdater
+ * Stücke wie /api/ota/chunk: Schreibrecht per claim() am Offset, Abbruch
+ * mitten im Stück, Fortsetzen an getOffset(), falsche Offsets (409),
+ * SHA-256-Abweichung und Fehler, die die Sitzung beenden. Update und
+ * mbedtls kommen als Ersatz aus host/, das Image landet im Speicher.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <Update.h>
+#include <mbedtls/sha256.h>
+#include <vector>
+#include "ota_update.h"
+
+#define TCP_SEGMENT 1436
+#define UPLOAD_CHUNK 32768
+
+// Einfacher LZSS-Packer im Format von tools/ota_compress.py
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& input) {
+  std::vector<uint8_t> out;
+  size_t flagPos = 0;
+  int entries = 8;
+  for (size_t pos = 0; pos < input.size();) {
+    if (entries == 8) {
+      flagPos = out.size();
+      out.push_back(0);
+      entries = 0;
+    }
+
+    size_t bestLength = 0;
+    size_t bestDistance = 0;
+    size_t start = pos > LZSS_WINDOW_SIZE ? pos - LZSS_WINDOW_SIZE : 0;
+    for (size_t candidate = start; candidate < pos; candidate++) {
+      size_t length = 0;
+      while (length < LZSS_MAX_MATCH && pos + length < input.size() &&
+             input[candidate + length] == input[pos + length]) {
+        length++;
+      }
+      if (length > bestLength) {
+        bestLength = length;
+        bestDistance = pos - candidate;
+      }
+    }
+
+    if (bestLength >= LZSS_MIN_MATCH) {
+      uint16_t distance = (uint16_t)(bestDistance - 1);
+      out.push_back(distance & 0xFF);
+      out.push_back((uint8_t)(((distance >> 8) << 4) | (bestLength - LZSS_MIN_MATCH)));
+      pos += bestLength;
+    } else {
+      out[flagPos] |= 1 << entries;
+      out.push_back(input[pos]);
+      pos++;
+    }
+    entries++;
+  }
+  return out;
+}
+
+static void sha256(const std::vector<uint8_t>& data, uint8_t* digest) {
+  mbedtls_sha256_context context;
+  mbedtls_sha256_init(&context);
+  mbedtls_sha256_starts(&context, 0);
+  mbedtls_sha256_update(&context, data.data(), data.size());
+  mbedtls_sha256_finish(&context, digest);
+  mbedtls_sha256_free(&context);
+}
+
+static void toHex(const uint8_t* digest, char* out) {
+  for (int i = 0; i < OTA_HASH_SIZE; i++) {
+    snprintf(out + i * 2, 3, "%02x", digest[i]);
+  }
+}
+
+// Firmware-ähnlich: beginnt mit 0xE9, wiederkehrende Muster zwischen Zufallsbytes
+static std::vector<uint8_t> makeImage(size_t size) {
+  std::vector<uint8_t> image(size);
+  uint32_t random = 0xC0FFEE;
+  for (size_t i = 0; i < size; i++) {
+    random = random * 1664525u + 1013904223u;
+    if ((i / 64) % 3 == 0) {
+      image[i] = (uint8_t)(random >> 24);
+    } else {
+      image[i] = (uint8_t)("\x00\x00\x80\x3F\xE0\x41\x12\x00"[i % 8] + (i / 512));
+    }
+  }
+  image[0] = 0xE9;
+  return image;
+}
+
+// .bin.lzs: "LZS1", Originalgröße, SHA-256 des Images, LZSS-Strom
+static std::vector<uint8_t> makeCompressedUpload(const std::vector<uint8_t>& image,
+                                                 bool corruptHash = false) {
+  std::vector<uint8_t> upload(OTA_COMPRESSED_MAGIC, OTA_COMPRESSED_MAGIC + 4);
+  for (int i = 0; i < 4; i++) {
+    upload.push_back((uint8_t)(image.size() >> (i * 8)));
+  }
+  uint8_t digest[OTA_HASH_SIZE];
+  sha256(image, digest);
+  if (corruptHash) {
+    digest[OTA_HASH_SIZE - 1] ^= 0x01;
+  }
+  upload.insert(upload.end(), digest, digest + OTA_HASH_SIZE);
+  std::vector<uint8_t> stream = compress(image);
+  upload.insert(upload.end(), stream.begin(), stream.end());
+  return upload;
+}
+
+// Ein POST /api/ota/chunk wie im Webserver: claim() beim ersten Segment,
+// Segmente bis zum Abbruch nach delivered Bytes, dann Antwort oder Trennung.
+// Liefert den HTTP-Status (0 = Verbindung abgebrochen).
+static int sendChunk(OtaUpdater& ota, const void* request, uint32_t offset,
+                     const std::vector<uint8_t>& upload, size_t length, size_t delivered) {
+  bool claimed = ota.claim(request, offset);
+  for (size_t sent = 0; sent < delivered; sent += TCP_SEGMENT) {
+    if (!ota.isWriter(request)) {
+      break;  // Abgewiesen: Body wird verworfen
+    }
+    size_t segment = std::min<size_t>(TCP_SEGMENT, delivered - sent);
+    ota.process(&upload[offset + sent], segment);
+    if (ota.isComplete() && !ota.hasError()) {
+      ota.finish();
+    }
+  }
+  if (delivered < length) {
+    ota.release(request);  // onDisconnect
+    return 0;
+  }
+
+  bool accepted = ota.release(request);
+  TEST_ASSERT_EQUAL(claimed, accepted);
+  if (ota.hasError()) {
+    return 500;
+  }
+  return accepted ? 200 : 409;
+}
+
+// Client wie data/index.html: Stücke zu 32 KB, nach Abbruch Offset erfragen
+static uint32_t uploadWithDrops(OtaUpdater& ota, const std::vector<uint8_t>& upload,
+                                uint32_t dropEvery) {
+  ota.begin(nullptr, upload.size());
+  uint32_t interruptions = 0;
+  uint32_t offset = 0;
+  uint32_t chunks = 0;
+  int request = 0;
+  while (offset < upload.size() && ota.isActive()) {
+    size_t length = std::min<size_t>(UPLOAD_CHUNK, upload.size() - offset);
+    size_t delivered = length;
+    if (++chunks % dropEvery == 0) {
+      delivered = (chunks * 7919) % length;  // Auch mitten im TCP-Segment
+      interruptions++;
+    }
+    sendChunk(ota, &request, offset, upload, length, delivered);
+    offset = ota.getOffset();
+  }
+  return interruptions;
+}
+
+void setUp() {
+  hostUpdateReset();
+  hostSetMicros(1000);
+}
+
+void tearDown() {}
+
+void test_sha256_stand_in() {
+  const char* text = "abc";
+  std::vector<uint8_t> data(text, text + 3);
+  uint8_t digest[OTA_HASH_SIZE];
+  char hex[OTA_HASH_SIZE * 2 + 1];
+  sha256(data, digest);
+  toHex(digest, hex);
+  TEST_ASSERT_EQUAL_STRING("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hex);
+}
+
+void test_compressed_upload_resumes_after_drops() {
+  std::vector<uint8_t> image = makeImage(300000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image);
+  TEST_ASSERT_LESS_THAN(image.size(), upload.size());
+
+  OtaUpdater ota;
+  uint32_t interruptions = uploadWithDrops(ota, upload, 2);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, interruptions);
+
+  OtaStats stats = ota.getStats();
+  TEST_ASSERT_FALSE(ota.hasError());
+  TEST_ASSERT_TRUE(stats.success);
+  TEST_ASSERT_TRUE(stats.compressed);
+  TEST_ASSERT_FALSE(ota.isActive());
+  TEST_ASSERT_FALSE(ota.isClaimed());
+  TEST_ASSERT_EQUAL_UINT32(upload.size(), stats.received);
+  TEST_ASSERT_EQUAL_UINT32(image.size(), stats.written);
+  TEST_ASSERT_TRUE(Update.ended);
+  TEST_ASSERT_EQUAL_UINT32(1, Update.begins);
+  TEST_ASSERT_EQUAL_UINT32(image.size(), hostUpdateImage.size());
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), hostUpdateImage.data(), image.size());
+}
+
+void test_every_interruption_point() {
+  // Jedes Stück bricht nach einem Byte ab: Kopf, Flag-Bytes und Verweise
+  // werden an jeder möglichen Stelle getrennt
+  std::vector<uint8_t> image = makeImage(6000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image);
+
+  OtaUpdater ota;
+  ota.begin(nullptr, upload.size());
+  int request = 0;
+  while (ota.getOffset() < upload.size()) {
+    uint32_t offset = ota.getOffset();
+    size_t length = std::min<size_t>(UPLOAD_CHUNK, upload.size() - offset);
+    TEST_ASSERT_EQUAL(length > 1 ? 0 : 200, sendChunk(ota, &request, offset, upload, length, 1));
+    TEST_ASSERT_EQUAL_UINT32(offset + 1, ota.getOffset());
+  }
+
+  TEST_ASSERT_TRUE(ota.getStats().success);
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), hostUpdateImage.data(), image.size());
+}
+
+void test_raw_upload_with_hash_parameter() {
+  std::vector<uint8_t> image = makeImage(100000);
+  uint8_t digest[OTA_HASH_SIZE];
+  char hex[OTA_HASH_SIZE * 2 + 1];
+  sha256(image, digest);
+  toHex(digest, hex);
+
+  OtaUpdater ota;
+  ota.begin(hex, image.size());
+  int request = 0;
+  uint32_t offset = 0;
+  // Abbruch direkt nach dem ersten Byte (Formaterkennung) und mitten im Rest
+  TEST_ASSERT_EQUAL(0, sendChunk(ota, &request, offset, image, UPLOAD_CHUNK, 1));
+  offset = ota.getOffset();
+  TEST_ASSERT_EQUAL_UINT32(1, offset);
+  TEST_ASSERT_EQUAL(0, sendChunk(ota, &request, offset, image, UPLOAD_CHUNK, 5000));
+  offset = ota.getOffset();
+  while (offset < image.size()) {
+    size_t length = std::min<size_t>(UPLOAD_CHUNK, image.size() - offset);
+    TEST_ASSERT_EQUAL(200, sendChunk(ota, &request, offset, image, length, length));
+    offset = ota.getOffset();
+  }
+
+  TEST_ASSERT_TRUE(ota.getStats().success);
+  TEST_ASSERT_FALSE(ota.getStats().compressed);
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), hostUpdateImage.data(), image.size());
+}
+
+void test_wrong_offsets_are_rejected() {
+  std::vector<uint8_t> image = makeImage(120000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image);
+
+  OtaUpdater ota;
+  ota.begin(nullptr, upload.size());
+  int first = 0, second = 0;
+  TEST_ASSERT_EQUAL(200, sendChunk(ota, &first, 0, upload, 10000, 10000));
+
+  // Wiederholung eines angenommenen Stücks und Sprung nach vorn
+  TEST_ASSERT_EQUAL(409, sendChunk(ota, &second, 0, upload, 10000, 10000));
+  TEST_ASSERT_EQUAL(409, sendChunk(ota, &second, 20000, upload, 10000, 10000));
+  TEST_ASSERT_EQUAL_UINT32(10000, ota.getOffset());
+
+  // Zweiter Request am richtigen Offset, während der erste noch schreibt:
+  // abgewiesen, und seine Antwort gibt die Sperre des ersten nicht frei
+  TEST_ASSERT_TRUE(ota.claim(&first, 10000));
+  TEST_ASSERT_FALSE(ota.claim(&second, 10000));
+  TEST_ASSERT_FALSE(ota.release(&second));
+  TEST_ASSERT_TRUE(ota.isWriter(&first));
+  ota.process(&upload[10000], 4000);
+  TEST_ASSERT_TRUE(ota.release(&first));
+  TEST_ASSERT_EQUAL_UINT32(14000, ota.getOffset());
+
+  // Rest normal, Image unverfälscht
+  uint32_t offset = ota.getOffset();
+  TEST_ASSERT_EQUAL(200, sendChunk(ota, &second, offset, upload, upload.size() - offset,
+                                   upload.size() - offset));
+  TEST_ASSERT_TRUE(ota.getStats().success);
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), hostUpdateImage.data(), image.size());
+}
+
+void test_hash_mismatch_fails() {
+  std::vector<uint8_t> image = makeImage(60000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image, true);
+
+  OtaUpdater ota;
+  uploadWithDrops(ota, upload, 3);
+
+  TEST_ASSERT_TRUE(ota.hasError());
+  TEST_ASSERT_EQUAL_STRING("SHA-256 stimmt nicht", ota.getError());
+  TEST_ASSERT_FALSE(ota.getStats().success);
+  TEST_ASSERT_FALSE(ota.isActive());
+  TEST_ASSERT_FALSE(Update.ended);
+  TEST_ASSERT_EQUAL_UINT32(1, Update.aborts);
+}
+
+void test_flash_error_ends_session() {
+  std::vector<uint8_t> image = makeImage(200000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image);
+  hostUpdateFailAt = 50000;
+
+  OtaUpdater ota;
+  ota.begin(nullptr, upload.size());
+  int request = 0;
+  uint32_t offset = 0;
+  int status = 200;
+  while (status == 200 && offset < upload.size()) {
+    size_t length = std::min<size_t>(UPLOAD_CHUNK, upload.size() - offset);
+    status = sendChunk(ota, &request, offset, upload, length, length);
+    offset = ota.getOffset();
+  }
+
+  // Fehler beendet die Sitzung sofort (loop() zeigt ihn), Sperre ist frei
+  TEST_ASSERT_EQUAL(500, status);
+  TEST_ASSERT_EQUAL_STRING("Flash-Schreibfehler", ota.getError());
+  TEST_ASSERT_FALSE(ota.isActive());
+  TEST_ASSERT_FALSE(ota.getStats().success);
+  TEST_ASSERT_FALSE(ota.isClaimed());
+  TEST_ASSERT_EQUAL_UINT32(1, Update.aborts);
+  TEST_ASSERT_LESS_THAN_UINT32(upload.size(), offset);
+
+  // Weitere Stücke: 500, kein zweites Abort, finish() ändert nichts
+  TEST_ASSERT_EQUAL(500, sendChunk(ota, &request, offset, upload, 1000, 1000));
+  TEST_ASSERT_FALSE(ota.finish());
+  TEST_ASSERT_EQUAL_UINT32(1, Update.aborts);
+
+  // Neuer Upload beginnt sauber
+  hostUpdateFailAt = SIZE_MAX;
+  uploadWithDrops(ota, upload, 4);
+  TEST_ASSERT_FALSE(ota.hasError());
+  TEST_ASSERT_TRUE(ota.getStats().success);
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), hostUpdateImage.data(), image.size());
+}
+
+void test_oversized_and_truncated_uploads_fail() {
+  std::vector<uint8_t> image = makeImage(40000);
+  std::vector<uint8_t> upload = makeCompressedUpload(image);
+
+  // Mehr Daten als angekündigt
+  OtaUpdater ota;
+  ota.begin(nullptr, upload.size() - 100);
+  int request = 0;
+  TEST_ASSERT_EQUAL(500, sendChunk(ota, &request, 0, upload, upload.size(), upload.size()));
+  TEST_ASSERT_EQUAL_STRING("Mehr Daten als angekündigt", ota.getError());
+  TEST_ASSERT_FALSE(ota.isActive());
+
+  // Strom endet mitten in einem Verweis
+  hostUpdateReset();
+  ota.begin(nullptr, 0);
+  std::vector<uint8_t> truncated(upload.begin(), upload.begin() + OTA_HEADER_SIZE);
+  const uint8_t partial[] = {0x01, 0xE9, 0x00};  // Literal, dann halber Verweis
+  truncated.insert(truncated.end(), partial, partial + sizeof(partial));
+  TEST_ASSERT_TRUE(ota.process(truncated.data(), truncated.size()));
+  TEST_ASSERT_FALSE(ota.finish());
+  TEST_ASSERT_FALSE(ota.isActive());
+  TEST_ASSERT_EQUAL_UINT32(1, Update.aborts);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sha256_stand_in);
+  RUN_TEST(test_compressed_upload_resumes_after_drops);
+  RUN_TEST(test_every_interruption_point);
+  RUN_TEST(test_raw_upload_with_hash_parameter);
+  RUN_TEST(test_wrong_offsets_are_rejected);
+  RUN_TEST(test_hash_mismatch_fails);
+  RUN_TEST(test_flash_error_ends_session);
+  RUN_TEST(test_oversized_and_truncated_uploads_fail);
+  return UNITY_END();
+}
@@ -0,0 +1,168 @@
+/**
+ * Host-Tests: ReportQueue (SPSC) - Reihenfolge, Überlauf und ein Stresstest
+ * mit echtem Producer- und Consumer-Thread
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "report_queue.h"
+
+#define STRESS_REPORTS 200000
+#define STRESS_BURST 96  // Mehr als die Kapazität: jeder Schub kann überlaufen
+
+// Report mit fortlaufender Nummer; Länge und Inhalt hängen von ihr ab
+static size_t makeReport(uint32_t seq, uint8_t* data) {
+  size_t length = 4 + seq % (REPORT_MAX_SIZE - 3);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = (uint8_t)(seq >> ((i % 4) * 8)) ^ (uint8_t)i;
+  }
+  return length;
+}
+
+static bool checkReport(const RawMouseReport& report) {
+  uint8_t expected[REPORT_MAX_SIZE];
+  size_t length = makeReport(report.timestampUs, expected);
+  return report.length == length && report.reportId == (uint8_t)report.timestampUs &&
+         memcmp(report.data, expected, length) == 0;
+}
+
+static bool pushSeq(ReportQueue& queue, uint32_t seq) {
+  uint8_t data[REPORT_MAX_SIZE];
+  size_t length = makeReport(seq, data);
+  return queue.push(seq, 2, (uint8_t)seq, data, length);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_fifo_order_and_overflow() {
+  ReportQueue queue;
+  for (uint32_t i = 0; i < REPORT_QUEUE_CAPACITY; i++) {
+    TEST_ASSERT_TRUE(pushSeq(queue, i));
+  }
+
+  // Voll: der neueste Report wird verworfen, die alten bleiben
+  TEST_ASSERT_FALSE(pushSeq(queue, 1000));
+  TEST_ASSERT_EQUAL_UINT32(REPORT_QUEUE_CAPACITY, queue.size());
+
+  RawMouseReport report;
+  for (uint32_t i = 0; i < REPORT_QUEUE_CAPACITY; i++) {
+    TEST_ASSERT_TRUE(queue.pop(report));
+    TEST_ASSERT_EQUAL_UINT32(i, report.timestampUs);
+    TEST_ASSERT_TRUE(checkReport(report));
+  }
+  TEST_ASSERT_FALSE(queue.pop(report));
+
+  ReportQueueStats stats = queue.getStats();
+  TEST_ASSERT_EQUAL_UINT32(REPORT_QUEUE_CAPACITY, stats.pushed);
+  TEST_ASSERT_EQUAL_UINT32(REPORT_QUEUE_CAPACITY, stats.popped);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.dropped);
+  TEST_ASSERT_EQUAL_UINT32(REPORT_QUEUE_CAPACITY, stats.highWater);
+}
+
+void test_long_report_truncated() {
+  ReportQueue queue;
+  uint8_t data[REPORT_MAX_SIZE + 4];
+  memset(data, 0xAB, sizeof(data));
+
+  TEST_ASSERT_TRUE(queue.push(1, 2, 3, data, sizeof(data)));
+  RawMouseReport report;
+  TEST_ASSERT_TRUE(queue.pop(report));
+  TEST_ASSERT_EQUAL_UINT8(REPORT_MAX_SIZE, report.length);
+  TEST_ASSERT_EQUAL_UINT32(1, queue.getStats().truncated);
+}
+
+void test_clear_discards_pending() {
+  ReportQueue queue;
+  pushSeq(queue, 1);
+  pushSeq(queue, 2);
+  queue.clear();
+
+  RawMouseReport report;
+  TEST_ASSERT_FALSE(queue.pop(report));
+  TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+  TEST_ASSERT_TRUE(pushSeq(queue, 3));
+  TEST_ASSERT_TRUE(queue.pop(report));
+  TEST_ASSERT_EQUAL_UINT32(3, report.timestampUs);
+}
+
+void test_two_thread_stress() {
+  static ReportQueue queue;
+  std::vector<uint32_t> accepted;
+  std::vector<uint32_t> received;
+  accepted.reserve(STRESS_REPORTS);
+  received.reserve(STRESS_REPORTS);
+  bool corrupted = false;
+
+  // Producer wie ein HID-Callback: nie blockieren, bei voller Queue verwerfen.
+  // Schübe, zwischen denen der Consumer aufholt
+  std::thread producer([&]() {
+    for (uint32_t seq = 0; seq < STRESS_REPORTS; seq++) {
+      if (pushSeq(queue, seq)) {
+        accepted.push_back(seq);
+      }
+      if (seq % STRESS_BURST == STRESS_BURST - 1) {
+        while (queue.size() > REPORT_QUEUE_CAPACITY / 2) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  });
+
+  // Consumer wie update(): leert die Queue, legt ab und zu eine Pause ein
+  std::thread consumer([&]() {
+    RawMouseReport report;
+    uint32_t idle = 0;
+    while (true) {
+      if (queue.pop(report)) {
+        if (!checkReport(report)) {
+          corrupted = true;
+        }
+        received.push_back(report.timestampUs);
+        if (received.size() % 4096 == 0) {
+          std::this_thread::yield();
+        }
+        idle = 0;
+      } else if (queue.getStats().pushed + queue.getStats().dropped == STRESS_REPORTS &&
+                 ++idle > 1000) {
+        break;
+      }
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  TEST_ASSERT_FALSE(corrupted);
+
+  // Genau die angenommenen Reports, in derselben Reihenfolge
+  TEST_ASSERT_EQUAL_UINT32(accepted.size(), received.size());
+  for (size_t i = 0; i < received.size(); i++) {
+    if (received[i] != accepted[i]) {
+      TEST_ASSERT_EQUAL_UINT32(accepted[i], received[i]);
+    }
+  }
+
+  // Verworfene Reports sind vollständig gezählt
+  ReportQueueStats stats = queue.getStats();
+  TEST_ASSERT_EQUAL_UINT32(accepted.size(), stats.pushed);
+  TEST_ASSERT_EQUAL_UINT32(received.size(), stats.popped);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_REPORTS - accepted.size(), stats.dropped);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(REPORT_QUEUE_CAPACITY, stats.highWater);
+
+  char line[96];
+  snprintf(line, sizeof(line), "%u Reports: %u angenommen, %u verworfen, max. Füllstand %u",
+           STRESS_REPORTS, stats.pushed, stats.dropped, stats.highWater);
+  TEST_MESSAGE(line);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fifo_order_and_overflow);
+  RUN_TEST(test_long_report_truncated);
+  RUN_TEST(test_clear_discards_pending);
+  RUN_TEST(test_two_thread_stress);
+  return UNITY_END();
+}
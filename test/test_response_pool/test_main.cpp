@@ -0,0 +1,191 @@
+/**
+ * Host-Tests: ResponsePool
+ * Belegen/Freigeben, Erschöpfung, ein simulierter 24-h-Dauerbetrieb
+ * (Dashboard-Polling mehrerer Clients auf der virtuellen Uhr) und
+ * gleichzeitige Nutzung aus mehreren Threads.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <queue>
+#include <vector>
+#include <thread>
+#include "response_pool.h"
+
+#define POOL_SLOTS 4          // AP_MAX_CONNECTIONS
+#define POOL_BUFFER_SIZE 2048 // JSON_RESPONSE_BUFFER_SIZE
+
+void setUp() {}
+void tearDown() {}
+
+void test_begin_validates_arguments() {
+  ResponsePool pool;
+  TEST_ASSERT_FALSE(pool.begin(0, POOL_BUFFER_SIZE));
+  TEST_ASSERT_FALSE(pool.begin(RESPONSE_POOL_MAX_SLOTS + 1, POOL_BUFFER_SIZE));
+  TEST_ASSERT_TRUE(pool.begin(POOL_SLOTS, POOL_BUFFER_SIZE));
+  TEST_ASSERT_FALSE(pool.begin(POOL_SLOTS, POOL_BUFFER_SIZE));  // Nur einmal
+  TEST_ASSERT_EQUAL_UINT32(POOL_BUFFER_SIZE, pool.getBufferSize());
+}
+
+void test_acquire_release_and_exhaustion() {
+  ResponsePool pool;
+  pool.begin(POOL_SLOTS, POOL_BUFFER_SIZE);
+
+  int slots[POOL_SLOTS];
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    slots[i] = pool.acquire();
+    TEST_ASSERT_EQUAL_INT(i, slots[i]);
+  }
+  // Puffer überlappen nicht
+  for (int i = 1; i < POOL_SLOTS; i++) {
+    TEST_ASSERT_EQUAL_INT(POOL_BUFFER_SIZE, pool.getBuffer(slots[i]) - pool.getBuffer(slots[i - 1]));
+  }
+
+  TEST_ASSERT_EQUAL_INT(-1, pool.acquire());
+  ResponsePoolStats stats = pool.getStats();
+  TEST_ASSERT_EQUAL_UINT32(POOL_SLOTS, stats.acquired);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.exhausted);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS, stats.inUse);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS, stats.highWater);
+
+  // Freigegebener Platz wird wieder vergeben
+  pool.release(slots[2]);
+  TEST_ASSERT_EQUAL_INT(2, pool.acquire());
+
+  // Doppelte und ungültige Freigaben ändern nichts
+  pool.release(slots[1]);
+  pool.release(slots[1]);
+  pool.release(-1);
+  pool.release(POOL_SLOTS);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS - 1, pool.getStats().inUse);
+
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    pool.release(i);
+  }
+  stats = pool.getStats();
+  TEST_ASSERT_EQUAL_UINT8(0, stats.inUse);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SLOTS, stats.highWater);
+}
+
+void test_pool_without_begin_is_always_exhausted() {
+  // sendJson fällt dann auf den Stream-Pfad zurück
+  ResponsePool pool;
+  TEST_ASSERT_EQUAL_INT(-1, pool.acquire());
+  TEST_ASSERT_EQUAL_UINT32(0, pool.getBufferSize());
+}
+
+void test_soak_24h_polling() {
+  // 4 Clients fragen alle 500 ms ab; eine Antwort belegt ihren Puffer
+  // 5..300 ms, jede 1000. hängt 20 s (langsamer Client)
+  const uint64_t durationMs = 24ULL * 3600 * 1000;
+  const int clients = 4;
+  const uint32_t intervalMs = 500;
+
+  ResponsePool pool;
+  TEST_ASSERT_TRUE(pool.begin(POOL_SLOTS, POOL_BUFFER_SIZE));
+
+  typedef std::pair<uint64_t, int> Release;  // Zeitpunkt, Slot
+  std::priority_queue<Release, std::vector<Release>, std::greater<Release>> pending;
+  bool owned[POOL_SLOTS] = {};
+  uint32_t random = 12345;
+  uint64_t requests = 0;
+  uint64_t pooled = 0;
+  uint64_t fallback = 0;
+
+  for (uint64_t now = 0; now < durationMs; now += intervalMs / clients) {
+    while (!pending.empty() && pending.top().first <= now) {
+      int slot = pending.top().second;
+      pending.pop();
+      TEST_ASSERT_TRUE(owned[slot]);
+      owned[slot] = false;
+      pool.release(slot);
+    }
+
+    requests++;
+    int slot = pool.acquire();
+    if (slot < 0) {
+      fallback++;
+      continue;
+    }
+    TEST_ASSERT_FALSE(owned[slot]);  // Nie doppelt vergeben
+    owned[slot] = true;
+    pooled++;
+
+    random = random * 1103515245u + 12345u;
+    uint32_t holdMs = (random >> 16) % 1000 == 0 ? 20000 : 5 + (random >> 8) % 296;
+    pending.push(Release(now + holdMs, slot));
+  }
+  while (!pending.empty()) {
+    pool.release(pending.top().second);
+    pending.pop();
+  }
+
+  ResponsePoolStats stats = pool.getStats();
+  char line[120];
+  snprintf(line, sizeof(line), "24 h: %llu Requests, %llu gepuffert, %llu Stream-Ausweichpfad, Spitze %u",
+           (unsigned long long)requests, (unsigned long long)pooled,
+           (unsigned long long)fallback, stats.highWater);
+  TEST_MESSAGE(line);
+
+  // Nichts verloren, nichts hängen geblieben
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)pooled, stats.acquired);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)fallback, stats.exhausted);
+  TEST_ASSERT_EQUAL_UINT8(0, stats.inUse);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(POOL_SLOTS, stats.highWater);
+  // Langsame Clients belegen Plätze, der Großteil läuft trotzdem gepuffert
+  TEST_ASSERT_GREATER_THAN_UINT32(requests * 99 / 100, pooled);
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    TEST_ASSERT_EQUAL_INT(i, pool.acquire());
+  }
+}
+
+void test_concurrent_owners_are_exclusive() {
+  // Jeder Thread stempelt seinen Puffer und prüft, dass niemand hineinschreibt
+  ResponsePool pool;
+  pool.begin(POOL_SLOTS, POOL_BUFFER_SIZE);
+  const int threads = 6;
+  const int rounds = 50000;
+  std::atomic<uint32_t> conflicts(0);
+  std::atomic<uint32_t> served(0);
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&pool, &conflicts, &served, t]() {
+      for (int n = 0; n < rounds; n++) {
+        int slot = pool.acquire();
+        if (slot < 0) {
+          continue;
+        }
+        uint8_t* buffer = pool.getBuffer(slot);
+        memset(buffer, t + 1, 64);
+        for (int i = 0; i < 64; i++) {
+          if (buffer[i] != t + 1) {
+            conflicts.fetch_add(1);
+            break;
+          }
+        }
+        served.fetch_add(1);
+        pool.release(slot);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  ResponsePoolStats stats = pool.getStats();
+  TEST_ASSERT_EQUAL_UINT32(0, conflicts.load());
+  TEST_ASSERT_EQUAL_UINT32(served.load(), stats.acquired);
+  TEST_ASSERT_EQUAL_UINT32(threads * rounds, stats.acquired + stats.exhausted);
+  TEST_ASSERT_EQUAL_UINT8(0, stats.inUse);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_validates_arguments);
+  RUN_TEST(test_acquire_release_and_exhaustion);
+  RUN_TEST(test_pool_without_begin_is_always_exhausted);
+  RUN_TEST(test_soak_24h_polling);
+  RUN_TEST(test_concurrent_owners_are_exclusive);
+  return UNITY_END();
+}
@@ -0,0 +1,369 @@
+/**
+ * Host-Tests: Station-Ablaufsteuerung zwischen WiFi-Ereignis-Task und loop()
+ * Nachzügler selbst abgebrochener Versuche (Neuverbindung, Timeout,
+ * hängende Schnellverbindung) zählen nicht als Fehlschlag. Ein simulierter
+ * WiFi-Treiber feuert in einem eigenen Thread Verbindungsstürme, während
+ * der loop()-Thread update() aufruft: dessen Dauer je Durchlauf bleibt
+ * klein, und der Backoff bremst WiFi.begin() trotz Ereignisflut.
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "station_control.h"
+
+// Gründe aus esp_wifi_types.h
+#define REASON_BEACON_TIMEOUT 200
+#define REASON_NO_AP_FOUND 201
+#define REASON_HANDSHAKE_TIMEOUT 15
+
+static uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Verbunden sein: Verbindungsaufbau starten und GOT_IP melden
+static void connect(StationControl& control, uint32_t nowMs) {
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, control.update(nowMs).action);
+  control.onConnected(nowMs + 100);
+  TEST_ASSERT_EQUAL(STATION_CONNECTED, control.getState());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_reconnect_ignores_own_disconnect() {
+  StationControl control;
+  control.start(0, false);
+  connect(control, 0);
+
+  // Neue Zugangsdaten: stop(), WiFi.disconnect(), start(), sofort begin()
+  control.stop();
+  control.start(5000, false);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, control.update(5000).action);
+
+  // STA_DISCONNECTED der alten Verbindung trifft im neuen Versuch ein
+  TEST_ASSERT_FALSE(control.onDisconnected(5010, STATION_REASON_ASSOC_LEAVE));
+  StationLinkStats stats = control.getStats(5010);
+  TEST_ASSERT_EQUAL(STATION_CONNECTING, stats.state);
+  TEST_ASSERT_EQUAL_UINT8(0, stats.failures);
+  TEST_ASSERT_EQUAL_UINT8(STATION_REASON_ASSOC_LEAVE, control.getLastDisconnectReason());
+
+  // Kein zweiter begin() über den laufenden Versuch
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, control.update(6000).action);
+  control.onConnected(6200);
+  stats = control.getStats(6200);
+  TEST_ASSERT_EQUAL(STATION_CONNECTED, stats.state);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.attempts);
+  TEST_ASSERT_EQUAL_UINT32(1200, stats.lastConnectMs);
+}
+
+void test_timeout_abort_ignores_late_disconnect() {
+  StationControl control;
+  control.start(0, false);
+  control.update(0);
+
+  TEST_ASSERT_EQUAL(STATION_ACTION_DISCONNECT, control.update(STATION_CONNECT_TIMEOUT_MS).action);
+  uint32_t retryInMs = control.getStats(STATION_CONNECT_TIMEOUT_MS).retryInMs;
+
+  // Nachzügler des abgebrochenen Versuchs: Backoff bleibt unverändert
+  TEST_ASSERT_FALSE(control.onDisconnected(STATION_CONNECT_TIMEOUT_MS + 50, STATION_REASON_ASSOC_LEAVE));
+  StationLinkStats stats = control.getStats(STATION_CONNECT_TIMEOUT_MS + 50);
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, stats.state);
+  TEST_ASSERT_EQUAL_UINT8(1, stats.failures);
+  TEST_ASSERT_EQUAL_UINT32(retryInMs - 50, stats.retryInMs);
+
+  // Nächster Versuch; eine weitere ASSOC_LEAVE-Trennung ist echt
+  uint32_t retryAt = STATION_CONNECT_TIMEOUT_MS + retryInMs;
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, control.update(retryAt).action);
+  TEST_ASSERT_TRUE(control.onDisconnected(retryAt + 300, STATION_REASON_ASSOC_LEAVE));
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, control.getState());
+  TEST_ASSERT_EQUAL_UINT8(2, control.getStats(retryAt + 300).failures);
+}
+
+void test_real_failure_still_counts_with_abort_pending() {
+  StationControl control;
+  control.start(0, false);
+  connect(control, 0);
+  control.stop();
+  control.start(1000, false);
+  control.update(1000);
+
+  // Anderer Grund: echter Fehlschlag, die erwartete Trennung bleibt offen
+  TEST_ASSERT_TRUE(control.onDisconnected(1100, REASON_NO_AP_FOUND));
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, control.getState());
+  TEST_ASSERT_FALSE(control.onDisconnected(1150, STATION_REASON_ASSOC_LEAVE));
+  TEST_ASSERT_EQUAL_UINT8(1, control.getStats(1150).failures);
+}
+
+void test_connect_clears_pending_aborts() {
+  StationControl control;
+  control.start(0, false);
+  control.update(0);
+
+  // Abbruch, dessen Ereignis der Treiber nie meldet
+  control.stop();
+  control.start(100, false);
+  connect(control, 100);
+
+  // Nach der neuen Verbindung ist ASSOC_LEAVE kein Nachzügler mehr
+  TEST_ASSERT_TRUE(control.onDisconnected(9000, STATION_REASON_ASSOC_LEAVE));
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, control.getState());
+}
+
+void test_fast_attempt_timeout_falls_back() {
+  StationControl control;
+  control.setCached(true);
+  control.start(0, true);
+  StationCommand command = control.update(0);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, command.action);
+  TEST_ASSERT_TRUE(command.fast);
+  TEST_ASSERT_TRUE(control.isFastAttempt());
+
+  // Schnellverbindung hängt: Abbruch und sofort normaler Aufbau
+  TEST_ASSERT_EQUAL(STATION_ACTION_DISCONNECT, control.update(STATION_CONNECT_TIMEOUT_MS).action);
+  TEST_ASSERT_FALSE(control.onDisconnected(STATION_CONNECT_TIMEOUT_MS + 5, STATION_REASON_ASSOC_LEAVE));
+  command = control.update(STATION_CONNECT_TIMEOUT_MS + 250);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, command.action);
+  TEST_ASSERT_FALSE(command.fast);
+  TEST_ASSERT_EQUAL_UINT8(0, control.getStats(STATION_CONNECT_TIMEOUT_MS + 250).failures);
+
+  control.onConnected(STATION_CONNECT_TIMEOUT_MS + 2000);
+  StationTiming timing = control.getTiming();
+  TEST_ASSERT_TRUE(timing.cached);
+  TEST_ASSERT_FALSE(timing.bootFast);
+  TEST_ASSERT_EQUAL_UINT32(STATION_CONNECT_TIMEOUT_MS + 2000, timing.bootConnectMs);
+}
+
+void test_fast_attempt_failure_and_cache_save() {
+  StationControl control;
+  control.start(0, true);
+  TEST_ASSERT_TRUE(control.update(0).fast);
+
+  // Cache passt nicht mehr: sofort normal, ohne Backoff
+  TEST_ASSERT_TRUE(control.onDisconnected(800, REASON_NO_AP_FOUND));
+  StationCommand command = control.update(800);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, command.action);
+  TEST_ASSERT_FALSE(command.fast);
+  TEST_ASSERT_FALSE(command.saveCache);
+
+  // Verbunden: Cache genau einmal aus loop() schreiben
+  control.onConnected(2500);
+  TEST_ASSERT_TRUE(control.update(2600).saveCache);
+  TEST_ASSERT_FALSE(control.update(2700).saveCache);
+  TEST_ASSERT_EQUAL_UINT32(2500, control.getTiming().bootConnectMs);
+  TEST_ASSERT_FALSE(control.getTiming().lastFast);
+}
+
+// ========== Verbindungssturm mit zwei Threads ==========
+
+#define STORM_DURATION_MS 60000
+#define STORM_LOOP_WORK_US 20      // Übrige Arbeit je loop()-Durchlauf (Wall-Zeit)
+#define STORM_RECONNECT_MS 2000    // Neue Zugangsdaten über die Weboberfläche
+#define STORM_NOISE_ONE_IN 250     // Je Millisekunde: Trennungsschauer aus dem Treiber
+
+enum DriverCommand { DRIVER_BEGIN, DRIVER_DISCONNECT };
+
+// Simulierter WiFi-Treiber: nimmt begin()/disconnect() aus loop() an und
+// meldet Ereignisse aus seinem eigenen Thread wie der WiFi-Ereignis-Task
+struct FakeDriver {
+  std::mutex commandLock;
+  std::deque<DriverCommand> commands;
+  std::atomic<uint32_t> clockMs{0};
+  std::atomic<bool> done{false};
+
+  StationControl* control;
+  portMUX_TYPE* lock;
+  uint32_t events = 0;
+  uint32_t ignored = 0;
+  uint32_t connects = 0;
+
+  void send(DriverCommand command) {
+    std::lock_guard<std::mutex> guard(commandLock);
+    commands.push_back(command);
+  }
+
+  void emitDisconnected(uint8_t reason) {
+    portENTER_CRITICAL(lock);
+    bool counted = control->onDisconnected(clockMs.load(), reason);
+    portEXIT_CRITICAL(lock);
+    events++;
+    ignored += counted ? 0 : 1;
+  }
+
+  void emitConnected() {
+    portENTER_CRITICAL(lock);
+    control->onConnected(clockMs.load());
+    portEXIT_CRITICAL(lock);
+    events++;
+    connects++;
+  }
+
+  void run() {
+    enum { OFF, ASSOCIATING, ASSOCIATED } link = OFF;
+    uint32_t random = 0x2545F491;
+    uint32_t linkSinceMs = 0;
+    uint32_t linkForMs = 0;
+    uint32_t noiseMs = 0;
+    while (!done.load()) {
+      random ^= random << 13;
+      random ^= random >> 17;
+      random ^= random << 5;
+      uint32_t now = clockMs.load();
+
+      // Treiber meldet Trennungen mehrfach und auch ohne laufenden Versuch;
+      // jede vergangene Millisekunde würfelt, auch wenn der Thread ruhte
+      bool noise = false;
+      while (noiseMs != now) {
+        noiseMs++;
+        uint32_t roll = (noiseMs * 2654435761u) ^ random;
+        if (roll % STORM_NOISE_ONE_IN == 0) {
+          int burst = 1 + (roll >> 8) % 16;
+          for (int i = 0; i < burst; i++) {
+            emitDisconnected(REASON_BEACON_TIMEOUT);
+          }
+          noise = true;
+        }
+      }
+      if (noise) {
+        link = OFF;
+      }
+
+      bool haveCommand = false;
+      DriverCommand command = DRIVER_BEGIN;
+      {
+        std::lock_guard<std::mutex> guard(commandLock);
+        if (!commands.empty()) {
+          command = commands.front();
+          commands.pop_front();
+          haveCommand = true;
+        }
+      }
+
+      if (haveCommand) {
+        // Eigene Trennung bzw. ersetzter Versuch: ASSOC_LEAVE
+        if (link != OFF) {
+          emitDisconnected(STATION_REASON_ASSOC_LEAVE);
+        }
+        link = command == DRIVER_BEGIN ? ASSOCIATING : OFF;
+        linkSinceMs = now;
+        linkForMs = 20 + random % 150;
+      } else if (link == ASSOCIATING && now - linkSinceMs >= linkForMs) {
+        // AP flattert: meist scheitert der Versuch, manchmal klappt er kurz
+        if (random % 4 == 0) {
+          emitConnected();
+          link = ASSOCIATED;
+          linkSinceMs = now;
+          linkForMs = 10 + random % 200;
+        } else {
+          emitDisconnected(random & 1 ? REASON_NO_AP_FOUND : REASON_HANDSHAKE_TIMEOUT);
+          link = OFF;
+        }
+      } else if (link == ASSOCIATED && now - linkSinceMs >= linkForMs) {
+        // Verbindung reißt ab, oft mit mehrfach gemeldeter Trennung
+        int burst = 1 + random % 16;
+        for (int i = 0; i < burst; i++) {
+          emitDisconnected(REASON_BEACON_TIMEOUT);
+        }
+        link = OFF;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+void test_reconnect_storm_keeps_loop_latency_bounded() {
+  StationControl control;
+  control.seed(0xA5A5A5A5);
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+  FakeDriver driver;
+  driver.control = &control;
+  driver.lock = &lock;
+
+  control.start(0, false);
+  std::thread events([&driver]() { driver.run(); });
+
+  // loop(): TASK_NETWORK wie in main.cpp, virtuelle Zeit in 1-ms-Schritten
+  std::vector<uint32_t> latencyNs;
+  latencyNs.reserve(STORM_DURATION_MS);
+  uint32_t begins = 0;
+  uint32_t aborts = 0;
+  uint32_t reconnects = 0;
+  for (uint32_t now = 0; now < STORM_DURATION_MS; now++) {
+    driver.clockMs.store(now);
+
+    uint64_t t0 = wallNs();
+    if (now > 0 && now % STORM_RECONNECT_MS == 0) {
+      // connectToWiFi(): alten Versuch abbrechen, sofort neu verbinden
+      portENTER_CRITICAL(&lock);
+      control.stop();
+      portEXIT_CRITICAL(&lock);
+      driver.send(DRIVER_DISCONNECT);
+      portENTER_CRITICAL(&lock);
+      control.start(now, false);
+      portEXIT_CRITICAL(&lock);
+      reconnects++;
+    }
+    portENTER_CRITICAL(&lock);
+    StationCommand command = control.update(now);
+    portEXIT_CRITICAL(&lock);
+    if (command.action == STATION_ACTION_CONNECT) {
+      driver.send(DRIVER_BEGIN);
+      begins++;
+    } else if (command.action == STATION_ACTION_DISCONNECT) {
+      driver.send(DRIVER_DISCONNECT);
+      aborts++;
+    }
+    latencyNs.push_back((uint32_t)(wallNs() - t0));
+
+    uint64_t workUntil = wallNs() + STORM_LOOP_WORK_US * 1000;
+    while (wallNs() < workUntil) {
+    }
+  }
+  driver.done.store(true);
+  events.join();
+
+  std::sort(latencyNs.begin(), latencyNs.end());
+  uint32_t p50 = latencyNs[latencyNs.size() / 2];
+  uint32_t p999 = latencyNs[latencyNs.size() * 999 / 1000];
+  uint32_t maxNs = latencyNs.back();
+
+  char line[160];
+  snprintf(line, sizeof(line), "Sturm %u s: %u Ereignisse (%u Nachzügler ignoriert), %u Verbindungen, "
+           "%u begin(), %u Abbrüche, %u Neuverbindungen", STORM_DURATION_MS / 1000, driver.events,
+           driver.ignored, driver.connects, begins, aborts, reconnects);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "update(): p50 %.2f us, p99.9 %.2f us, max %.1f us",
+           p50 / 1000.0, p999 / 1000.0, maxNs / 1000.0);
+  TEST_MESSAGE(line);
+
+  // Der Sturm fand statt (Nachzügler und Verbindungen hängen vom Scheduler ab)
+  TEST_ASSERT_GREATER_THAN_UINT32(1000, driver.events);
+
+  // loop() wartet nie: update() bleibt im Mikrosekundenbereich
+  TEST_ASSERT_LESS_THAN_UINT32(50000, p999);
+
+  // Außer nach neuen Zugangsdaten liegt zwischen zwei begin() mindestens die
+  // halbe Grundwartezeit - die Ereignisflut wird keine Flut von Versuchen
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(STORM_DURATION_MS / (STATION_BACKOFF_BASE_MS / 2) + reconnects + 1, begins);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reconnect_ignores_own_disconnect);
+  RUN_TEST(test_timeout_abort_ignores_late_disconnect);
+  RUN_TEST(test_real_failure_still_counts_with_abort_pending);
+  RUN_TEST(test_connect_clears_pending_aborts);
+  RUN_TEST(test_fast_attempt_timeout_falls_back);
+  RUN_TEST(test_fast_attempt_failure_and_cache_save);
+  RUN_TEST(test_reconnect_storm_keeps_loop_latency_bounded);
+  return UNITY_END();
+}
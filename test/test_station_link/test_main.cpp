@@ -0,0 +1,233 @@
+/**
+ * Host-Tests: Zustandsautomat der Station-Verbindung
+ * Mit eigener Uhr: Backoff-Verlauf bis zur Obergrenze, Jitter-Grenzen,
+ * 15-s-Timeout im Verbindungsaufbau und die Übergänge zwischen
+ * CONNECTING, CONNECTED und BACKOFF - auch über den millis()-Überlauf.
+ */
+
+#include <unity.h>
+#include "station_link.h"
+
+// Uhr des Tests statt millis()
+struct FakeClock {
+  uint32_t nowMs;
+
+  void advance(uint32_t ms) { nowMs += ms; }
+};
+
+// Einen Versuch starten lassen (Backoff abwarten) und am Timeout scheitern
+static uint32_t failByTimeout(StationLink& link, FakeClock& clock) {
+  TEST_ASSERT_EQUAL(STATION_CONNECTING, link.getState());
+  clock.advance(STATION_CONNECT_TIMEOUT_MS - 1);
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+  clock.advance(1);
+  TEST_ASSERT_EQUAL(STATION_ACTION_DISCONNECT, link.update(clock.nowMs));
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, link.getState());
+  return link.getStats(clock.nowMs).retryInMs;
+}
+
+// Backoff genau abwarten: eine ms vorher nichts, dann der nächste Versuch
+static void waitForRetry(StationLink& link, FakeClock& clock, uint32_t retryInMs) {
+  clock.advance(retryInMs - 1);
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+  TEST_ASSERT_EQUAL_UINT32(1, link.getStats(clock.nowMs).retryInMs);
+  clock.advance(1);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, link.update(clock.nowMs));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_backoff_table() {
+  TEST_ASSERT_EQUAL_UINT32(1000, StationLink::backoffFor(0));
+  TEST_ASSERT_EQUAL_UINT32(1000, StationLink::backoffFor(1));
+  TEST_ASSERT_EQUAL_UINT32(2000, StationLink::backoffFor(2));
+  TEST_ASSERT_EQUAL_UINT32(4000, StationLink::backoffFor(3));
+  TEST_ASSERT_EQUAL_UINT32(32000, StationLink::backoffFor(6));
+  TEST_ASSERT_EQUAL_UINT32(STATION_BACKOFF_MAX_MS, StationLink::backoffFor(7));
+  TEST_ASSERT_EQUAL_UINT32(STATION_BACKOFF_MAX_MS, StationLink::backoffFor(255));
+}
+
+void test_start_connects_immediately() {
+  FakeClock clock = {5000};
+  StationLink link;
+  TEST_ASSERT_EQUAL(STATION_IDLE, link.getState());
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+
+  link.start(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, link.update(clock.nowMs));
+  TEST_ASSERT_EQUAL(STATION_CONNECTING, link.getState());
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+
+  StationLinkStats stats = link.getStats(clock.nowMs);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.attempts);
+  TEST_ASSERT_EQUAL_UINT8(0, stats.failures);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.retryInMs);
+}
+
+void test_backoff_grows_to_cap() {
+  FakeClock clock = {1000};
+  StationLink link;
+  link.seed(12345);
+  link.start(clock.nowMs);
+  link.update(clock.nowMs);
+
+  for (uint8_t failures = 1; failures <= 10; failures++) {
+    uint32_t retryInMs = failByTimeout(link, clock);
+    uint32_t delay = StationLink::backoffFor(failures);
+    TEST_ASSERT_EQUAL_UINT8(failures, link.getStats(clock.nowMs).failures);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(delay / 2, retryInMs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(delay, retryInMs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(STATION_BACKOFF_MAX_MS, retryInMs);
+    waitForRetry(link, clock, retryInMs);
+    TEST_ASSERT_EQUAL_UINT32(failures + 1, link.getStats(clock.nowMs).attempts);
+  }
+}
+
+void test_jitter_bounds_and_spread() {
+  // Viele Geräte mit eigenem Startwert nach demselben Fehlschlag
+  for (uint8_t failures = 1; failures <= 8; failures++) {
+    uint32_t delay = StationLink::backoffFor(failures);
+    uint32_t lowest = UINT32_MAX;
+    uint32_t highest = 0;
+    for (uint32_t device = 1; device <= 200; device++) {
+      FakeClock clock = {0};
+      StationLink link;
+      link.seed(device * 2654435761u);
+      link.start(clock.nowMs);
+      link.update(clock.nowMs);
+      // Vorherige Fehlschläge per Trennung, der letzte zählt
+      for (uint8_t i = 1; i < failures; i++) {
+        link.onDisconnected(clock.nowMs);
+        clock.advance(link.getStats(clock.nowMs).retryInMs);
+        link.update(clock.nowMs);
+      }
+      link.onDisconnected(clock.nowMs);
+      uint32_t retryInMs = link.getStats(clock.nowMs).retryInMs;
+      TEST_ASSERT_GREATER_OR_EQUAL_UINT32(delay / 2, retryInMs);
+      TEST_ASSERT_LESS_OR_EQUAL_UINT32(delay, retryInMs);
+      lowest = retryInMs < lowest ? retryInMs : lowest;
+      highest = retryInMs > highest ? retryInMs : highest;
+    }
+    // Gleichtakt vermieden: die Wartezeiten streuen über die halbe Spanne
+    TEST_ASSERT_GREATER_THAN_UINT32(delay / 4, highest - lowest);
+  }
+}
+
+void test_seed_is_deterministic() {
+  StationLink a, b, zero, unseeded;
+  a.seed(777);
+  b.seed(777);
+  zero.seed(0);  // Ersetzt durch den Standardwert statt xorshift bei 0
+  StationLink* links[] = {&a, &b, &zero, &unseeded};
+  uint32_t retry[4];
+  for (int i = 0; i < 4; i++) {
+    links[i]->start(0);
+    links[i]->update(0);
+    links[i]->onDisconnected(0);
+    retry[i] = links[i]->getStats(0).retryInMs;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(500, retry[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(retry[0], retry[1]);
+  TEST_ASSERT_EQUAL_UINT32(retry[3], retry[2]);
+}
+
+void test_connect_resets_failures() {
+  FakeClock clock = {0};
+  StationLink link;
+  link.start(clock.nowMs);
+  link.update(clock.nowMs);
+  waitForRetry(link, clock, failByTimeout(link, clock));
+  waitForRetry(link, clock, failByTimeout(link, clock));
+  TEST_ASSERT_EQUAL_UINT8(2, link.getStats(clock.nowMs).failures);
+
+  // GOT_IP nach 3,2 s im dritten Versuch
+  clock.advance(3200);
+  link.onConnected(clock.nowMs);
+  StationLinkStats stats = link.getStats(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_CONNECTED, stats.state);
+  TEST_ASSERT_EQUAL_UINT8(0, stats.failures);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.attempts);
+  TEST_ASSERT_EQUAL_UINT32(3200, stats.lastConnectMs);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.connectedMs);
+
+  // Verbunden: kein Timeout, Dauer läuft mit
+  clock.advance(STATION_CONNECT_TIMEOUT_MS * 4);
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+  TEST_ASSERT_EQUAL_UINT32(STATION_CONNECT_TIMEOUT_MS * 4, link.getStats(clock.nowMs).connectedMs);
+
+  // Verbindungsverlust beginnt wieder mit der kürzesten Wartezeit
+  link.onDisconnected(clock.nowMs);
+  stats = link.getStats(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, stats.state);
+  TEST_ASSERT_EQUAL_UINT8(1, stats.failures);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.connectedMs);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(STATION_BACKOFF_BASE_MS, stats.retryInMs);
+  TEST_ASSERT_EQUAL_UINT32(3200, stats.lastConnectMs);
+}
+
+void test_late_disconnect_in_backoff_ignored() {
+  FakeClock clock = {0};
+  StationLink link;
+  link.start(clock.nowMs);
+  link.update(clock.nowMs);
+  uint32_t retryInMs = failByTimeout(link, clock);
+
+  // STA_DISCONNECTED des abgebrochenen Versuchs kommt verspätet
+  clock.advance(100);
+  link.onDisconnected(clock.nowMs);
+  StationLinkStats stats = link.getStats(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_BACKOFF, stats.state);
+  TEST_ASSERT_EQUAL_UINT8(1, stats.failures);
+  TEST_ASSERT_EQUAL_UINT32(retryInMs - 100, stats.retryInMs);
+}
+
+void test_stop_is_final() {
+  FakeClock clock = {0};
+  StationLink link;
+  link.start(clock.nowMs);
+  link.update(clock.nowMs);
+  link.stop();
+
+  clock.advance(STATION_CONNECT_TIMEOUT_MS * 2);
+  TEST_ASSERT_EQUAL(STATION_ACTION_NONE, link.update(clock.nowMs));
+  link.onConnected(clock.nowMs);
+  link.onDisconnected(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_IDLE, link.getState());
+  TEST_ASSERT_EQUAL_STRING("idle", StationLink::stateName(link.getState()));
+}
+
+void test_millis_wraparound() {
+  // Timeout und Backoff laufen über den Überlauf von millis()
+  FakeClock clock = {0xFFFFFFFFu - 5000};
+  StationLink link;
+  link.start(clock.nowMs);
+  TEST_ASSERT_EQUAL(STATION_ACTION_CONNECT, link.update(clock.nowMs));
+  uint32_t retryInMs = failByTimeout(link, clock);
+  TEST_ASSERT_LESS_THAN_UINT32(0x10000000, clock.nowMs);  // Übergelaufen
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(STATION_BACKOFF_BASE_MS, retryInMs);
+
+  // Backoff-Ende genau auf dem Überlauf
+  clock.nowMs = 0xFFFFFFFFu - 300;
+  link.start(clock.nowMs);
+  link.update(clock.nowMs);
+  link.onDisconnected(clock.nowMs);
+  retryInMs = link.getStats(clock.nowMs).retryInMs;
+  TEST_ASSERT_GREATER_THAN_UINT32(300, retryInMs);
+  waitForRetry(link, clock, retryInMs);
+  TEST_ASSERT_EQUAL_UINT32(2, link.getStats(clock.nowMs).attempts);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_backoff_table);
+  RUN_TEST(test_start_connects_immediately);
+  RUN_TEST(test_backoff_grows_to_cap);
+  RUN_TEST(test_jitter_bounds_and_spread);
+  RUN_TEST(test_seed_is_deterministic);
+  RUN_TEST(test_connect_resets_failures);
+  RUN_TEST(test_late_disconnect_in_backoff_ignored);
+  RUN_TEST(test_stop_is_final);
+  RUN_TEST(test_millis_wraparound);
+  return UNITY_END();
+}
@@ -0,0 +1,152 @@
+/**
+ * Host-Tests: VelocityFilter gegen den alten Schätzer
+ * Deterministische Traces (Zeitstempel in us, loop() im 1-ms-Takt).
+ * Der alte Schätzer ist calculateSpeed() vor dem Alpha-Beta-Filter:
+ * Strecke über Fenster >100 ms, geglättet mit 0.7/0.3.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "velocity_filter.h"
+
+// Nachbau von MouseHandler::calculateSpeed() (alte Version)
+struct LegacySpeedEstimator {
+  int32_t lastX = 0, lastY = 0;
+  uint32_t lastUpdateMs = 0;
+  float speed = 0;
+
+  void update(uint32_t nowMs, int32_t x, int32_t y) {
+    if (nowMs - lastUpdateMs > 100) {
+      int32_t dx = x - lastX;
+      int32_t dy = y - lastY;
+      float distance = sqrtf((float)(dx * dx + dy * dy));
+      speed = speed * 0.7f + distance / ((nowMs - lastUpdateMs) / 1000.0f) * 0.3f;
+      lastX = x;
+      lastY = y;
+      lastUpdateMs = nowMs;
+    }
+  }
+};
+
+// Trace: Reports mit festem Abstand und Schritt, loop() jede Millisekunde
+struct TraceRun {
+  VelocityFilter filter;
+  LegacySpeedEstimator legacy;
+  int32_t x = 0;
+  uint32_t nextReportUs = 0;
+
+  void run(uint32_t fromUs, uint32_t toUs, uint32_t intervalUs, int32_t step) {
+    for (uint32_t now = fromUs; now != toUs; now += 1000) {
+      if (step != 0 && now == nextReportUs) {
+        x += step;
+        filter.addSample(x, 0, now);
+        nextReportUs += intervalUs;
+      }
+      filter.tick(now);
+      legacy.update(now / 1000, x, 0);
+    }
+  }
+};
+
+static void report(const char* label, float filterSpeed, float legacySpeed) {
+  char line[120];
+  snprintf(line, sizeof(line), "%s: Filter %.1f px/s, alt %.1f px/s", label, filterSpeed, legacySpeed);
+  TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_constant_motion_settles_before_legacy() {
+  // 500 px/s bei 125 Hz: 4 px alle 8 ms
+  TraceRun trace;
+  trace.run(0, 48000, 8000, 4);
+  report("48 ms", trace.filter.getSpeed(), trace.legacy.speed);
+  TEST_ASSERT_FLOAT_WITHIN(50.0f, 500.0f, trace.filter.getSpeed());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, trace.legacy.speed);  // Erstes Fenster noch offen
+
+  trace.run(48000, 1000000, 8000, 4);
+  report("1 s", trace.filter.getSpeed(), trace.legacy.speed);
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, 500.0f, trace.filter.getSpeed());
+  TEST_ASSERT_FLOAT_WITHIN(25.0f, 500.0f, trace.legacy.speed);
+}
+
+void test_stop_decays_before_legacy() {
+  TraceRun trace;
+  trace.run(0, 500000, 8000, 4);
+  trace.run(500000, 600000, 8000, 0);
+  report("100 ms nach Stopp", trace.filter.getSpeed(), trace.legacy.speed);
+  TEST_ASSERT_LESS_THAN_FLOAT(trace.legacy.speed / 4, trace.filter.getSpeed());
+  TEST_ASSERT_GREATER_THAN_FLOAT(300.0f, trace.legacy.speed);
+
+  trace.run(600000, 800000, 8000, 0);
+  report("300 ms nach Stopp", trace.filter.getSpeed(), trace.legacy.speed);
+  TEST_ASSERT_LESS_THAN_FLOAT(1.0f, trace.filter.getSpeed());
+  TEST_ASSERT_GREATER_THAN_FLOAT(100.0f, trace.legacy.speed);
+}
+
+void test_late_reports_after_idle_tick() {
+  // 100 px/s mit Reports alle 20 ms; jeder Report wird erst nach dem
+  // tick() verarbeitet, der bereits Stillstand eingespeist hat
+  VelocityFilter filter;
+  LegacySpeedEstimator legacy;
+  int32_t x = 0;
+  for (uint32_t k = 0; k < 100; k++) {
+    uint32_t stampUs = 1000 + k * 20000;
+    filter.tick(stampUs + 200);
+    x += 2;
+    filter.addSample(x, 0, stampUs);
+    legacy.update((stampUs + 200) / 1000, x, 0);
+  }
+  report("Nachzügler", filter.getSpeed(), legacy.speed);
+
+  // Mit übergelaufenem, auf MAX_DT begrenztem dt blieben ~16 px/s
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, 100.0f, filter.getSpeed());
+  TEST_ASSERT_FLOAT_WITHIN(10.0f, legacy.speed, filter.getSpeed());
+}
+
+void test_late_report_matches_in_order_processing() {
+  VelocityFilter inOrder;
+  VelocityFilter late;
+  for (uint32_t k = 0; k < 10; k++) {
+    inOrder.addSample(k * 3, k, k * 8000);
+    late.addSample(k * 3, k, k * 8000);
+  }
+
+  // Report bei 92 ms: einmal vor, einmal nach dem Stillstand-Tick bei 93 ms
+  inOrder.addSample(30, 10, 92000);
+  inOrder.tick(93000);
+  late.tick(93000);
+  late.addSample(30, 10, 92000);
+
+  TEST_ASSERT_EQUAL_FLOAT(inOrder.getVelocityX(), late.getVelocityX());
+  TEST_ASSERT_EQUAL_FLOAT(inOrder.getVelocityY(), late.getVelocityY());
+
+  // Der nächste Report geht normal weiter
+  inOrder.addSample(33, 11, 100000);
+  late.addSample(33, 11, 100000);
+  TEST_ASSERT_EQUAL_FLOAT(inOrder.getSpeed(), late.getSpeed());
+}
+
+void test_micros_overflow() {
+  // Gleicher Trace, einmal über den 32-Bit-Überlauf von micros()
+  TraceRun plain;
+  plain.run(0, 300000, 8000, 4);
+
+  TraceRun wrapped;
+  uint32_t start = 0u - 100000;
+  wrapped.nextReportUs = start;
+  wrapped.run(start, start + 300000, 8000, 4);
+
+  TEST_ASSERT_EQUAL_FLOAT(plain.filter.getSpeed(), wrapped.filter.getSpeed());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_constant_motion_settles_before_legacy);
+  RUN_TEST(test_stop_decays_before_legacy);
+  RUN_TEST(test_late_reports_after_idle_tick);
+  RUN_TEST(test_late_report_matches_in_order_processing);
+  RUN_TEST(test_micros_overflow);
+  return UNITY_END();
+}
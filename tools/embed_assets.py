@@ -0,0 +1,100 @@
+"""
+Web-Assets einbetten: komprimiert die Dateien aus data/ per gzip und
+erzeugt src/web_assets_data.h mit Byte-Arrays im Flash und Inhalts-Hashes
+(starke ETags).
+
+Läuft als PlatformIO extra_script vor jedem Build und lässt sich auch
+direkt aufrufen:  python tools/embed_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+
+CONTENT_TYPES = {
+    ".html": "text/html; charset=utf-8",
+    ".js": "application/javascript",
+    ".css": "text/css",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".json": "application/json",
+}
+
+HEADER_TEMPLATE = """\
+/**
+ * Automatisch erzeugt von tools/embed_assets.py - nicht bearbeiten
+ */
+
+#ifndef WEB_ASSETS_DATA_H
+#define WEB_ASSETS_DATA_H
+
+{arrays}
+static const WebAsset WEB_ASSET_TABLE[] = {{
+{entries}
+}};
+
+#define WEB_ASSET_COUNT {count}
+
+#endif
+"""
+
+
+def project_dir():
+    try:
+        Import("env")  # noqa: F821 - von PlatformIO bereitgestellt
+        return env.subst("$PROJECT_DIR")  # noqa: F821
+    except NameError:
+        return os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def collect_assets(data_dir):
+    assets = []
+    for root, _, files in os.walk(data_dir):
+        for name in sorted(files):
+            ext = os.path.splitext(name)[1].lower()
+            if ext not in CONTENT_TYPES:
+                continue
+            path = os.path.join(root, name)
+            url = "/" + os.path.relpath(path, data_dir).replace(os.sep, "/")
+            assets.append((url, path, CONTENT_TYPES[ext]))
+    return sorted(assets)
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "static const uint8_t %s[%d] = {\n%s\n};\n" % (name, len(data), "\n".join(lines))
+
+
+def generate(base):
+    data_dir = os.path.join(base, "data")
+    output = os.path.join(base, "src", "web_assets_data.h")
+
+    arrays = []
+    entries = []
+    for index, (url, path, content_type) in enumerate(collect_assets(data_dir)):
+        with open(path, "rb") as f:
+            raw = f.read()
+        # mtime=0: gleiche Eingabe ergibt gleiche Bytes (reproduzierbarer Build)
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = '\\"%s\\"' % hashlib.sha256(raw).hexdigest()[:16]
+        name = "WEB_ASSET_%d" % index
+
+        arrays.append(c_array(name, packed))
+        entries.append('  {"%s", "%s", %s, sizeof(%s), "%s"},' % (url, content_type, name, name, etag))
+        print("[ASSETS] %s: %d -> %d Bytes (gzip)" % (url, len(raw), len(packed)))
+
+    content = HEADER_TEMPLATE.format(arrays="\n".join(arrays), entries="\n".join(entries),
+                                     count=len(entries))
+
+    # Nur bei Änderungen schreiben, sonst baut PlatformIO unnötig neu
+    if os.path.exists(output):
+        with open(output, "r") as f:
+            if f.read() == content:
+                return
+    with open(output, "w") as f:
+        f.write(content)
+
+
+generate(project_dir())
@@ -0,0 +1,91 @@
+"""
+Firmware für das komprimierte OTA-Update packen (Format siehe src/lzss.h).
+
+Datei: "LZS1", Originalgröße (u32 LE), SHA-256 des Originals (32 Bytes),
+danach der LZSS-Strom. Das Gerät entpackt beim Empfang und prüft den
+Hash vor Update.end().
+
+    python tools/ota_compress.py .pio/build/lilygo-maus/firmware.bin
+    -> firmware.bin.lzs (im Webinterface statt der .bin hochladen)
+"""
+
+import hashlib
+import struct
+import sys
+
+WINDOW_SIZE = 4096
+MIN_MATCH = 3
+MAX_MATCH = 18
+MAX_CHAIN = 64  # Kandidaten je Position (Geschwindigkeit vs. Kompression)
+
+
+def compress(data):
+    out = bytearray()
+    chains = {}  # 3-Byte-Präfix -> letzte Positionen
+    pos = 0
+    n = len(data)
+
+    while pos < n:
+        flag_index = len(out)
+        out.append(0)
+        flags = 0
+        for bit in range(8):
+            if pos >= n:
+                break
+            best_len = 0
+            best_dist = 0
+            if pos + MIN_MATCH <= n:
+                key = data[pos:pos + MIN_MATCH]
+                for cand in reversed(chains.get(key, [])[-MAX_CHAIN:]):
+                    dist = pos - cand
+                    if dist > WINDOW_SIZE:
+                        break
+                    length = MIN_MATCH
+                    limit = min(MAX_MATCH, n - pos)
+                    while length < limit and data[cand + length] == data[pos + length]:
+                        length += 1
+                    if length > best_len:
+                        best_len, best_dist = length, dist
+                        if length == MAX_MATCH:
+                            break
+
+            step = best_len if best_len >= MIN_MATCH else 1
+            if best_len >= MIN_MATCH:
+                d = best_dist - 1
+                out.append(d & 0xFF)
+                out.append(((d >> 8) << 4) | (best_len - MIN_MATCH))
+            else:
+                flags |= 1 << bit
+                out.append(data[pos])
+
+            for p in range(pos, pos + step):
+                if p + MIN_MATCH <= n:
+                    chains.setdefault(data[p:p + MIN_MATCH], []).append(p)
+            pos += step
+        out[flag_index] = flags
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Aufruf: ota_compress.py firmware.bin [ausgabe.lzs]")
+        sys.exit(1)
+
+    source = sys.argv[1]
+    target = sys.argv[2] if len(sys.argv) > 2 else source + ".lzs"
+
+    with open(source, "rb") as f:
+        image = f.read()
+
+    packed = compress(image)
+    header = b"LZS1" + struct.pack("<I", len(image)) + hashlib.sha256(image).digest()
+
+    with open(target, "wb") as f:
+        f.write(header + packed)
+
+    print("[OTA] %s: %d -> %d Bytes (%.1f%%)" % (target, len(image), len(header) + len(packed),
+                                                   100.0 * (len(header) + len(packed)) / len(image)))
+
+
+if __name__ == "__main__":
+    main()